@@ -0,0 +1,571 @@
+/* Native benchmarks for the core kernels, without any Cython overhead.
+
+   Usage:
+
+       build/benchmarks [--size=256,16384] [--number=100] [--results=results]
+                        [suite ...]
+
+   With no suites, all of them are run.  Each suite writes its timings, in
+   the same JSON layout as src/py/benchmark, to
+
+       <results>/<suite>/<date>/<time>-<optimization flags>.json
+
+   Each result is the total time in seconds for `number` runs, and is named
+   <benchmark>/<size>.  Benchmarks of operations that change their list in
+   place, like `extend` or `pop`, include copying a fresh list first.
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <sys/utsname.h>
+#endif
+
+#include <timedata/base/timestamp.h>
+#include <timedata/color/cython_list_inl.h>
+#include <timedata/color/renderer_inl.h>
+#include <timedata/color/toString.h>
+#include <timedata/signal/convertList.h>
+
+namespace timedata {
+namespace benchmark {
+
+/** A Benchmark makes its data for a given size, and returns the function to
+    be timed. */
+using Timed = std::function<void()>;
+using Benchmark = std::function<Timed(size_t size)>;
+using Benchmarks = std::map<std::string, Benchmark>;
+using Suites = std::map<std::string, Benchmarks>;
+
+using namespace color_list;
+using List = CColorListRGB;
+
+/** Make the compiler believe `value` is read, so that it can't throw away
+    the computation that produced it - without costing anything itself. */
+template <typename T>
+void doNotOptimize(T const& value) {
+#ifdef __GNUC__
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static char const volatile* sink;
+    sink = reinterpret_cast<char const volatile*>(&value);
+#endif
+}
+
+/** Some varied colors, mostly in band. */
+template <typename ColorList>
+std::shared_ptr<ColorList> makeList(size_t size) {
+    auto rgb = std::make_shared<List>();
+    for (size_t i = 0; i < size; ++i) {
+        rgb->push_back({(i % 17) / 16.0f,
+                        (i % 23) / 22.0f,
+                        ((i * 7) % 13) / 12.0f});
+    }
+    auto result = std::make_shared<ColorList>();
+    converter::convertList(*rgb, *result);
+    return result;
+}
+
+template <typename Function>
+Benchmark unary(Function f) {
+    return [f](size_t size) -> Timed {
+        auto in = makeList<List>(size), out = makeList<List>(size);
+        return [=]() {
+            f(*in, *out);
+            doNotOptimize(*out);
+        };
+    };
+}
+
+/** An operation that changes its list in place, run on a fresh copy. */
+template <typename Function>
+Benchmark inPlace(Function f) {
+    return [f](size_t size) -> Timed {
+        auto in = makeList<List>(size), out = makeList<List>(size);
+        return [=]() {
+            *out = *in;
+            f(*in, *out);
+            doNotOptimize(*out);
+        };
+    };
+}
+
+/** A random index list of `size` entries into a list of `size` samples. */
+inline std::shared_ptr<CIndexList> makeIndexes(size_t size) {
+    auto indexes = std::make_shared<CIndexList>();
+    for (size_t i = 0; i < size; ++i)
+        indexes->push_back(int((i * 7919) % size));
+    return indexes;
+}
+
+#define TIMEDATA_UNARY(NAME) \
+    b[#NAME] = unary([](List const& i, List& o) { math_##NAME(i, o); })
+
+/** A binary math_ operation against a list, a sample and a number. */
+#define TIMEDATA_BINARY(NAME)                                                \
+    b[#NAME "_list"] = [](size_t size) -> Timed {                            \
+        auto in = makeList<List>(size), out = makeList<List>(size);          \
+        auto in2 = makeList<List>(size);                                     \
+        return [=]() {                                                       \
+            math_##NAME(*in, *in2, *out);                                    \
+            doNotOptimize(*out);                                             \
+        };                                                                   \
+    };                                                                       \
+    b[#NAME "_sample"] = [](size_t size) -> Timed {                          \
+        auto in = makeList<List>(size), out = makeList<List>(size);          \
+        ColorRGB sample(0.25f, 0.5f, 0.75f);                                 \
+        return [=]() {                                                       \
+            math_##NAME(*in, sample, *out);                                  \
+            doNotOptimize(*out);                                             \
+        };                                                                   \
+    };                                                                       \
+    b[#NAME "_number"] = [](size_t size) -> Timed {                          \
+        auto in = makeList<List>(size), out = makeList<List>(size);          \
+        return [=]() {                                                       \
+            math_##NAME(*in, 0.5f, *out);                                    \
+            doNotOptimize(*out);                                             \
+        };                                                                   \
+    }
+
+inline Benchmarks lists() {
+    Benchmarks b;
+
+    TIMEDATA_UNARY(abs);
+    TIMEDATA_UNARY(ceil);
+    TIMEDATA_UNARY(floor);
+    TIMEDATA_UNARY(invert);
+    TIMEDATA_UNARY(neg);
+    TIMEDATA_UNARY(reverse);
+    TIMEDATA_UNARY(trunc);
+
+    TIMEDATA_BINARY(add);
+    TIMEDATA_BINARY(div);
+    TIMEDATA_BINARY(max_limit);
+    TIMEDATA_BINARY(min_limit);
+    TIMEDATA_BINARY(mul);
+    TIMEDATA_BINARY(pow);
+    TIMEDATA_BINARY(rdiv);
+    TIMEDATA_BINARY(rpow);
+    TIMEDATA_BINARY(rsub);
+    TIMEDATA_BINARY(sub);
+
+    ColorRGB const sample(0.25f, 0.5f, 0.75f);
+    auto keep = [](float x) { doNotOptimize(x); };
+
+    b["clear"] = inPlace([](List const&, List& o) { math_clear(o); });
+    b["zero"] = unary([](List const&, List& o) { math_zero(o); });
+    b["compare"] = unary([=](List const& i, List& o) { keep(compare(i, o)); });
+    b["compare_sample"] = unary([=](List const& i, List&) {
+        keep(compare(sample, i));
+    });
+    b["compare_number"] = unary([=](List const& i, List&) {
+        keep(compare(0.5f, i));
+    });
+    b["distance"] = unary([=](List const& i, List& o) {
+        keep(distance(i, o));
+    });
+    b["distance2"] = unary([=](List const& i, List& o) {
+        keep(distance2(i, o));
+    });
+    b["distance2_sample"] = unary([=](List const& i, List&) {
+        keep(distance2(sample, i));
+    });
+    b["distance2_number"] = unary([=](List const& i, List&) {
+        keep(distance2(0.5f, i));
+    });
+    b["delta_e"] = unary([=](List const& i, List& o) {
+        keep(delta_e(i, o));
+    });
+    b["max"] = unary([](List const& i, List&) { doNotOptimize(max_cpp(i)); });
+    b["min"] = unary([](List const& i, List&) { doNotOptimize(min_cpp(i)); });
+    b["statistics"] = unary([](List const& i, List&) {
+        doNotOptimize(statistics_cpp(i));
+    });
+    b["histogram"] = unary([](List const& i, List&) {
+        doNotOptimize(histogram_cpp(i, 256, 0.0f, 1.0f));
+    });
+    b["index"] = unary([](List const& i, List&) {
+        doNotOptimize(index(i, i.back()));
+    });
+    b["count"] = unary([](List const& i, List&) {
+        doNotOptimize(count(i, i.back()));
+    });
+    b["rotate"] = unary([](List const& i, List& o) {
+        rotate(i, o, int(i.size() / 8));
+    });
+    b["rotate_in_place"] = inPlace([](List const& i, List& o) {
+        color_list::rotate(o, int(i.size() / 8));
+    });
+    b["round"] = unary([](List const& i, List& o) {
+        round_cpp(const_cast<List&>(i), o, 2);
+    });
+    b["round_in_place"] = inPlace([](List const&, List& o) {
+        round_cpp(o, 2);
+    });
+    b["sort"] = unary([](List const& i, List& o) { sort(i, o, false); });
+    b["sort_in_place"] = inPlace([](List const&, List& o) { sort(o); });
+    b["slice"] = unary([](List const& i, List& o) {
+        sliceOut(i, 0, int(i.size()), 2, o);
+    });
+    b["slice_into"] = inPlace([](List const& i, List& o) {
+        sliceInto(sliceOut(i, 0, int(i.size()), 2), o, 0, int(i.size()), 2);
+    });
+    b["slice_delete"] = inPlace([](List const& i, List& o) {
+        sliceDelete(o, 0, int(i.size()), 2);
+    });
+    b["erase"] = inPlace([](List const&, List& o) {
+        if (not o.empty())
+            erase(0, o);
+    });
+    b["pop"] = inPlace([](List const&, List& o) {
+        ColorRGB c;
+        doNotOptimize(pop(o, 0, c));
+    });
+    b["insert"] = inPlace([=](List const&, List& o) {
+        insert(0, sample, o);
+    });
+    b["extend"] = inPlace([](List const& i, List& o) { extend(i, o); });
+    b["magic_add"] = inPlace([](List const& i, List& o) { magic_add(i, o); });
+    b["magic_mul"] = inPlace([](List const&, List& o) { magic_mul(3, o); });
+    b["shuffle"] = inPlace([](List const&, List& o) { shuffle(o); });
+    b["spread_append"] = inPlace([=](List const& i, List& o) {
+        spreadAppend(sample, i.size(), o);
+    });
+    b["remap_to"] = [](size_t size) -> Timed {
+        auto in = makeList<List>(size), out = makeList<List>(size);
+        auto indexes = makeIndexes(size);
+        return [=]() {
+            doNotOptimize(remap_to(*indexes, *in, *out));
+            doNotOptimize(*out);
+        };
+    };
+    b["index_list_compare"] = [](size_t size) -> Timed {
+        auto x = makeIndexes(size), y = makeIndexes(size);
+        return [=]() { doNotOptimize(compare(*x, *y)); };
+    };
+    b["index_list_distance2"] = [](size_t size) -> Timed {
+        auto x = makeIndexes(size), y = makeIndexes(size);
+        return [=]() { doNotOptimize(distance2(*x, *y)); };
+    };
+    b["to_string"] = unary([](List const& i, List&) {
+        doNotOptimize(toString(i));
+    });
+    return b;
+}
+
+#undef TIMEDATA_UNARY
+#undef TIMEDATA_BINARY
+
+template <typename In, typename Out>
+void addConversion(Benchmarks& b, std::string const& from) {
+    b[from + "_to_" + className<Out>().substr(5)] = [](size_t size) -> Timed {
+        auto in = makeList<typename In::List>(size);
+        auto out = std::make_shared<typename Out::List>();
+        return [=]() {
+            converter::convertList(*in, *out);
+            doNotOptimize(*out);
+        };
+    };
+}
+
+template <typename In>
+void addConversions(Benchmarks& b) {
+    auto from = className<In>().substr(5);
+    addConversion<In, ColorRGB>(b, from);
+    addConversion<In, ColorRGB255>(b, from);
+    addConversion<In, ColorRGB256>(b, from);
+    addConversion<In, ColorHSL>(b, from);
+    addConversion<In, ColorHSV>(b, from);
+    addConversion<In, ColorXYZ>(b, from);
+    addConversion<In, ColorYIQ>(b, from);
+    addConversion<In, ColorYUV>(b, from);
+    addConversion<In, ColorLab>(b, from);
+    addConversion<In, ColorLCh>(b, from);
+    addConversion<In, ColorOklab>(b, from);
+}
+
+inline Benchmarks conversions() {
+    Benchmarks b;
+    addConversions<ColorRGB>(b);
+    addConversions<ColorRGB255>(b);
+    addConversions<ColorRGB256>(b);
+    addConversions<ColorHSL>(b);
+    addConversions<ColorHSV>(b);
+    addConversions<ColorXYZ>(b);
+    addConversions<ColorYIQ>(b);
+    addConversions<ColorYUV>(b);
+    addConversions<ColorLab>(b);
+    addConversions<ColorLCh>(b);
+    addConversions<ColorOklab>(b);
+    return b;
+}
+
+template <typename ColorList>
+Benchmark render(Render3 r, bool indexer = false) {
+    return [=](size_t size) -> Timed {
+        auto in = makeList<ColorList>(size);
+        auto renderer = std::make_shared<CRenderer>(r);
+        auto out = std::make_shared<std::vector<char>>(
+            size * renderer->stride());
+        if (indexer) {
+            return [=]() {
+                renderer->render(1.0f, getIndexer(*in), 0, size, out->data());
+                doNotOptimize(*out);
+            };
+        }
+        return [=]() {
+            renderer->render(1.0f, *in, 0, size, out->data());
+            doNotOptimize(*out);
+        };
+    };
+}
+
+inline Benchmarks rendering() {
+    Render3 r;
+    r.gamma = 2.5f;
+
+    Benchmarks b;
+    b["indexer_rgb"] = render<CColorListRGB>(r, true);
+    b["indexer_hsv"] = render<CColorListHSV>(r, true);
+    b["rgb"] = render<CColorListRGB>(r);
+    b["hsv"] = render<CColorListHSV>(r);
+
+    r.permutation = Render3::Permutation::grb;
+    r.prefix = 1;
+    b["grb_prefix"] = render<CColorListRGB>(r);
+
+    r.output = Render3::Output::u16be;
+    b["grb_prefix_u16"] = render<CColorListRGB>(r);
+    return b;
+}
+
+inline Benchmarks names() {
+    Benchmarks b;
+    b["to_color"] = [](size_t size) -> Timed {
+        auto in = makeList<List>(size);
+        auto names = std::make_shared<std::vector<std::string>>();
+        for (auto& c: *in)
+            names->push_back(colorToString(c));
+        return [=]() {
+            ColorRGB c;
+            for (auto& n: *names) {
+                toColor(n.c_str(), c);
+                doNotOptimize(c);
+            }
+        };
+    };
+    b["color_to_string"] = [](size_t size) -> Timed {
+        auto in = makeList<List>(size);
+        return [=]() {
+            for (auto& c: *in)
+                doNotOptimize(colorToString(c));
+        };
+    };
+    b["color_to_string_hsv"] = [](size_t size) -> Timed {
+        auto in = makeList<CColorListHSV>(size);
+        return [=]() {
+            for (auto& c: *in)
+                doNotOptimize(colorToString(c));
+        };
+    };
+    return b;
+}
+
+inline Suites suites() {
+    return {{"native_conversions", conversions()},
+            {"native_lists", lists()},
+            {"native_names", names()},
+            {"native_rendering", rendering()}};
+}
+
+/** Total seconds for `number` runs. */
+inline double timeit(Timed const& timed, size_t number) {
+    timed();  // Warm up.
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < number; ++i)
+        timed();
+    std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+    return d.count();
+}
+
+inline std::string quote(std::string const& s) {
+    return "\"" + s + "\"";
+}
+
+/** "-O3 -ffast-math" becomes "o3-fast-math", as in the Python results. */
+inline std::string flagsSuffix(std::string const& flags) {
+    std::string result;
+    std::istringstream ss(flags);
+    for (std::string flag; ss >> flag; ) {
+        auto i = flag.find_first_not_of("-");
+        if (i == std::string::npos)
+            continue;
+        if (flag[i] == 'f' and flag.size() > i + 1 and flag[i + 1] != 'n')
+            ++i;
+        if (not result.empty())
+            result += "-";
+        for (auto c: flag.substr(i))
+            result += static_cast<char>(std::tolower(c));
+    }
+    return result;
+}
+
+inline void makeDirectories(std::string const& path) {
+#ifndef _WIN32
+    for (size_t i = 1; i <= path.size(); ++i) {
+        if (i == path.size() or path[i] == '/')
+            mkdir(path.substr(0, i).c_str(), 0755);
+    }
+#endif
+}
+
+inline std::string platformJson() {
+#ifdef _WIN32
+    return "{\"system\": \"Windows\", \"version\": \"\"}";
+#else
+    utsname u;
+    uname(&u);
+    return "{\"system\": " + quote(u.sysname) +
+            ", \"version\": " + quote(u.release) + "}";
+#endif
+}
+
+struct Options {
+    std::vector<size_t> sizes = {256, 16384};
+    size_t number = 100;
+    std::string results = "results";
+    std::vector<std::string> suites;
+};
+
+inline bool parse(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.find("--") != 0) {
+            options.suites.push_back(arg);
+            continue;
+        }
+
+        auto eq = arg.find('=');
+        if (eq == std::string::npos)
+            return false;
+        auto name = arg.substr(0, eq), value = arg.substr(eq + 1);
+        if (name == "--size") {
+            options.sizes.clear();
+            std::istringstream ss(value);
+            for (std::string s; std::getline(ss, s, ','); )
+                options.sizes.push_back(std::stoul(s));
+        } else if (name == "--number") {
+            options.number = std::stoul(value);
+        } else if (name == "--results") {
+            options.results = value;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline void writeResults(Options const& options, std::string const& suite,
+                         std::map<std::string, double> const& results) {
+    auto now = std::time(nullptr);
+    char date[16], time[16], timestamp[32];
+    std::strftime(date, sizeof(date), "%Y%m%d", std::localtime(&now));
+    std::strftime(time, sizeof(time), "%H%M%S", std::localtime(&now));
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%S",
+                  std::localtime(&now));
+
+    auto flags = optimizationFlags();
+    auto directory = options.results + "/" + suite + "/" + date;
+    makeDirectories(directory);
+    auto filename = directory + "/" + time;
+    auto suffix = flagsSuffix(flags);
+    if (not suffix.empty())
+        filename += "-" + suffix;
+    filename += ".json";
+
+    std::string sizes;
+    for (auto s: options.sizes)
+        sizes += (sizes.empty() ? "" : ", ") + std::to_string(s);
+
+    // Keys are sorted, like the Python harness.
+    std::ostringstream out;
+    out.precision(17);
+    out << "{\n"
+        << "    \"git_tags\": " << quote(gitTags()) << ",\n"
+        << "    \"name\": " << quote(suite) << ",\n"
+        << "    \"number\": " << options.number << ",\n"
+        << "    \"optimization_flags\": " << quote(flags) << ",\n"
+        << "    \"platform\": " << platformJson() << ",\n"
+        << "    \"results\": {";
+    auto first = true;
+    for (auto& r: results) {
+        out << (first ? "\n" : ",\n")
+            << "        " << quote(r.first) << ": " << r.second;
+        first = false;
+    }
+    out << "\n    },\n"
+        << "    \"size\": [" << sizes << "],\n"
+        << "    \"timestamp\": " << quote(timestamp) << "\n"
+        << "}\n";
+
+    if (auto file = std::fopen(filename.c_str(), "w")) {
+        std::fputs(out.str().c_str(), file);
+        std::fclose(file);
+        std::cout << "Wrote " << filename << "\n";
+    } else {
+        std::cerr << "Couldn't write " << filename << "\n";
+    }
+}
+
+inline int run(int argc, char* argv[]) {
+    Options options;
+    if (not parse(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--size=N,...] [--number=N] "
+                  << "[--results=DIRECTORY] [suite...]\n";
+        return 1;
+    }
+
+    auto all = suites();
+    if (options.suites.empty()) {
+        for (auto& s: all)
+            options.suites.push_back(s.first);
+    }
+
+    for (auto& name: options.suites) {
+        auto suite = all.find(name);
+        if (suite == all.end()) {
+            std::cerr << "Unknown suite " << name << "\n";
+            return 1;
+        }
+
+        std::map<std::string, double> results;
+        for (auto& b: suite->second) {
+            for (auto size: options.sizes) {
+                auto key = b.first + "/" + std::to_string(size);
+                auto t = timeit(b.second(size), options.number);
+                results[key] = t;
+                std::cout << name << "." << key << ": " << t << "\n";
+            }
+        }
+        writeResults(options, name, results);
+    }
+    return 0;
+}
+
+} // benchmark
+} // timedata
+
+int main(int argc, char* argv[]) {
+    return timedata::benchmark::run(argc, argv);
+}
@@ -3,8 +3,28 @@
 #define CATCH_CONFIG_MAIN
 
 #include <catch/catch.hpp>
+#include <timedata/base/arena_test.cpp>
+#include <timedata/base/gammaLut_test.cpp>
 #include <timedata/base/gammaTable_test.cpp>
+#include <timedata/base/half_test.cpp>
 #include <timedata/base/join_test.cpp>
 #include <timedata/base/math_test.cpp>
+#include <timedata/base/saturate_test.cpp>
+#include <timedata/base/simd_test.cpp>
+#include <timedata/base/threadPool_test.cpp>
+#include <timedata/base/tripleBuffer_test.cpp>
+#include <timedata/color/expression_test.cpp>
+#include <timedata/color/hueSimd_test.cpp>
+#include <timedata/color/linearSimd_test.cpp>
 #include <timedata/color/names_test.cpp>
+#include <timedata/color/perceptualSimd_test.cpp>
+#include <timedata/color/renderLoop_test.cpp>
+#include <timedata/color/renderSegments_test.cpp>
+#include <timedata/color/renderer_test.cpp>
+#include <timedata/color/statistics_test.cpp>
+#include <timedata/signal/composite_test.cpp>
+#include <timedata/signal/convertList_test.cpp>
+#include <timedata/signal/fade_test.cpp>
+#include <timedata/signal/frameFile_test.cpp>
+#include <timedata/signal/planar_test.cpp>
 #include <timedata/signal/signal_test.cpp>
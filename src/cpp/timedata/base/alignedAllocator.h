@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace timedata {
+
+/** The alignment of all our bulk numeric storage - one cache line, which is
+    also the width of the widest vector registers we use. */
+static const size_t CACHE_LINE = 64;
+
+/** A minimal C++11 allocator returning memory aligned to ALIGNMENT bytes.
+
+    C++11 has no aligned `operator new`, so we over-allocate and keep the
+    original pointer just before the aligned block. */
+template <typename T, size_t ALIGNMENT = CACHE_LINE>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, ALIGNMENT>;
+    };
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(AlignedAllocator<U, ALIGNMENT> const&) {}
+
+    T* allocate(size_t n);
+    void deallocate(T*, size_t);
+
+    bool operator==(AlignedAllocator const&) const { return true; }
+    bool operator!=(AlignedAllocator const&) const { return false; }
+};
+
+template <typename T, size_t ALIGNMENT = CACHE_LINE>
+using AlignedVector = std::vector<T, AlignedAllocator<T, ALIGNMENT>>;
+
+/** Allocate `bytes` bytes aligned to `alignment`, which must be a power of
+    two.  Must be released with alignedFree. */
+void* alignedMalloc(size_t bytes, size_t alignment = CACHE_LINE);
+void alignedFree(void*);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+inline void* alignedMalloc(size_t bytes, size_t alignment) {
+    auto raw = ::operator new(bytes + alignment + sizeof(void*));
+    auto base = reinterpret_cast<uintptr_t>(raw) + sizeof(void*);
+    auto aligned = (base + alignment - 1) & ~uintptr_t(alignment - 1);
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return reinterpret_cast<void*>(aligned);
+}
+
+inline void alignedFree(void* p) {
+    if (p)
+        ::operator delete(reinterpret_cast<void**>(p)[-1]);
+}
+
+template <typename T, size_t ALIGNMENT>
+T* AlignedAllocator<T, ALIGNMENT>::allocate(size_t n) {
+    return static_cast<T*>(alignedMalloc(n * sizeof(T), ALIGNMENT));
+}
+
+template <typename T, size_t ALIGNMENT>
+void AlignedAllocator<T, ALIGNMENT>::deallocate(T* p, size_t) {
+    alignedFree(p);
+}
+
+}  // namespace timedata
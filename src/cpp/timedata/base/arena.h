@@ -0,0 +1,176 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <timedata/base/alignedAllocator.h>
+
+namespace timedata {
+
+/** A bump allocator for temporaries that only live for one frame.
+
+    allocate() just moves a pointer along a block of memory, deallocation
+    does nothing, and reset() makes all the memory available again in O(1)
+    at the end of the frame.  Blocks are kept across resets, so once the
+    arena has grown to fit the largest frame there is no heap traffic at
+    all.
+
+    An arena belongs to one thread: only that thread may allocate from it,
+    though others may read and write what it hands out.  Anything allocated
+    from it must not be used after the next reset().
+
+    Not every per-frame path goes through an arena or a SizeClassPool.
+    Each non-mutating operation on a Python list still creates a
+    Sample::List with std::allocator.  This covers a + b, abs(a), copy() and
+    every method that returns a new list instead of writing into self or
+    into an `out` argument.  The allocation happens because the new list
+    belongs to a Python object.  Python reference counting decides when that
+    object dies, not the frame, so an arena reset could free it while it is
+    still in use.  The object may also be released on a different thread
+    from the one that created it, which a per-thread SizeClassPool doesn't
+    allow.  To render a frame without heap traffic, use the mutating forms
+    instead.  These are the *_into and *_to methods, and slicing into an
+    existing list, which reuse the memory of a list the caller already
+    has. */
+class FrameArena {
+  public:
+    explicit FrameArena(size_t blockSize = size_t(1) << 20)
+            : blockSize_(blockSize) {
+    }
+    ~FrameArena();
+
+    FrameArena(FrameArena const&) = delete;
+    FrameArena& operator=(FrameArena const&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment = CACHE_LINE);
+
+    /** Free everything allocated since the last reset. */
+    void reset() {
+        block_ = 0;
+        offset_ = 0;
+    }
+
+    /** Frees everything allocated from the arena during its lifetime, so a
+        function can keep its temporaries in the arena without freeing
+        anything its callers allocated. */
+    class Scope {
+      public:
+        explicit Scope(FrameArena& arena)
+                : arena_(arena), block_(arena.block_), offset_(arena.offset_) {
+        }
+
+        ~Scope() {
+            arena_.block_ = block_;
+            arena_.offset_ = offset_;
+        }
+
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+
+      private:
+        FrameArena& arena_;
+        size_t block_, offset_;
+    };
+
+    /** The total size of the blocks the arena holds. */
+    size_t capacity() const;
+
+  private:
+    struct Block {
+        char* data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks_;
+    size_t block_ = 0, offset_ = 0;
+    size_t blockSize_;
+};
+
+/** This thread's frame arena. */
+FrameArena& frameArena();
+
+/** A standard allocator that draws from a FrameArena - by default, the
+    calling thread's frameArena(). */
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    FrameArena* arena;
+
+    ArenaAllocator() : arena(&frameArena()) {}
+    ArenaAllocator(FrameArena& a) : arena(&a) {}
+
+    template <typename U>
+    ArenaAllocator(ArenaAllocator<U> const& a) : arena(a.arena) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T*, size_t) {}
+
+    template <typename U>
+    bool operator==(ArenaAllocator<U> const& a) const {
+        return arena == a.arena;
+    }
+
+    template <typename U>
+    bool operator!=(ArenaAllocator<U> const& a) const {
+        return arena != a.arena;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+inline FrameArena::~FrameArena() {
+    for (auto& b: blocks_)
+        alignedFree(b.data);
+}
+
+inline void* FrameArena::allocate(size_t bytes, size_t alignment) {
+    for (; block_ < blocks_.size(); ++block_, offset_ = 0) {
+        // Align the address, not the offset: a block is only aligned to
+        // CACHE_LINE unless it was made for a larger alignment.
+        auto& b = blocks_[block_];
+        auto base = reinterpret_cast<uintptr_t>(b.data);
+        auto begin = ((base + offset_ + alignment - 1) & ~(alignment - 1)) -
+                base;
+        if (begin <= b.size and bytes <= b.size - begin) {
+            offset_ = begin + bytes;
+            return b.data + begin;
+        }
+    }
+
+    // Blocks are allocated with at least CACHE_LINE alignment.
+    auto size = std::max(blockSize_, bytes);
+    auto data = static_cast<char*>(
+        alignedMalloc(size, std::max(alignment, CACHE_LINE)));
+    blocks_.push_back({data, size});
+    block_ = blocks_.size() - 1;
+    offset_ = bytes;
+    return data;
+}
+
+inline size_t FrameArena::capacity() const {
+    size_t total = 0;
+    for (auto& b: blocks_)
+        total += b.size;
+    return total;
+}
+
+inline FrameArena& frameArena() {
+    static thread_local FrameArena arena;
+    return arena;
+}
+
+} // timedata
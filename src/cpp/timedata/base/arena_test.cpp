@@ -0,0 +1,101 @@
+#pragma once
+
+#include <timedata/base/arena.h>
+#include <timedata/base/pool.h>
+#include <timedata/color/cython_list_inl.h>
+
+namespace timedata {
+
+TEST_CASE("frameArena", "arena") {
+    FrameArena arena(1024);
+    auto a = arena.allocate(100);
+    auto b = arena.allocate(100);
+    REQUIRE(reinterpret_cast<uintptr_t>(a) % CACHE_LINE == 0);
+    REQUIRE(reinterpret_cast<uintptr_t>(b) % CACHE_LINE == 0);
+    REQUIRE(a != b);
+
+    arena.allocate(4000);
+    auto capacity = arena.capacity();
+    REQUIRE(capacity >= 5024);
+
+    arena.reset();
+    REQUIRE(arena.allocate(100) == a);
+    REQUIRE(arena.allocate(100) == b);
+    arena.allocate(4000);
+    REQUIRE(arena.capacity() == capacity);
+
+    arena.reset();
+    arena.allocate(1);
+    auto page = arena.allocate(100, 4096);
+    REQUIRE(reinterpret_cast<uintptr_t>(page) % 4096 == 0);
+    {
+        FrameArena::Scope scope(arena);
+        arena.allocate(100);
+        arena.allocate(4000);
+    }
+    REQUIRE(reinterpret_cast<char*>(arena.allocate(1)) ==
+            reinterpret_cast<char*>(page) + 128);
+}
+
+TEST_CASE("arenaList", "arena") {
+    using Color = color::CColorRGB;
+    using List = Color::BasicList<ArenaAllocator<Color>>;
+
+    FrameArena arena;
+    Color::List in(100, Color(0.25f, 0.5f, 0.75f));
+    size_t capacity = 0;
+
+    for (auto frame = 0; frame < 3; ++frame) {
+        List out{ArenaAllocator<Color>(arena)};
+        color_list::sliceOut(in, 0, 100, 2, out);
+        REQUIRE(out.size() == 50);
+        REQUIRE(out[49] == in[98]);
+
+        if (frame)
+            REQUIRE(arena.capacity() == capacity);
+        capacity = arena.capacity();
+        arena.reset();
+    }
+}
+
+TEST_CASE("sizeClassPool", "pool") {
+    SizeClassPool pool;
+    auto a = pool.allocate(10);
+    auto b = pool.allocate(64);
+    auto c = pool.allocate(65);
+    REQUIRE(pool.capacity() == 64 + 64 + 128);
+
+    pool.deallocate(a, 10);
+    pool.deallocate(c, 65);
+    REQUIRE(pool.allocate(100) == c);
+    REQUIRE(pool.allocate(1) == a);
+    REQUIRE(pool.capacity() == 64 + 64 + 128);
+
+    auto big = pool.allocate(size_t(1) << 30);
+    REQUIRE(pool.capacity() == 64 + 64 + 128);
+    pool.deallocate(big, size_t(1) << 30);
+    pool.deallocate(b, 64);
+}
+
+TEST_CASE("poolList", "pool") {
+    using Color = color::CColorRGB;
+    using List = Color::BasicList<PoolAllocator<Color>>;
+
+    SizeClassPool pool;
+    PoolAllocator<Color> alloc(pool);
+    size_t capacity = 0;
+
+    for (auto frame = 0; frame < 3; ++frame) {
+        List list(alloc);
+        for (auto i = 0; i < 1000; ++i)
+            list.emplace_back(0.0f, 0.5f, 1.0f);
+        auto copy = list;
+        REQUIRE(copy == list);
+
+        if (frame)
+            REQUIRE(pool.capacity() == capacity);
+        capacity = pool.capacity();
+    }
+}
+
+} // timedata
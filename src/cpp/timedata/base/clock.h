@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <thread>
+
+namespace timedata {
+
+/** The clocks used to pace real-time loops.  A clock is anything with the
+    same members as SteadyClock, so tests can substitute a clock whose time
+    they control. */
+struct SteadyClock {
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<
+        std::chrono::steady_clock, duration>;
+
+    /** Sleeping is only accurate to a scheduler tick or so, so the last
+        `spin` before a deadline is spent yielding instead. */
+    duration spin = std::chrono::microseconds(200);
+
+    time_point now() const;
+    void sleepUntil(time_point) const;
+};
+
+/** Convert frames per second to a frame period. */
+SteadyClock::duration framePeriod(double fps);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+inline SteadyClock::time_point SteadyClock::now() const {
+    return std::chrono::time_point_cast<duration>(
+        std::chrono::steady_clock::now());
+}
+
+inline void SteadyClock::sleepUntil(time_point t) const {
+    if (t - now() > spin)
+        std::this_thread::sleep_until(t - spin);
+    while (now() < t)
+        std::this_thread::yield();
+}
+
+inline SteadyClock::duration framePeriod(double fps) {
+    return std::chrono::duration_cast<SteadyClock::duration>(
+        std::chrono::duration<double>(1.0 / fps));
+}
+
+} // timedata
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define TIMEDATA_SIMD_X86 1
+#else
+#define TIMEDATA_SIMD_X86 0
+#endif
+
+#if TIMEDATA_SIMD_X86
+#include <immintrin.h>
+
+/** Compile one function for an instruction set, like "avx2", that the rest
+    of the build doesn't assume.  Only call it once the CPU is known to
+    support that instruction set. */
+#define TIMEDATA_TARGET(isa) __attribute__((target(isa)))
+
+/** Run the statement in the remaining arguments with `Kernel` naming the
+    kernel struct `Avx2` if `level` allows it, and `Scalar` otherwise.  On
+    other builds `Avx2` isn't named at all, so it can be defined inside
+    #if TIMEDATA_SIMD_X86. */
+#define TIMEDATA_DISPATCH(level, Scalar, Avx2, ...)                     \
+    do {                                                                \
+        if ((level) >= ::timedata::SimdLevel::avx2) {                   \
+            using Kernel = Avx2;                                        \
+            __VA_ARGS__;                                                \
+        } else {                                                        \
+            using Kernel = Scalar;                                      \
+            __VA_ARGS__;                                                \
+        }                                                               \
+    } while (false)
+
+#else
+
+#define TIMEDATA_DISPATCH(level, Scalar, Avx2, ...)                     \
+    do {                                                                \
+        (void) (level);                                                 \
+        using Kernel = Scalar;                                          \
+        __VA_ARGS__;                                                    \
+    } while (false)
+
+#endif
+
+namespace timedata {
+
+/** The instruction set levels we have hand-written kernels for, in
+    increasing order of capability. */
+enum class SimdLevel { scalar, sse2, avx2, avx512, last = avx512 };
+
+/** The best SimdLevel the CPU we are running on supports, detected once
+    from CPUID. */
+SimdLevel cpuSimdLevel();
+
+/** The SimdLevel that the dispatched kernels actually use.  It starts as
+    cpuSimdLevel(), and can be lowered - for example, to compare results
+    against the scalar kernels - but never raised above it. */
+SimdLevel simdLevel();
+void setSimdLevel(SimdLevel);
+
+char const* simdLevelName(SimdLevel);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+inline SimdLevel detectSimdLevel() {
+#if TIMEDATA_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return SimdLevel::avx512;
+    if (__builtin_cpu_supports("avx2"))
+        return SimdLevel::avx2;
+    if (__builtin_cpu_supports("sse2"))
+        return SimdLevel::sse2;
+#endif
+    return SimdLevel::scalar;
+}
+
+inline SimdLevel& currentSimdLevel() {
+    static SimdLevel level = cpuSimdLevel();
+    return level;
+}
+
+} // detail
+
+inline SimdLevel cpuSimdLevel() {
+    static const auto level = detail::detectSimdLevel();
+    return level;
+}
+
+inline SimdLevel simdLevel() {
+    return detail::currentSimdLevel();
+}
+
+inline void setSimdLevel(SimdLevel level) {
+    detail::currentSimdLevel() = std::min(level, cpuSimdLevel());
+}
+
+inline char const* simdLevelName(SimdLevel level) {
+    static char const* const NAMES[] = {"scalar", "sse2", "avx2", "avx512"};
+    return NAMES[static_cast<int>(level)];
+}
+
+} // timedata
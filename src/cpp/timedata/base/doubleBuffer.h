@@ -1,20 +1,37 @@
 #pragma once
 
-#include <string>
+#include <mutex>
+#include <utility>
 
 namespace timedata {
 
+/** Hand containers from a producer thread to a consumer thread, under a lock.
+
+    The producer fills in() and calls setDirty() to publish it, or passes a
+    whole container to store().  The consumer calls out() to get the latest
+    published container.  Nothing is ever copied - containers are swapped,
+    so the producer gets old storage back to reuse.
+
+    See TripleBuffer for a version that never takes a lock. */
 template <typename Container,
-          typename Mutex = std::mutex, typename Lock = unique_lock<std::mutex>>
+          typename Mutex = std::mutex, typename Lock = std::unique_lock<Mutex>>
 class DoubleBuffer {
   public:
     DoubleBuffer() = default;
 
+    /** Producer: the container to fill before calling setDirty(). */
+    Container& in() { return in_; }
+
+    /** Producer: publish in(). */
     void setDirty() {
         Lock lock(mutex_);
+        using std::swap;
+        swap(in_, buffer_);
         dirty_ = true;
     }
 
+    /** Producer: publish `data`, which gets back the previous contents of the
+        shared buffer. */
     void store(Container&& data) {
         Lock lock(mutex_);
         using std::swap;
@@ -22,32 +39,29 @@ class DoubleBuffer {
         dirty_ = true;
     }
 
+    /** Consumer: take the latest published container, if there is a new one.
+        Returns true if there was. */
     bool recall() {
         Lock lock(mutex_);
         if (not dirty_)
             return false;
 
         using std::swap;
-        swap(result, buffer_);
+        swap(out_, buffer_);
         dirty_ = false;
         return true;
     }
 
-    Container const& in() const {
-        recall();
-        return in_;
-    }
-
-    /** The reference can be used without locks until the next call to setDirty.
-     */
-    Container& out() {
+    /** Consumer: the latest published container.  The reference can be used
+        without locks until the next call to out() or recall(). */
+    Container const& out() {
         recall();
         return out_;
     }
 
   private:
     Mutex mutex_;
-    Container in_, out_;
+    Container in_, buffer_, out_;
     bool dirty_ = false;
 };
 
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <timedata/base/alignedAllocator.h>
+
+namespace timedata {
+
+/** A gamma lookup table with a fixed number of entries and outputs of type T.
+
+    Unlike a GammaTable, whose size depends on the gamma, a GammaLut always
+    has 2 ** indexBits entries, so its size and cache footprint are known in
+    advance: the default of 12 index bits is 4K for 8-bit outputs and 8K for
+    16-bit ones.  The table is aligned to a cache line.
+
+    A fixed size means that 8-bit outputs can differ slightly from
+    makeGammaTable's, which is sized by the gamma - to get exactly those
+    bytes, build the GammaLut from the GammaTable itself.
+
+    `bits` is the number of significant bits of output - 8 for uint8_t, and
+    12 or 16 for uint16_t.  `min`, `max` and `offset` are in the same 8-bit
+    units as Render3, and are scaled to the output width, so the same
+    Render3 gives the same curve at any output width.
+*/
+template <typename T>
+class GammaLut {
+  public:
+    using value_type = T;
+
+    static const size_t DEFAULT_INDEX_BITS = 12;
+
+    /** A million entries is far past any visible difference, and keeps
+        indexes well inside an int32_t. */
+    static const size_t MAX_INDEX_BITS = 20;
+
+    GammaLut() = default;
+
+    /** Throws std::invalid_argument if `bits` is zero or too wide for T, or
+        if `indexBits` is zero or more than MAX_INDEX_BITS. */
+    GammaLut(float gamma, size_t bits = 8 * sizeof(T),
+             size_t indexBits = DEFAULT_INDEX_BITS, float offset = 0.0f,
+             uint8_t min = 0, uint8_t max = 255);
+
+    /** Use an existing table, like one from makeGammaTable, unchanged. */
+    explicit GammaLut(std::vector<T> const& table);
+
+    /** The index of the table entry for x, where 1.0 is full scale.  Out of
+        band values are clipped to the ends of the table, and NaN is 0:
+        std::max returns its first argument when the comparison is false, so
+        0.0f has to come first. */
+    size_t index(float x) const {
+        auto i = scale_ * std::max(0.0f, x);
+        return static_cast<size_t>(std::min(i, top_));
+    }
+
+    T operator()(float x) const { return table_[index(x)]; }
+
+    T const* data() const { return table_.data(); }
+    size_t size() const { return table_.size(); }
+
+  private:
+    AlignedVector<T> table_;
+    float scale_ = 0.0f;
+    float top_ = 0.0f;
+};
+
+using GammaLut8 = GammaLut<uint8_t>;
+using GammaLut16 = GammaLut<uint16_t>;
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+inline size_t checkIndexBits(size_t indexBits, size_t maxIndexBits) {
+    if (not indexBits or indexBits > maxIndexBits) {
+        throw std::invalid_argument(
+            "Gamma index bits must be from 1 to " +
+            std::to_string(maxIndexBits) + ", not " +
+            std::to_string(indexBits));
+    }
+    return indexBits;
+}
+
+} // detail
+
+template <typename T>
+GammaLut<T>::GammaLut(float gamma, size_t bits, size_t indexBits,
+                      float offset, uint8_t min, uint8_t max)
+        : table_(size_t(1) << detail::checkIndexBits(
+              indexBits, MAX_INDEX_BITS)),
+          scale_(static_cast<float>(table_.size())),
+          top_(static_cast<float>(table_.size() - 1)) {
+    if (not bits or bits > 8 * sizeof(T)) {
+        throw std::invalid_argument(
+            "Gamma output bits must be from 1 to " +
+            std::to_string(8 * sizeof(T)) + ", not " + std::to_string(bits));
+    }
+
+    // Scale the 8-bit parameters so that 255 becomes full scale.
+    auto full = static_cast<float>((size_t(1) << bits) - 1);
+    auto unit = full / 255.0f;
+    auto lo = min * full / 255.0f, hi = max * full / 255.0f;
+
+    // As in makeGammaTable, entry i covers inputs from i / size up.
+    auto width = unit + hi - lo;
+    auto size = static_cast<float>(table_.size());
+    for (size_t i = 0; i < table_.size(); ++i) {
+        auto ratio = std::pow(i / size, gamma);
+        auto g = std::min(hi, lo + ratio * width + offset * unit);
+        table_[i] = static_cast<T>(std::max(g, 0.0f));
+    }
+}
+
+template <typename T>
+GammaLut<T>::GammaLut(std::vector<T> const& table)
+        : table_(table.begin(), table.end()),
+          scale_(static_cast<float>(table_.size())),
+          top_(static_cast<float>(table_.size() - 1)) {
+}
+
+}  // namespace timedata
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <timedata/base/gammaLut.h>
+#include <timedata/base/gammaTable.h>
+
+namespace timedata {
+namespace gamma_lut {
+
+TEST_CASE("gammaLut identity", "gammaLut") {
+    GammaLut8 lut(1.0f);
+    REQUIRE(lut.size() == 4096);
+    REQUIRE(reinterpret_cast<uintptr_t>(lut.data()) % CACHE_LINE == 0);
+    REQUIRE(lut(-1.0f) == 0);
+    REQUIRE(lut(2.0f) == 255);
+
+    for (size_t i = 0; i < 256; i++)
+        REQUIRE(i == lut(i / 255.0f));
+}
+
+TEST_CASE("gammaLut matches gammaTable", "gammaLut") {
+    auto table = makeGammaTable(2.5f);
+    GammaLut8 lut(2.5f);
+
+    for (size_t i = 1; i < 0xFF; i++) {
+        auto f = std::pow((i + 0.5f) / 256.0f, 1.0f / 2.5f);
+        REQUIRE(lut(f) == getGamma(table, f));
+    }
+}
+
+TEST_CASE("gammaLut wide", "gammaLut") {
+    GammaLut16 lut16(2.5f, 16, 14);
+    REQUIRE(lut16.size() == 16384);
+    REQUIRE(lut16(0.0f) == 0);
+    REQUIRE(lut16(1.0f) == 0xFFFF);
+
+    GammaLut16 lut12(2.5f, 12);
+    REQUIRE(lut12(1.0f) == 0xFFF);
+
+    uint16_t last = 0;
+    for (size_t i = 0; i <= 1000; ++i) {
+        auto x = lut16(i / 1000.0f);
+        REQUIRE(x >= last);
+        last = x;
+    }
+}
+
+TEST_CASE("gammaLut from a gammaTable", "gammaLut") {
+    auto table = makeGammaTable(2.5f, 0.5f, 3, 250);
+    GammaLut8 lut(table);
+    REQUIRE(lut.size() == table.size());
+    for (size_t i = 0; i <= 10000; ++i) {
+        auto x = i / 9000.0f - 0.05f;
+        REQUIRE(lut(x) == getGamma(table, x));
+    }
+}
+
+TEST_CASE("gammaLut bad bits", "gammaLut") {
+    REQUIRE_THROWS_AS(GammaLut8(2.5f, 8, 0), std::invalid_argument const&);
+    REQUIRE_THROWS_AS(GammaLut8(2.5f, 8, 21), std::invalid_argument const&);
+    REQUIRE_THROWS_AS(GammaLut8(2.5f, 8, 64), std::invalid_argument const&);
+    REQUIRE_THROWS_AS(GammaLut8(2.5f, 9), std::invalid_argument const&);
+    REQUIRE_THROWS_AS(GammaLut16(2.5f, 0), std::invalid_argument const&);
+    REQUIRE(GammaLut16(2.5f, 16, 20).size() == size_t(1) << 20);
+}
+
+TEST_CASE("gammaLut NaN and infinities", "gammaLut") {
+    auto inf = std::numeric_limits<float>::infinity();
+    GammaLut8 classic(makeGammaTable(2.5f, 0.5f, 3, 250));
+    GammaLut8 lut8(2.5f, 8, 12);
+    GammaLut16 lut16(2.5f, 16, 14);
+
+    for (auto x: {NAN, -NAN, -inf, -1e30f}) {
+        REQUIRE(classic.index(x) == 0);
+        REQUIRE(lut8.index(x) == 0);
+        REQUIRE(lut16.index(x) == 0);
+    }
+    for (auto x: {inf, 1e30f}) {
+        REQUIRE(classic.index(x) == classic.size() - 1);
+        REQUIRE(lut8.index(x) == lut8.size() - 1);
+        REQUIRE(lut16.index(x) == lut16.size() - 1);
+    }
+}
+
+} // gamma_lut
+} // timedata
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <cstddef>
+#include <cmath>
+#include <cstdint>
+#include <vector>
 #include <timedata/base/join_inl.h>
 
 namespace timedata {
@@ -34,7 +34,7 @@ TEST_CASE("gammaTable full") {
 }
 
 void testGamma(float gamma, size_t size) {
-    auto table = makeGammaTable(gamma, 0x80, 0xFF);
+    auto table = makeGammaTable(gamma, 0, 0x80, 0xFF);
     REQUIRE(table.size() == size);
     REQUIRE(getGamma(table, 0) == 0x80);
     REQUIRE(getGamma(table, 1) == 0xFF);
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <timedata/base/cpu.h>
+
+namespace timedata {
+
+/** An IEEE 754 binary16 "half precision" floating point number.
+
+    Halves are only for storage: a Half converts to and from float
+    implicitly, so all arithmetic on Halves is done in float and rounded back
+    to the nearest Half when it's stored.
+
+    A half has an 11-bit significand - about three decimal digits, or better
+    than one part in 2000 - and a range of about +-65504. */
+class Half {
+  public:
+    Half() : bits_(0) {}
+    Half(float x) : bits_(fromFloat(x)) {}
+
+    operator float() const { return toFloat(bits_); }
+
+    uint16_t bits() const { return bits_; }
+    static Half fromBits(uint16_t bits) {
+        Half h;
+        h.bits_ = bits;
+        return h;
+    }
+
+    /** Round a float to the nearest half, ties to even, as F16C does. */
+    static uint16_t fromFloat(float);
+    static float toFloat(uint16_t);
+
+  private:
+    uint16_t bits_;
+};
+
+/** Does this CPU have the F16C half-precision conversion instructions? */
+bool cpuHasF16c();
+
+namespace simd {
+
+/** Convert flat arrays between Half and float, using F16C if we have it. */
+void halfToFloat(Half const* in, float* out, size_t size);
+void floatToHalf(float const* in, Half* out, size_t size);
+
+/** The same, optionally without F16C - useful for testing. */
+void halfToFloat(bool useF16c, Half const* in, float* out, size_t size);
+void floatToHalf(bool useF16c, float const* in, Half* out, size_t size);
+
+} // simd
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+inline uint16_t Half::fromFloat(float x) {
+    uint32_t f;
+    std::memcpy(&f, &x, sizeof(f));
+
+    auto sign = uint16_t((f >> 16) & 0x8000);
+    auto exponent = int((f >> 23) & 0xFF);
+    auto mantissa = f & 0x7FFFFF;
+
+    if (exponent == 0xFF) {
+        // Infinity stays infinity; NaNs stay quiet NaNs.
+        return sign | 0x7C00 | (mantissa ? (0x200 | (mantissa >> 13)) : 0);
+    }
+
+    // Rebias from 127 to 15.
+    exponent -= 127 - 15;
+    if (exponent >= 0x1F)
+        return sign | 0x7C00;
+
+    if (exponent <= 0) {
+        // Subnormal or zero: shift the implicit bit in, then round.
+        if (exponent < -10)
+            return sign;
+        mantissa |= 0x800000;
+        auto shift = uint32_t(14 - exponent);
+        auto half = mantissa >> shift;
+        auto rest = mantissa & ((1u << shift) - 1);
+        auto midpoint = 1u << (shift - 1);
+        if (rest > midpoint or (rest == midpoint and (half & 1)))
+            ++half;
+        return sign | uint16_t(half);
+    }
+
+    auto half = uint32_t(exponent << 10) | (mantissa >> 13);
+    auto rest = mantissa & 0x1FFF;
+    if (rest > 0x1000 or (rest == 0x1000 and (half & 1)))
+        ++half;  // A carry into the exponent is still correct.
+    return sign | uint16_t(half);
+}
+
+inline float Half::toFloat(uint16_t h) {
+    auto sign = uint32_t(h & 0x8000) << 16;
+    auto exponent = uint32_t(h >> 10) & 0x1F;
+    auto mantissa = uint32_t(h & 0x3FF);
+
+    uint32_t f;
+    if (exponent == 0x1F) {
+        // Like F16C, make signaling NaNs quiet.
+        f = sign | 0x7F800000 | (mantissa ? (0x400000 | mantissa << 13) : 0);
+    } else if (exponent) {
+        f = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    } else if (mantissa) {
+        // Subnormal: normalize it.
+        exponent = 127 - 15 + 1;
+        while (not (mantissa & 0x400)) {
+            mantissa <<= 1;
+            --exponent;
+        }
+        f = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+    } else {
+        f = sign;
+    }
+
+    float x;
+    std::memcpy(&x, &f, sizeof(x));
+    return x;
+}
+
+inline bool cpuHasF16c() {
+#if TIMEDATA_SIMD_X86
+    static const bool has = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx") and
+            __builtin_cpu_supports("f16c");
+    }();
+    return has;
+#else
+    return false;
+#endif
+}
+
+namespace simd {
+
+#if TIMEDATA_SIMD_X86
+
+TIMEDATA_TARGET("avx,f16c")
+inline void halfToFloatF16c(Half const* in, float* out, size_t size) {
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        auto h = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i));
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+    }
+    for (; i < size; ++i)
+        out[i] = in[i];
+}
+
+TIMEDATA_TARGET("avx,f16c")
+inline void floatToHalfF16c(float const* in, Half* out, size_t size) {
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        auto h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i),
+                                 _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), h);
+    }
+    for (; i < size; ++i)
+        out[i] = in[i];
+}
+
+#endif  // TIMEDATA_SIMD_X86
+
+inline void halfToFloat(bool useF16c, Half const* in, float* out,
+                        size_t size) {
+#if TIMEDATA_SIMD_X86
+    if (useF16c and cpuHasF16c())
+        return halfToFloatF16c(in, out, size);
+#else
+    (void) useF16c;
+#endif
+    for (size_t i = 0; i < size; ++i)
+        out[i] = in[i];
+}
+
+inline void floatToHalf(bool useF16c, float const* in, Half* out,
+                        size_t size) {
+#if TIMEDATA_SIMD_X86
+    if (useF16c and cpuHasF16c())
+        return floatToHalfF16c(in, out, size);
+#else
+    (void) useF16c;
+#endif
+    for (size_t i = 0; i < size; ++i)
+        out[i] = in[i];
+}
+
+inline void halfToFloat(Half const* in, float* out, size_t size) {
+    halfToFloat(true, in, out, size);
+}
+
+inline void floatToHalf(float const* in, Half* out, size_t size) {
+    floatToHalf(true, in, out, size);
+}
+
+} // simd
+} // timedata
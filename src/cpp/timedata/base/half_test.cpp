@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <timedata/base/half.h>
+#include <timedata/color/cython_list_inl.h>
+#include <timedata/signal/convertList.h>
+
+namespace timedata {
+
+/** Halves round-trip through float exactly. */
+TEST_CASE("half", "half") {
+    REQUIRE(Half(1.0f).bits() == 0x3C00);
+    REQUIRE(Half(-2.0f).bits() == 0xC000);
+    REQUIRE(Half(65504.0f).bits() == 0x7BFF);
+    REQUIRE(Half(65520.0f).bits() == 0x7C00);
+    REQUIRE(Half(std::ldexp(1.0f, -24)).bits() == 0x0001);
+    REQUIRE(Half(std::ldexp(1.0f, -25)).bits() == 0x0000);
+    REQUIRE(Half(1.0f + std::ldexp(1.0f, -11)).bits() == 0x3C00);
+    REQUIRE(Half(1.0f + 3 * std::ldexp(1.0f, -11)).bits() == 0x3C02);
+    REQUIRE(std::isnan(float(Half(NAN))));
+    REQUIRE(float(Half(0.25f)) == 0.25f);
+
+    // Arithmetic is done in float, and rounded back when stored.
+    Half x = 0.5f, y = 0.25f;
+    x = x + y;
+    REQUIRE(float(x) == 0.75f);
+}
+
+TEST_CASE("half conversion kernels", "half") {
+    // Every half converts exactly to float, and back to the same half.
+    std::vector<Half> halfs;
+    for (uint32_t i = 0; i < 0x10000; ++i)
+        halfs.push_back(Half::fromBits(uint16_t(i)));
+
+    std::vector<float> scalar(halfs.size()), f16c(halfs.size());
+    simd::halfToFloat(false, halfs.data(), scalar.data(), halfs.size());
+    simd::halfToFloat(true, halfs.data(), f16c.data(), halfs.size());
+    REQUIRE(not std::memcmp(scalar.data(), f16c.data(),
+                            scalar.size() * sizeof(float)));
+
+    std::vector<Half> back(halfs.size());
+    simd::floatToHalf(false, scalar.data(), back.data(), back.size());
+    for (size_t i = 0; i < halfs.size(); ++i) {
+        if (not std::isnan(scalar[i]))
+            REQUIRE(back[i].bits() == halfs[i].bits());
+    }
+
+    // Floats round the same way with and without F16C.
+    std::vector<float> floats;
+    for (uint32_t i = 0; i < 200000; ++i) {
+        auto bits = i * 21493u + (i >> 3) * 0x10000u;
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        floats.push_back(f);
+    }
+    std::vector<Half> hs(floats.size()), hf(floats.size());
+    simd::floatToHalf(false, floats.data(), hs.data(), floats.size());
+    simd::floatToHalf(true, floats.data(), hf.data(), floats.size());
+    for (size_t i = 0; i < floats.size(); ++i)
+        REQUIRE(hs[i].bits() == hf[i].bits());
+}
+
+TEST_CASE("half samples", "half") {
+    using namespace converter;
+    REQUIRE(sizeof(ColorRGBHalf) == 6);
+
+    ColorRGB::List normal;
+    for (auto i = 0; i < 100; ++i)
+        normal.emplace_back(i / 100.0f, 0.5f, 1.0f - i / 100.0f);
+
+    ColorRGBHalf::List halfs;
+    convertList(normal, halfs);
+    REQUIRE(getSizeof(halfs) < getSizeof(normal));
+
+    ColorRGB::List back;
+    convertList(halfs, back);
+    for (size_t i = 0; i < normal.size(); ++i) {
+        for (size_t j = 0; j < 3; ++j)
+            REQUIRE(std::abs(*back[i][j] - *normal[i][j]) < 0.0005f);
+    }
+
+    ColorRGB255::List bytes;
+    convertList(halfs, bytes);
+    REQUIRE(*bytes[99][2] == Approx(2.55f).epsilon(0.001));
+
+    auto sum = halfs[10][0] + halfs[20][0];
+    REQUIRE(float(*sum) == Approx(0.3f).epsilon(0.001));
+    REQUIRE(halfs[10][0] < halfs[20][0]);
+    REQUIRE(float(halfs[20][0]) == Approx(0.2f).epsilon(0.001));
+}
+
+namespace half_list {
+
+/** Every list operation works on Half samples, in float. */
+TEST_CASE("half lists", "half") {
+    using namespace color_list;
+    using Color = ColorRGBHalf;
+    Color const x(0.25f, 0.5f, 0.75f), y(0.5f, 0.5f, 0.5f);
+    Color::List xs(5, x), ys(5, y), out;
+
+    auto all = [&](float r, float g, float b) {
+        REQUIRE(out.size() == 5);
+        for (auto& c: out) {
+            REQUIRE(float(c[0]) == Approx(r).epsilon(0.001));
+            REQUIRE(float(c[1]) == Approx(g).epsilon(0.001));
+            REQUIRE(float(c[2]) == Approx(b).epsilon(0.001));
+        }
+    };
+
+    math_add(xs, ys, out);
+    all(0.75f, 1.0f, 1.25f);
+    math_sub(xs, ys, out);
+    all(0.25f, 0.0f, -0.25f);
+    math_rsub(xs, ys, out);
+    all(-0.25f, 0.0f, 0.25f);
+    math_mul(xs, ys, out);
+    all(0.125f, 0.25f, 0.375f);
+    math_div(xs, ys, out);
+    all(0.5f, 1.0f, 1.5f);
+    math_rdiv(xs, ys, out);
+    all(2.0f, 1.0f, 2.0f / 3);
+    math_pow(xs, Half(2.0f), out);
+    all(0.0625f, 0.25f, 0.5625f);
+    math_rpow(xs, Half(2.0f), out);
+    all(std::pow(2.0f, 0.25f), std::pow(2.0f, 0.5f), std::pow(2.0f, 0.75f));
+    math_min_limit(xs, ys, out);
+    all(0.5f, 0.5f, 0.75f);
+    math_max_limit(xs, ys, out);
+    all(0.25f, 0.5f, 0.5f);
+    math_add(xs, y, out);
+    all(0.75f, 1.0f, 1.25f);
+
+    math_neg(xs, out);
+    all(-0.25f, -0.5f, -0.75f);
+    math_abs(out, out);
+    all(0.25f, 0.5f, 0.75f);
+    math_invert(xs, out);
+    all(0.75f, 0.5f, 0.25f);
+    math_floor(xs, out);
+    all(0, 0, 0);
+    math_ceil(xs, out);
+    all(1, 1, 1);
+    math_trunc(xs, out);
+    all(0, 0, 0);
+    math_reverse(xs, out);
+    all(0.25f, 0.5f, 0.75f);
+    math_zero(out);
+    all(0, 0, 0);
+    math_clear(out);
+    REQUIRE(out.empty());
+
+    REQUIRE(compare(xs, ys) == -0.25f);
+    REQUIRE(compare(y, xs) == 0.25f);
+    REQUIRE(distance2(xs, ys) == 5 * 0.125f);
+    REQUIRE(max_cpp(xs) == x);
+    REQUIRE(min_cpp(xs) == x);
+    REQUIRE(toString(Color::List(1, x)) == "((0.25, 0.5, 0.75))");
+}
+
+} // half_list
+
+} // timedata
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace timedata {
+
+/** A whole file mapped read-only into memory.  Pages are read from disk the
+    first time they're touched, and can be dropped again by the OS under
+    memory pressure, so a file can be much larger than the RAM we have.
+
+    Throws std::runtime_error if the file can't be opened or mapped. */
+class MappedFile {
+  public:
+    explicit MappedFile(std::string const& filename);
+    ~MappedFile();
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    char const* data() const { return data_; }
+    size_t size() const { return size_; }
+
+  private:
+    char const* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE, mapping_ = nullptr;
+#endif
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef _WIN32
+
+inline MappedFile::MappedFile(std::string const& filename) {
+    file_ = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                        nullptr);
+    if (file_ == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Can't open " + filename);
+
+    LARGE_INTEGER size;
+    if (not GetFileSizeEx(file_, &size)) {
+        CloseHandle(file_);
+        throw std::runtime_error("Can't get the size of " + filename);
+    }
+    size_ = static_cast<size_t>(size.QuadPart);
+    if (not size_)
+        return;
+
+    mapping_ = CreateFileMappingA(
+        file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_)
+        data_ = static_cast<char const*>(
+            MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+    if (not data_) {
+        if (mapping_)
+            CloseHandle(mapping_);
+        CloseHandle(file_);
+        throw std::runtime_error("Can't map " + filename);
+    }
+}
+
+inline MappedFile::~MappedFile() {
+    if (data_)
+        UnmapViewOfFile(data_);
+    if (mapping_)
+        CloseHandle(mapping_);
+    if (file_ != INVALID_HANDLE_VALUE)
+        CloseHandle(file_);
+}
+
+#else
+
+inline MappedFile::MappedFile(std::string const& filename) {
+    auto fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Can't open " + filename);
+
+    struct stat st;
+    if (::fstat(fd, &st)) {
+        ::close(fd);
+        throw std::runtime_error("Can't get the size of " + filename);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+
+    if (size_) {
+        auto p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Can't map " + filename);
+        }
+        data_ = static_cast<char const*>(p);
+    }
+
+    // The mapping keeps the file open.
+    ::close(fd);
+}
+
+inline MappedFile::~MappedFile() {
+    if (data_)
+        ::munmap(const_cast<char*>(data_), size_);
+}
+
+#endif
+
+} // timedata
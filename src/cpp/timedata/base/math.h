@@ -52,6 +52,16 @@ void removeTrailing(std::string&, char ch);
 /** Convert a float to a string. */
 std::string toString(float, unsigned int decimals = 0);
 
+/** Append toString(x, decimals) to `out`.  For up to nine decimals, the
+    digits come from exact integer arithmetic on the float's bits - rounding
+    exactly as printf does, but without printf or a temporary string. */
+void appendFloat(float x, unsigned int decimals, std::string& out);
+
+/** Append commaSeparated(collection, decimals) to `out`. */
+template <typename Collection>
+void appendCommaSeparated(
+    Collection const&, int decimals, std::string& out);
+
 template <typename T>
 void skipSpaces(T* p);
 
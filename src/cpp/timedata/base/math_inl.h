@@ -3,10 +3,15 @@
 #include <ctype.h>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <iomanip>
 #include <sstream>
+#include <string>
 #include <type_traits>
 
+#include <timedata/base/join_inl.h>
 #include <timedata/base/math.h>
 
 namespace timedata {
@@ -85,15 +90,7 @@ inline bool fromHexWithPrefix(char const* s, unsigned& result) {
 template <typename Collection>
 std::string commaSeparated(Collection const& collection, int decimals) {
     std::string result;
-
-    bool first = true;
-    for (auto& c: collection) {
-        if (first)
-            first = false;
-        else
-            result += ", ";
-        result += toString(c, decimals);
-    }
+    appendCommaSeparated(collection, decimals, result);
     return result;
 }
 
@@ -139,17 +136,95 @@ inline void removeTrailing(std::string& s, char ch) {
     s.resize(i);
 }
 
-/** Convert a float to a string. */
-inline std::string toString(float x, unsigned int decimals) {
-    // Add 1 for the - sign and one for the .
-    size_t size = log10(static_cast<uint64_t>(std::abs(x))) + 3 + decimals + 2;
+namespace detail {
+
+inline void appendFloatPrintf(float x, unsigned int decimals,
+                              std::string& out) {
+    // Enough for the - sign, the 39 digits of FLT_MAX, the . and the decimals.
+    size_t size = 48 + decimals;
     std::string number(size, ' ');
     number.resize(snprintf(&number[0], size, "%1.*f", decimals, x));
     if (number.find('.') != std::string::npos) {
         removeTrailing(number, '0');
         removeTrailing(number, '.');
     }
-    return number;
+    out += number;
+}
+
+} // detail
+
+inline void appendFloat(float x, unsigned int decimals, std::string& out) {
+    static const unsigned MAX_DECIMALS = 9;
+    static const int MAX_EXPONENT = 9;
+
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    auto exponent = static_cast<int>((bits >> 23) & 0xFF);
+    uint64_t mantissa = bits & 0x7FFFFF;
+    if (exponent == 0xFF or decimals > MAX_DECIMALS)
+        return detail::appendFloatPrintf(x, decimals, out);
+
+    // x is exactly mantissa * 2**exponent.
+    if (exponent)
+        mantissa |= 0x800000;
+    else
+        exponent = 1;
+    exponent -= 127 + 23;
+    if (exponent > MAX_EXPONENT)
+        return detail::appendFloatPrintf(x, decimals, out);
+
+    // Round x * 10**decimals to an integer, ties to even, like printf.
+    auto power = pow10(decimals);
+    auto scaled = mantissa * power;
+    uint64_t q = 0;
+    if (exponent >= 0) {
+        q = scaled << exponent;
+    } else if (exponent > -63) {
+        auto shift = static_cast<unsigned>(-exponent);
+        q = scaled >> shift;
+        auto rest = scaled & ((uint64_t(1) << shift) - 1);
+        auto half = uint64_t(1) << (shift - 1);
+        if (rest > half or (rest == half and (q & 1)))
+            ++q;
+    }
+
+    char buffer[32];
+    auto end = buffer + sizeof(buffer), p = end;
+    auto fraction = q % power, whole = q / power;
+    if (fraction) {
+        auto digits = decimals;
+        for (; not (fraction % 10); fraction /= 10, --digits);
+        for (; digits; fraction /= 10, --digits)
+            *--p = static_cast<char>('0' + fraction % 10);
+        *--p = '.';
+    }
+    do {
+        *--p = static_cast<char>('0' + whole % 10);
+        whole /= 10;
+    } while (whole);
+    if (bits >> 31)
+        *--p = '-';
+    out.append(p, end);
+}
+
+/** Convert a float to a string. */
+inline std::string toString(float x, unsigned int decimals) {
+    std::string result;
+    appendFloat(x, decimals, result);
+    return result;
+}
+
+template <typename Collection>
+void appendCommaSeparated(
+        Collection const& collection, int decimals, std::string& out) {
+    bool first = true;
+    for (auto& c: collection) {
+        if (first)
+            first = false;
+        else
+            out += ", ";
+        appendFloat(c, decimals, out);
+    }
 }
 
 template <typename T>
@@ -199,7 +274,7 @@ inline float divideByZero(float x) {
         return std::numeric_limits<float>::infinity();
     if (x < 0)
         return -std::numeric_limits<float>::infinity();
-    return std::nanf(nullptr);
+    return std::nanf("");
 }
 
 inline float divPython(float x, float y) {
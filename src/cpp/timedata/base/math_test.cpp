@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdio>
+#include <vector>
+
 #include <timedata/base/math_inl.h>
 
 namespace timedata {
@@ -17,5 +20,44 @@ TEST_CASE("math", "toString") {
     REQUIRE(toString(-10.236, 2) == "-10.24");
 }
 
+TEST_CASE("appendFloat", "math") {
+    auto printf = [](float x, unsigned decimals) {
+        char buffer[128];
+        std::string s(buffer, snprintf(buffer, sizeof(buffer), "%1.*f",
+                                       decimals, x));
+        if (s.find('.') != std::string::npos) {
+            removeTrailing(s, '0');
+            removeTrailing(s, '.');
+        }
+        return s;
+    };
+
+    std::vector<float> cases = {
+        0.0f, -0.0f, 0.5f, 1.5f, 2.5f, -0.125f, 0.0001f, 1e-8f, 1e-30f,
+        1.4e-45f, 1e3f, 123456.789f, 16777216.0f, 3e9f, 1e20f, 3.4e38f,
+        std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN()};
+
+    uint32_t seed = 12345;
+    for (auto i = 0; i < 20000; ++i) {
+        seed = seed * 1664525 + 1013904223;
+        auto x = static_cast<float>(seed) / 4294967296.0f;
+        cases.push_back((seed & 1 ? -1.0f : 1.0f) * x * (1 + (seed >> 20)));
+    }
+
+    for (auto x: cases) {
+        for (unsigned decimals = 0; decimals <= 10; ++decimals) {
+            std::string s = "x";
+            appendFloat(x, decimals, s);
+            REQUIRE(s == "x" + printf(x, decimals));
+        }
+    }
+
+    std::string s;
+    appendCommaSeparated(std::vector<float>{0.5f, -1.0f, 0.25f}, 1, s);
+    REQUIRE(s == "0.5, -1, 0.2");
+}
+
 } // math
 } // timedata
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <timedata/base/threadPool.h>
+
+namespace timedata {
+
+/** The execution policy for list operations.
+
+    By default everything runs on the calling thread.  Setting `threshold`
+    opts in to parallel execution: operations on lists with at least that many
+    samples get split into chunks of `grain` samples, which are spread over
+    the shared threadPool(). */
+struct Parallelism {
+    /** Lists with fewer samples than this run on one thread.  Zero means
+        "never run in parallel". */
+    size_t threshold = 0;
+
+    /** The number of samples in each parallel task. */
+    size_t grain = 16384;
+
+    bool isParallel(size_t size) const {
+        return threshold and size >= threshold and size > grain;
+    }
+};
+
+/** The global execution policy. */
+Parallelism& parallelism();
+
+/** Call f(begin, end) for consecutive chunks that exactly cover [0, size),
+    in parallel if the policy says so.
+
+    Chunk boundaries only depend on `grain` and never on the number of
+    threads, so an operation that combines its chunks in order gets the same
+    answer however many cores there are. */
+template <typename Function>
+void forChunks(size_t size, Function f);
+
+/** Compute f(begin, end) for each chunk and combine the results, in chunk
+    order, with `combine(result, chunkResult)`. */
+template <typename T, typename Function, typename Combine>
+T reduceChunks(size_t size, T init, Function f, Combine combine);
+
+/** Compute f(begin, end) for consecutive blocks of `block` items, and combine
+    the results pairwise with `combine(left, right)`, returning `empty` if
+    there are no items.
+
+    The tree of combinations only depends on `size` and `block` - not on
+    `grain`, the number of threads or whether the work runs in parallel at
+    all - so a floating point sum gives exactly the same answer every time,
+    and its rounding error grows like log(size) rather than size. */
+template <typename T, typename Function, typename Combine>
+T reducePairwise(size_t size, size_t block, T empty, Function f,
+                 Combine combine);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+inline Parallelism& parallelism() {
+    static Parallelism p;
+    return p;
+}
+
+template <typename Function>
+void forChunks(size_t size, Function f) {
+    auto& p = parallelism();
+    if (not p.isParallel(size)) {
+        f(size_t(0), size);
+        return;
+    }
+
+    auto grain = p.grain;
+    auto chunks = (size + grain - 1) / grain;
+    threadPool().run(chunks, [&](size_t chunk) {
+        auto begin = chunk * grain;
+        f(begin, std::min(size, begin + grain));
+    });
+}
+
+template <typename T, typename Function, typename Combine>
+T reduceChunks(size_t size, T init, Function f, Combine combine) {
+    auto& p = parallelism();
+    if (not p.isParallel(size)) {
+        combine(init, f(size_t(0), size));
+        return init;
+    }
+
+    auto grain = p.grain;
+    auto chunks = (size + grain - 1) / grain;
+    std::vector<T> results(chunks);
+    threadPool().run(chunks, [&](size_t chunk) {
+        auto begin = chunk * grain;
+        results[chunk] = f(begin, std::min(size, begin + grain));
+    });
+
+    for (auto& r: results)
+        combine(init, r);
+    return init;
+}
+
+namespace detail {
+
+/* Split [begin, end) after the largest power of two items that leaves some
+   over.  Any aligned run of a power of two items is then a subtree of its
+   own, which is what lets reducePairwise hand whole subtrees to threads. */
+template <typename T, typename Leaf, typename Combine>
+T pairwise(size_t begin, size_t end, Leaf& leaf, Combine& combine) {
+    if (end - begin == 1)
+        return leaf(begin);
+
+    size_t half = 1;
+    while (2 * half < end - begin)
+        half *= 2;
+
+    auto result = pairwise<T>(begin, begin + half, leaf, combine);
+    combine(result, pairwise<T>(begin + half, end, leaf, combine));
+    return result;
+}
+
+} // detail
+
+template <typename T, typename Function, typename Combine>
+T reducePairwise(size_t size, size_t block, T empty, Function f,
+                 Combine combine) {
+    auto blocks = (size + block - 1) / block;
+    if (not blocks)
+        return empty;
+
+    auto leaf = [&](size_t b) {
+        auto begin = b * block;
+        return f(begin, std::min(size, begin + block));
+    };
+
+    auto& p = parallelism();
+    if (not p.isParallel(size))
+        return detail::pairwise<T>(0, blocks, leaf, combine);
+
+    // Each task gets a power of two blocks, which is a subtree of the same
+    // tree that the serial reduction uses.
+    size_t perTask = 1;
+    while (perTask * block < p.grain)
+        perTask *= 2;
+
+    auto tasks = (blocks + perTask - 1) / perTask;
+    std::vector<T> results(tasks, empty);
+    threadPool().run(tasks, [&](size_t task) {
+        auto begin = task * perTask;
+        results[task] = detail::pairwise<T>(
+            begin, std::min(blocks, begin + perTask), leaf, combine);
+    });
+
+    auto result = [&](size_t task) { return results[task]; };
+    return detail::pairwise<T>(0, tasks, result, combine);
+}
+
+} // timedata
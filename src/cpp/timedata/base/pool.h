@@ -0,0 +1,149 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include <timedata/base/alignedAllocator.h>
+
+namespace timedata {
+
+/** A pool of recycled memory, sorted into power-of-two size classes.
+
+    Unlike a FrameArena, memory from a SizeClassPool is returned one piece at
+    a time by deallocate(), and goes onto a free list for its size class, so
+    it suits containers which live longer than one frame but are created and
+    destroyed over and over.  Once every size class in use has been seen, no
+    more memory is taken from the heap.
+
+    Requests larger than the largest size class go straight to the heap.
+
+    A pool belongs to one thread. */
+class SizeClassPool {
+  public:
+    /** The smallest size class is one cache line, 64 bytes. */
+    static const size_t MIN_SHIFT = 6;
+
+    /** The largest size class is 64 << 20 bytes, or 64 megabytes. */
+    static const size_t CLASSES = 21;
+
+    SizeClassPool() { heads_.fill(nullptr); }
+    ~SizeClassPool();
+
+    SizeClassPool(SizeClassPool const&) = delete;
+    SizeClassPool& operator=(SizeClassPool const&) = delete;
+
+    void* allocate(size_t bytes);
+    void deallocate(void*, size_t bytes);
+
+    /** The total size of the memory the pool has taken from the heap. */
+    size_t capacity() const { return capacity_; }
+
+  private:
+    static size_t sizeClass(size_t bytes);
+
+    struct Node {
+        Node* next;
+    };
+
+    std::array<Node*, CLASSES> heads_;
+    std::vector<void*> blocks_;
+    size_t capacity_ = 0;
+};
+
+/** This thread's size-classed pool. */
+SizeClassPool& sizeClassPool();
+
+/** A standard allocator that draws from a SizeClassPool - by default, the
+    calling thread's sizeClassPool(). */
+template <typename T>
+struct PoolAllocator {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    SizeClassPool* pool;
+
+    PoolAllocator() : pool(&sizeClassPool()) {}
+    PoolAllocator(SizeClassPool& p) : pool(&p) {}
+
+    template <typename U>
+    PoolAllocator(PoolAllocator<U> const& a) : pool(a.pool) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(pool->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+        pool->deallocate(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(PoolAllocator<U> const& a) const {
+        return pool == a.pool;
+    }
+
+    template <typename U>
+    bool operator!=(PoolAllocator<U> const& a) const {
+        return pool != a.pool;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+inline SizeClassPool::~SizeClassPool() {
+    for (auto b: blocks_)
+        alignedFree(b);
+}
+
+inline size_t SizeClassPool::sizeClass(size_t bytes) {
+    size_t c = 0;
+    while ((size_t(1) << (c + MIN_SHIFT)) < bytes)
+        ++c;
+    return c;
+}
+
+inline void* SizeClassPool::allocate(size_t bytes) {
+    auto c = sizeClass(bytes);
+    if (c >= CLASSES)
+        return alignedMalloc(bytes);
+
+    if (auto node = heads_[c]) {
+        heads_[c] = node->next;
+        return node;
+    }
+
+    auto size = size_t(1) << (c + MIN_SHIFT);
+    auto block = alignedMalloc(size);
+    blocks_.push_back(block);
+    capacity_ += size;
+    return block;
+}
+
+inline void SizeClassPool::deallocate(void* p, size_t bytes) {
+    if (not p)
+        return;
+
+    auto c = sizeClass(bytes);
+    if (c >= CLASSES) {
+        alignedFree(p);
+        return;
+    }
+
+    auto node = static_cast<Node*>(p);
+    node->next = heads_[c];
+    heads_[c] = node;
+}
+
+inline SizeClassPool& sizeClassPool() {
+    static thread_local SizeClassPool pool;
+    return pool;
+}
+
+} // timedata
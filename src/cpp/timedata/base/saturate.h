@@ -0,0 +1,316 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include <timedata/base/cpu.h>
+
+namespace timedata {
+
+/** Arithmetic that sticks at the ends of an unsigned integer type instead of
+    wrapping around.  For floating point types, these are the ordinary
+    operations. */
+template <typename T>
+T addSaturate(T x, T y);
+
+template <typename T>
+T subSaturate(T x, T y);
+
+template <typename T>
+T mulSaturate(T x, T y);
+
+/** Convert a float to T, sticking at the ends of an unsigned integer type;
+    NaN becomes zero. */
+template <typename T>
+T saturateCast(float x);
+
+namespace simd {
+
+/** Element-wise saturating operations over flat arrays of uint8_t or
+    uint16_t: `out[i] = op(x[i], y[i])`. */
+enum class Saturating { add, sub, mul, last = mul };
+
+void saturating(Saturating, uint8_t const* x, uint8_t const* y,
+                uint8_t* out, size_t size);
+void saturating(Saturating, uint16_t const* x, uint16_t const* y,
+                uint16_t* out, size_t size);
+
+/** The same, at a specific SimdLevel - useful for testing. */
+void saturating(SimdLevel, Saturating, uint8_t const* x, uint8_t const* y,
+                uint8_t* out, size_t size);
+void saturating(SimdLevel, Saturating, uint16_t const* x, uint16_t const* y,
+                uint16_t* out, size_t size);
+
+/** out[i] = op(x[i], y[i]) for two lists of Samples with integer storage,
+    resizing `out` to fit. */
+template <typename List>
+void saturating(Saturating, List const& x, List const& y, List& out);
+
+} // simd
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+template <typename T>
+T addSaturate(T x, T y, std::false_type) { return x + y; }
+
+template <typename T>
+T subSaturate(T x, T y, std::false_type) { return x - y; }
+
+template <typename T>
+T mulSaturate(T x, T y, std::false_type) { return x * y; }
+
+template <typename T>
+T addSaturate(T x, T y, std::true_type) {
+    return T(x + y) < x ? std::numeric_limits<T>::max() : T(x + y);
+}
+
+template <typename T>
+T subSaturate(T x, T y, std::true_type) {
+    return x > y ? T(x - y) : T(0);
+}
+
+template <typename T>
+T mulSaturate(T x, T y, std::true_type) {
+    auto p = uint64_t(x) * uint64_t(y);
+    return T(std::min(p, uint64_t(std::numeric_limits<T>::max())));
+}
+
+template <typename T>
+T saturateCast(float x, std::false_type) { return T(x); }
+
+template <typename T>
+T saturateCast(float x, std::true_type) {
+    auto max = std::numeric_limits<T>::max();
+    return x >= float(max) ? max : x > 0 ? T(x) : T(0);
+}
+
+template <typename T>
+using IsUnsignedInteger = std::integral_constant<bool,
+    std::is_integral<T>::value and std::is_unsigned<T>::value>;
+
+} // detail
+
+template <typename T>
+T addSaturate(T x, T y) {
+    return detail::addSaturate(x, y, detail::IsUnsignedInteger<T>());
+}
+
+template <typename T>
+T subSaturate(T x, T y) {
+    return detail::subSaturate(x, y, detail::IsUnsignedInteger<T>());
+}
+
+template <typename T>
+T mulSaturate(T x, T y) {
+    return detail::mulSaturate(x, y, detail::IsUnsignedInteger<T>());
+}
+
+template <typename T>
+T saturateCast(float x) {
+    return detail::saturateCast<T>(x, detail::IsUnsignedInteger<T>());
+}
+
+namespace simd {
+
+struct ScalarSaturate {
+    template <typename T>
+    static void apply(Saturating op, T const* x, T const* y, T* out,
+                      size_t n) {
+        switch (op) {
+            case Saturating::add:
+                for (size_t i = 0; i < n; ++i)
+                    out[i] = addSaturate(x[i], y[i]);
+                return;
+            case Saturating::sub:
+                for (size_t i = 0; i < n; ++i)
+                    out[i] = subSaturate(x[i], y[i]);
+                return;
+            case Saturating::mul:
+                for (size_t i = 0; i < n; ++i)
+                    out[i] = mulSaturate(x[i], y[i]);
+                return;
+        }
+    }
+};
+
+#if TIMEDATA_SIMD_X86
+
+/** SSE2 has paddusb, paddusw, psubusb and psubusw for add and subtract.
+    There's no saturating multiply, so we multiply in 16 bits and clamp. */
+struct Sse2Saturate {
+    using V = __m128i;
+    static const size_t WIDTH = sizeof(V);
+
+    TIMEDATA_TARGET("sse2")
+    static V apply(Saturating op, V x, V y, uint8_t) {
+        switch (op) {
+            case Saturating::add:  return _mm_adds_epu8(x, y);
+            case Saturating::sub:  return _mm_subs_epu8(x, y);
+            case Saturating::mul:  break;
+        }
+        auto zero = _mm_setzero_si128();
+        auto max = _mm_set1_epi16(0xFF);
+        auto lo = _mm_mullo_epi16(_mm_unpacklo_epi8(x, zero),
+                                  _mm_unpacklo_epi8(y, zero));
+        auto hi = _mm_mullo_epi16(_mm_unpackhi_epi8(x, zero),
+                                  _mm_unpackhi_epi8(y, zero));
+
+        // min(p, 255) == p - (p -sat 255), and then packus can't saturate.
+        lo = _mm_sub_epi16(lo, _mm_subs_epu16(lo, max));
+        hi = _mm_sub_epi16(hi, _mm_subs_epu16(hi, max));
+        return _mm_packus_epi16(lo, hi);
+    }
+
+    TIMEDATA_TARGET("sse2")
+    static V apply(Saturating op, V x, V y, uint16_t) {
+        switch (op) {
+            case Saturating::add:  return _mm_adds_epu16(x, y);
+            case Saturating::sub:  return _mm_subs_epu16(x, y);
+            case Saturating::mul:  break;
+        }
+        // The product fits if and only if its high half is zero.
+        auto lo = _mm_mullo_epi16(x, y);
+        auto hi = _mm_mulhi_epu16(x, y);
+        auto fits = _mm_cmpeq_epi16(hi, _mm_setzero_si128());
+        return _mm_or_si128(lo, _mm_andnot_si128(fits, _mm_set1_epi16(-1)));
+    }
+
+    template <typename T>
+    TIMEDATA_TARGET("sse2")
+    static void apply(Saturating op, T const* x, T const* y, T* out,
+                      size_t n) {
+        static const auto STEP = WIDTH / sizeof(T);
+        size_t i = 0;
+        for (; i + STEP <= n; i += STEP) {
+            auto vx = _mm_loadu_si128(reinterpret_cast<V const*>(x + i));
+            auto vy = _mm_loadu_si128(reinterpret_cast<V const*>(y + i));
+            _mm_storeu_si128(reinterpret_cast<V*>(out + i),
+                             apply(op, vx, vy, T()));
+        }
+        ScalarSaturate::apply(op, x + i, y + i, out + i, n - i);
+    }
+};
+
+/** The same as Sse2Saturate, but twice as wide.  Unpacking and packing work
+    within each 128-bit lane, so the bytes come back out in order. */
+struct Avx2Saturate {
+    using V = __m256i;
+    static const size_t WIDTH = sizeof(V);
+
+    TIMEDATA_TARGET("avx2")
+    static V apply(Saturating op, V x, V y, uint8_t) {
+        switch (op) {
+            case Saturating::add:  return _mm256_adds_epu8(x, y);
+            case Saturating::sub:  return _mm256_subs_epu8(x, y);
+            case Saturating::mul:  break;
+        }
+        auto zero = _mm256_setzero_si256();
+        auto max = _mm256_set1_epi16(0xFF);
+        auto lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(x, zero),
+                                     _mm256_unpacklo_epi8(y, zero));
+        auto hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(x, zero),
+                                     _mm256_unpackhi_epi8(y, zero));
+        lo = _mm256_min_epu16(lo, max);
+        hi = _mm256_min_epu16(hi, max);
+        return _mm256_packus_epi16(lo, hi);
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static V apply(Saturating op, V x, V y, uint16_t) {
+        switch (op) {
+            case Saturating::add:  return _mm256_adds_epu16(x, y);
+            case Saturating::sub:  return _mm256_subs_epu16(x, y);
+            case Saturating::mul:  break;
+        }
+        auto lo = _mm256_mullo_epi16(x, y);
+        auto hi = _mm256_mulhi_epu16(x, y);
+        auto fits = _mm256_cmpeq_epi16(hi, _mm256_setzero_si256());
+        return _mm256_or_si256(
+            lo, _mm256_andnot_si256(fits, _mm256_set1_epi16(-1)));
+    }
+
+    template <typename T>
+    TIMEDATA_TARGET("avx2")
+    static void apply(Saturating op, T const* x, T const* y, T* out,
+                      size_t n) {
+        static const auto STEP = WIDTH / sizeof(T);
+        size_t i = 0;
+        for (; i + STEP <= n; i += STEP) {
+            auto vx = _mm256_loadu_si256(reinterpret_cast<V const*>(x + i));
+            auto vy = _mm256_loadu_si256(reinterpret_cast<V const*>(y + i));
+            _mm256_storeu_si256(reinterpret_cast<V*>(out + i),
+                                apply(op, vx, vy, T()));
+        }
+        ScalarSaturate::apply(op, x + i, y + i, out + i, n - i);
+    }
+};
+
+#endif  // TIMEDATA_SIMD_X86
+
+template <typename T>
+void saturatingAt(SimdLevel level, Saturating op, T const* x, T const* y,
+                  T* out, size_t size) {
+#if TIMEDATA_SIMD_X86
+    // AVX-512 integer instructions need AVX512BW, which we don't detect.
+    switch (level) {
+        case SimdLevel::avx512:
+        case SimdLevel::avx2:
+            return Avx2Saturate::apply(op, x, y, out, size);
+        case SimdLevel::sse2:
+            return Sse2Saturate::apply(op, x, y, out, size);
+        case SimdLevel::scalar:
+            break;
+    }
+#else
+    (void) level;
+#endif
+    ScalarSaturate::apply(op, x, y, out, size);
+}
+
+inline void saturating(SimdLevel level, Saturating op, uint8_t const* x,
+                       uint8_t const* y, uint8_t* out, size_t size) {
+    saturatingAt(level, op, x, y, out, size);
+}
+
+inline void saturating(SimdLevel level, Saturating op, uint16_t const* x,
+                       uint16_t const* y, uint16_t* out, size_t size) {
+    saturatingAt(level, op, x, y, out, size);
+}
+
+inline void saturating(Saturating op, uint8_t const* x, uint8_t const* y,
+                       uint8_t* out, size_t size) {
+    saturatingAt(simdLevel(), op, x, y, out, size);
+}
+
+inline void saturating(Saturating op, uint16_t const* x, uint16_t const* y,
+                       uint16_t* out, size_t size) {
+    saturatingAt(simdLevel(), op, x, y, out, size);
+}
+
+template <typename List>
+void saturating(Saturating op, List const& x, List const& y, List& out) {
+    using Sample = typename List::value_type;
+    using Number = typename Sample::number_type;
+    static_assert(sizeof(Sample) == Sample::SIZE * sizeof(Number),
+                  "Samples must be a flat array of numbers");
+
+    auto size = std::min(x.size(), y.size());
+    out.resize(size);
+    saturating(op,
+               reinterpret_cast<Number const*>(x.data()),
+               reinterpret_cast<Number const*>(y.data()),
+               reinterpret_cast<Number*>(out.data()),
+               size * Sample::SIZE);
+}
+
+} // simd
+} // timedata
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <vector>
+
+#include <timedata/base/enum.h>
+#include <timedata/base/saturate.h>
+#include <timedata/color/cython_list_inl.h>
+#include <timedata/color/models/rgb.h>
+#include <timedata/signal/convertList.h>
+
+namespace timedata {
+namespace simd {
+
+template <typename T>
+void testSaturatingKernels() {
+    // An odd size, so every level also runs its scalar tail.
+    static const size_t SIZE = 203;
+    auto max = std::numeric_limits<T>::max();
+    std::vector<T> x, y;
+    for (size_t i = 0; i < SIZE; ++i) {
+        x.push_back(T((i * 37) % (size_t(max) + 1)));
+        y.push_back(T(i % 5 ? (i * 101) % (size_t(max) + 1) : max - i));
+    }
+
+    forEach<Saturating>([&](Saturating op) {
+        std::vector<T> expected(SIZE);
+        saturating(SimdLevel::scalar, op, x.data(), y.data(),
+                   expected.data(), SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            auto p = op == Saturating::add ? long(x[i]) + long(y[i]) :
+                op == Saturating::sub ? long(x[i]) - long(y[i]) :
+                long(x[i]) * long(y[i]);
+            REQUIRE(long(expected[i]) == std::max(0L, std::min(long(max), p)));
+        }
+
+        forEach<SimdLevel>([&](SimdLevel level) {
+            if (level > cpuSimdLevel())
+                return;
+            std::vector<T> out(SIZE);
+            saturating(level, op, x.data(), y.data(), out.data(), SIZE);
+            REQUIRE(out == expected);
+        });
+    });
+}
+
+TEST_CASE("saturating kernels", "saturate") {
+    testSaturatingKernels<uint8_t>();
+    testSaturatingKernels<uint16_t>();
+}
+
+TEST_CASE("saturating lists", "saturate") {
+    ColorRGB8::List x(10, ColorRGB8(200, 10, 100)), out;
+    ColorRGB8::List y(10, ColorRGB8(100, 20, 2));
+    saturating(Saturating::add, x, y, out);
+    REQUIRE(out[9] == ColorRGB8(255, 30, 102));
+    saturating(Saturating::sub, x, y, out);
+    REQUIRE(out[0] == ColorRGB8(100, 0, 98));
+    saturating(Saturating::mul, x, y, out);
+    REQUIRE(out[5] == ColorRGB8(255, 200, 200));
+}
+
+} // simd
+
+TEST_CASE("integer samples", "saturate") {
+    REQUIRE(sizeof(ColorRGB8) == 3);
+    REQUIRE(sizeof(ColorRGB16) == 6);
+
+    Ranged<Range255<uint8_t>> x(250), y(10);
+    REQUIRE(*(x + y) == 255);
+    REQUIRE(*(y - x) == 0);
+    REQUIRE(*(x * y) == 255);
+    x -= y;
+    REQUIRE(*x == 240);
+    REQUIRE(x.unscale() == 240 / 255.0f);
+    REQUIRE(*Ranged<Range255<uint8_t>>::scale(2.0f) == 255);
+    REQUIRE(*Ranged<Range255<uint8_t>>::scale(-1.0f) == 0);
+
+    // List arithmetic sticks at 0 and 255, whichever path it takes.  37
+    // samples run the vector kernels and their scalar tails.
+    using namespace color_list;
+    using Bytes = ColorRGB8::List;
+    ColorRGB8 const low(2, 200, 255), high(100, 100, 0);
+    Bytes lows(37, low), highs(37, high), out;
+    auto all = [&](ColorRGB8 expected) {
+        REQUIRE(out.size() == 37);
+        for (auto& c: out)
+            REQUIRE(c == expected);
+    };
+
+    math_add(lows, highs, out);
+    all({102, 255, 255});
+    math_sub(highs, lows, out);
+    all({0, 100, 255});
+    math_sub(lows, highs, out);
+    all({98, 0, 0});
+    math_rsub(lows, highs, out);
+    all({0, 100, 255});
+    math_mul(lows, highs, out);
+    all({255, 255, 0});
+
+    math_sub(lows, high, out);
+    all({98, 0, 0});
+    math_rsub(lows, high, out);
+    all({0, 100, 255});
+    math_mul(lows, high, out);
+    all({200, 255, 0});
+    math_sub(lows, uint8_t(1), out);
+    all({0, 0, 0});
+    math_mul(lows, uint8_t(2), out);
+    all({4, 255, 255});
+    math_pow(lows, uint8_t(2), out);
+    all({4, 255, 255});
+    math_div(lows, uint8_t(0), out);
+    all({255, 255, 255});
+    math_neg(lows, out);
+    all({0, 0, 0});
+
+    REQUIRE(min_cpp(Bytes{low, high}) == ColorRGB8(2, 100, 0));
+    REQUIRE(max_cpp(Bytes{low, high}) == ColorRGB8(100, 200, 255));
+    REQUIRE(compare(lows, highs) < 0);
+    REQUIRE(distance2(Bytes{low}, Bytes{high}) ==
+            98 * 98 + 100 * 100 + 255 * 255);
+}
+
+TEST_CASE("integer samples convert losslessly", "saturate") {
+    using namespace converter;
+
+    ColorRGB8::List bytes, bytes2;
+    for (auto i = 0; i < 256; ++i)
+        bytes.emplace_back(i, 255 - i, i / 2);
+
+    ColorRGB::List normal;
+    convertList(bytes, normal);
+    REQUIRE(*normal[255][0] == 1.0f);
+    convertList(normal, bytes2);
+    REQUIRE(bytes2 == bytes);
+
+    ColorRGB255::List floats;
+    convertList(bytes, floats);
+    for (auto i = 0; i < 256; ++i)
+        REQUIRE(*floats[i][0] == float(i));
+
+    ColorRGB16::List shorts;
+    ColorRGB8 color;
+    convertList(bytes, shorts);
+    REQUIRE(*shorts[1][0] == 257);
+    convertSample(shorts[128], color);
+    REQUIRE(color == bytes[128]);
+}
+
+} // timedata
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+
+#include <timedata/base/cpu.h>
+
+namespace timedata {
+namespace simd {
+
+/** Element-wise binary operations over flat arrays of float.
+
+    Each operation computes `out[i] = op(x[i], y[i])` with exactly the
+    semantics of the lambdas in the math_* functions of cython_list_inl.h,
+    where `x` is the second argument and `y` the list being operated on:
+
+        add       x + y
+        sub       x - y
+        rsub      y - x
+        mul       x * y
+        div       divPython(y, x)
+        rdiv      divPython(x, y)
+        minLimit  std::max(x, y)
+        maxLimit  std::min(x, y)
+*/
+enum class Binary {
+    add, sub, rsub, mul, div, rdiv, minLimit, maxLimit, last = maxLimit
+};
+
+/** Element-wise unary operations over flat arrays of float. */
+enum class Unary { abs, neg, floor, ceil, trunc, last = trunc };
+
+using BinaryKernel = void (*)(
+    Binary, float const* x, float const* y, float* out, size_t size);
+
+using BroadcastKernel = void (*)(
+    Binary, float x, float const* y, float* out, size_t size);
+
+using UnaryKernel = void (*)(Unary, float const* in, float* out, size_t size);
+
+/** A table of kernels for one SimdLevel. */
+struct Kernels {
+    BinaryKernel binary;
+    BroadcastKernel broadcast;
+    UnaryKernel unary;
+};
+
+/** The kernels for a specific level - useful for testing.  Levels the
+    compiler can't generate code for fall back to the scalar kernels. */
+Kernels const& kernels(SimdLevel);
+
+/** The kernels for the current simdLevel(). */
+Kernels const& kernels();
+
+/** out[i] = op(x[i], y[i]) */
+void binary(Binary, float const* x, float const* y, float* out, size_t size);
+
+/** out[i] = op(x, y[i]) */
+void broadcast(Binary, float x, float const* y, float* out, size_t size);
+
+/** out[i] = op(x[i % period], y[i]) - for example, one Sample applied to
+    every Sample in an interleaved list. */
+void periodic(Binary, float const* x, size_t period,
+              float const* y, float* out, size_t size);
+
+/** out[i] = op(in[i]) */
+void unary(Unary, float const* in, float* out, size_t size);
+
+} // simd
+} // timedata
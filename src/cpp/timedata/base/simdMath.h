@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <timedata/base/cpu.h>
+
+namespace timedata {
+namespace simd {
+
+#if TIMEDATA_SIMD_X86
+
+/** Transcendental functions on eight floats at a time, for kernels that
+    would otherwise call std::pow or std::cbrt once per number.
+
+    These are polynomial approximations, good to within a few units in the
+    last place for the arguments that color conversions give them - they
+    don't handle infinities, NaNs or denormals the way <cmath> does. */
+struct Avx2Math {
+    using V = __m256;
+
+    TIMEDATA_TARGET("avx2")
+    static V set(float x) { return _mm256_set1_ps(x); }
+
+    TIMEDATA_TARGET("avx2")
+    static V select(V mask, V yes, V no) {
+        return _mm256_blendv_ps(no, yes, mask);
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static V abs(V x) { return _mm256_andnot_ps(set(-0.0f), x); }
+
+    /** Evaluate c[0] + c[1] x + ... + c[n - 1] x^(n - 1). */
+    template <size_t N>
+    TIMEDATA_TARGET("avx2")
+    static V polynomial(V x, float const (&c)[N]) {
+        auto r = set(c[N - 1]);
+        for (size_t i = N - 1; i > 0; --i)
+            r = _mm256_add_ps(_mm256_mul_ps(r, x), set(c[i - 1]));
+        return r;
+    }
+
+    /** Base 2 logarithm of a positive number. */
+    TIMEDATA_TARGET("avx2")
+    static V log2(V x) {
+        // x = 2^e * m, with m between sqrt(1/2) and sqrt(2).
+        auto bits = _mm256_castps_si256(x);
+        auto e = _mm256_sub_epi32(_mm256_srli_epi32(bits, 23),
+                                  _mm256_set1_epi32(127));
+        auto m = _mm256_castsi256_ps(_mm256_or_si256(
+            _mm256_and_si256(bits, _mm256_set1_epi32(0x7FFFFF)),
+            _mm256_set1_epi32(0x3F800000)));
+        auto big = _mm256_cmp_ps(m, set(1.41421356f), _CMP_GT_OQ);
+        m = select(big, _mm256_mul_ps(m, set(0.5f)), m);
+        auto exponent = _mm256_add_ps(_mm256_cvtepi32_ps(e),
+                                      _mm256_and_ps(big, set(1.0f)));
+
+        // ln(m) = 2 atanh(t) = 2 (t + t^3 / 3 + t^5 / 5 + ...)
+        static const float ATANH[] = {
+            2.0f, 2.0f / 3.0f, 2.0f / 5.0f, 2.0f / 7.0f, 2.0f / 9.0f};
+        auto t = _mm256_div_ps(_mm256_sub_ps(m, set(1.0f)),
+                               _mm256_add_ps(m, set(1.0f)));
+        auto ln = _mm256_mul_ps(t, polynomial(_mm256_mul_ps(t, t), ATANH));
+        return _mm256_add_ps(exponent, _mm256_mul_ps(ln, set(1.44269504f)));
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static V exp2(V x) {
+        x = _mm256_min_ps(_mm256_max_ps(x, set(-126.0f)), set(127.0f));
+        auto n = _mm256_round_ps(
+            x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        auto g = _mm256_mul_ps(_mm256_sub_ps(x, n), set(0.693147181f));
+
+        static const float EXP[] = {
+            1.0f, 1.0f, 1.0f / 2, 1.0f / 6, 1.0f / 24, 1.0f / 120,
+            1.0f / 720, 1.0f / 5040};
+        auto scale = _mm256_slli_epi32(
+            _mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)),
+            23);
+        return _mm256_mul_ps(polynomial(g, EXP), _mm256_castsi256_ps(scale));
+    }
+
+    /** x to the power p, for positive x. */
+    TIMEDATA_TARGET("avx2")
+    static V pow(V x, float p) {
+        return exp2(_mm256_mul_ps(log2(x), set(p)));
+    }
+
+    /** Cube root, of any sign. */
+    TIMEDATA_TARGET("avx2")
+    static V cbrt(V x) {
+        auto sign = _mm256_and_ps(x, set(-0.0f));
+        auto a = abs(x);
+
+        // Dividing the exponent by three gets within a few percent, and each
+        // step of Newton's method then squares the error.
+        auto bits = _mm256_cvtepi32_ps(_mm256_castps_si256(a));
+        auto guess = _mm256_add_epi32(
+            _mm256_cvttps_epi32(_mm256_mul_ps(bits, set(1.0f / 3.0f))),
+            _mm256_set1_epi32(709921077));
+        auto y = _mm256_castsi256_ps(guess);
+        for (auto i = 0; i < 3; ++i) {
+            auto q = _mm256_div_ps(a, _mm256_mul_ps(y, y));
+            y = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(y, y), q),
+                              set(1.0f / 3.0f));
+        }
+        auto zero = _mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_EQ_OQ);
+        return _mm256_or_ps(_mm256_andnot_ps(zero, y), sign);
+    }
+
+    /** The angle of (x, y) as a fraction of a turn, from 0 up to 1. */
+    TIMEDATA_TARGET("avx2")
+    static V atan2Turns(V y, V x) {
+        static const float PI = 3.14159265f;
+        auto zero = _mm256_setzero_ps();
+        auto ax = abs(x), ay = abs(y);
+        auto a = _mm256_div_ps(_mm256_min_ps(ax, ay), _mm256_max_ps(ax, ay));
+        a = _mm256_andnot_ps(_mm256_cmp_ps(a, a, _CMP_UNORD_Q), a);
+
+        // Reduce to |z| <= tan(pi / 8), where the series converges quickly.
+        auto big = _mm256_cmp_ps(a, set(0.414213562f), _CMP_GT_OQ);
+        auto z = select(big, _mm256_div_ps(_mm256_sub_ps(a, set(1.0f)),
+                                           _mm256_add_ps(a, set(1.0f))), a);
+        static const float ATAN[] = {
+            1.0f, -1.0f / 3, 1.0f / 5, -1.0f / 7, 1.0f / 9, -1.0f / 11,
+            1.0f / 13, -1.0f / 15};
+        auto r = _mm256_mul_ps(z, polynomial(_mm256_mul_ps(z, z), ATAN));
+        r = select(big, _mm256_add_ps(r, set(PI / 4)), r);
+
+        r = select(_mm256_cmp_ps(ay, ax, _CMP_GT_OQ),
+                   _mm256_sub_ps(set(PI / 2), r), r);
+        r = select(_mm256_cmp_ps(x, zero, _CMP_LT_OQ),
+                   _mm256_sub_ps(set(PI), r), r);
+        r = select(_mm256_cmp_ps(y, zero, _CMP_LT_OQ),
+                   _mm256_sub_ps(set(2 * PI), r), r);
+        return _mm256_mul_ps(r, set(0.5f / PI));
+    }
+
+    /** The sine and cosine of an angle given as a fraction of a turn. */
+    TIMEDATA_TARGET("avx2")
+    static void sinCosTurns(V turns, V& sin, V& cos) {
+        // Reduce to a quarter turn either side of zero, where
+        // sin(x) == sin(pi - x) and cos(x) == -cos(pi - x).
+        auto t = _mm256_sub_ps(turns, _mm256_round_ps(
+            turns, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+        auto high = _mm256_cmp_ps(t, set(0.25f), _CMP_GT_OQ);
+        auto low = _mm256_cmp_ps(t, set(-0.25f), _CMP_LT_OQ);
+        t = select(high, _mm256_sub_ps(set(0.5f), t), t);
+        t = select(low, _mm256_sub_ps(set(-0.5f), t), t);
+        auto flip = _mm256_and_ps(_mm256_or_ps(high, low), set(-0.0f));
+
+        static const float SIN[] = {
+            1.0f, -1.0f / 6, 1.0f / 120, -1.0f / 5040, 1.0f / 362880,
+            -1.0f / 39916800};
+        static const float COS[] = {
+            1.0f, -1.0f / 2, 1.0f / 24, -1.0f / 720, 1.0f / 40320,
+            -1.0f / 3628800, 1.0f / 479001600};
+        auto x = _mm256_mul_ps(t, set(6.28318531f));
+        auto x2 = _mm256_mul_ps(x, x);
+        sin = _mm256_mul_ps(x, polynomial(x2, SIN));
+        cos = _mm256_xor_ps(polynomial(x2, COS), flip);
+    }
+
+    /** Load eight interleaved triples of floats as three vectors.
+
+        Each 128-bit half of the three loads holds four whole triples, so the
+        transpose is done with in-lane shuffles rather than gathers. */
+    TIMEDATA_TARGET("avx2")
+    static void load3(float const* p, V& x, V& y, V& z) {
+        // Triples 0-3 in the low lanes and 4-7 in the high lanes:
+        // m03 = x0 y0 z0 x1, m14 = y1 z1 x2 y2, m25 = z2 x3 y3 z3.
+        auto m03 = _mm256_insertf128_ps(
+            _mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 12), 1);
+        auto m14 = _mm256_insertf128_ps(
+            _mm256_castps128_ps256(_mm_loadu_ps(p + 4)),
+            _mm_loadu_ps(p + 16), 1);
+        auto m25 = _mm256_insertf128_ps(
+            _mm256_castps128_ps256(_mm_loadu_ps(p + 8)),
+            _mm_loadu_ps(p + 20), 1);
+
+        // xy = x2 y2 x3 y3, yz = y0 z0 y1 z1.
+        auto xy = _mm256_shuffle_ps(m14, m25, _MM_SHUFFLE(2, 1, 3, 2));
+        auto yz = _mm256_shuffle_ps(m03, m14, _MM_SHUFFLE(1, 0, 2, 1));
+        x = _mm256_shuffle_ps(m03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+        y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+        z = _mm256_shuffle_ps(yz, m25, _MM_SHUFFLE(3, 0, 3, 1));
+    }
+
+    /** Store three vectors as eight interleaved triples of floats - the
+        inverse of load3. */
+    TIMEDATA_TARGET("avx2")
+    static void store3(float* p, V x, V y, V z) {
+        // xy = x0 x2 y0 y2, yz = y1 y3 z1 z3, zx = z0 z2 x1 x3.
+        auto xy = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+        auto yz = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+        auto zx = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+        auto m03 = _mm256_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 2, 0));
+        auto m14 = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+        auto m25 = _mm256_shuffle_ps(zx, yz, _MM_SHUFFLE(3, 1, 3, 1));
+
+        _mm_storeu_ps(p, _mm256_castps256_ps128(m03));
+        _mm_storeu_ps(p + 4, _mm256_castps256_ps128(m14));
+        _mm_storeu_ps(p + 8, _mm256_castps256_ps128(m25));
+        _mm_storeu_ps(p + 12, _mm256_extractf128_ps(m03, 1));
+        _mm_storeu_ps(p + 16, _mm256_extractf128_ps(m14, 1));
+        _mm_storeu_ps(p + 20, _mm256_extractf128_ps(m25, 1));
+    }
+};
+
+#endif  // TIMEDATA_SIMD_X86
+
+} // simd
+} // timedata
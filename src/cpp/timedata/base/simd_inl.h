@@ -0,0 +1,444 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include <timedata/base/math_inl.h>
+#include <timedata/base/simd.h>
+
+namespace timedata {
+namespace simd {
+
+/** The scalar kernels are the reference implementation: every other level
+    must give identical results. */
+struct Scalar {
+    template <Binary OP>
+    static float apply(float x, float y) {
+        switch (OP) {
+            case Binary::add:       return x + y;
+            case Binary::sub:       return x - y;
+            case Binary::rsub:      return y - x;
+            case Binary::mul:       return x * y;
+            case Binary::div:       return divPython(y, x);
+            case Binary::rdiv:      return divPython(x, y);
+            case Binary::minLimit:  return std::max(x, y);
+            case Binary::maxLimit:  return std::min(x, y);
+        }
+        return 0;
+    }
+
+    template <Unary OP>
+    static float apply(float x) {
+        switch (OP) {
+            case Unary::abs:    return std::abs(x);
+            case Unary::neg:    return -x;
+            case Unary::floor:  return std::floor(x);
+            case Unary::ceil:   return std::ceil(x);
+            case Unary::trunc:  return std::trunc(x);
+        }
+        return 0;
+    }
+
+    template <Binary OP>
+    static void binary(float const* x, float const* y, float* out, size_t n) {
+        for (size_t i = 0; i < n; ++i)
+            out[i] = apply<OP>(x[i], y[i]);
+    }
+
+    template <Binary OP>
+    static void broadcast(float x, float const* y, float* out, size_t n) {
+        for (size_t i = 0; i < n; ++i)
+            out[i] = apply<OP>(x, y[i]);
+    }
+
+    template <Unary OP>
+    static void unary(float const* in, float* out, size_t n) {
+        for (size_t i = 0; i < n; ++i)
+            out[i] = apply<OP>(in[i]);
+    }
+};
+
+#if TIMEDATA_SIMD_X86
+
+struct Sse2 {
+    using V = __m128;
+    static const size_t WIDTH = 4;
+
+    TIMEDATA_TARGET("sse2")
+    static V divide(V a, V b) {
+        // divPython(a, 0) is a * infinity: +inf, -inf or nan.
+        auto zero = _mm_cmpeq_ps(b, _mm_setzero_ps());
+        auto inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+        auto byZero = _mm_mul_ps(a, inf);
+        return _mm_or_ps(_mm_and_ps(zero, byZero),
+                         _mm_andnot_ps(zero, _mm_div_ps(a, b)));
+    }
+
+    template <Binary OP>
+    TIMEDATA_TARGET("sse2")
+    static V apply(V x, V y) {
+        switch (OP) {
+            case Binary::add:       return _mm_add_ps(x, y);
+            case Binary::sub:       return _mm_sub_ps(x, y);
+            case Binary::rsub:      return _mm_sub_ps(y, x);
+            case Binary::mul:       return _mm_mul_ps(x, y);
+            case Binary::div:       return divide(y, x);
+            case Binary::rdiv:      return divide(x, y);
+            case Binary::minLimit:  return _mm_max_ps(y, x);
+            case Binary::maxLimit:  return _mm_min_ps(y, x);
+        }
+        return x;
+    }
+
+    template <Binary OP>
+    TIMEDATA_TARGET("sse2")
+    static void binary(float const* x, float const* y, float* out, size_t n) {
+        size_t i = 0;
+        for (; i + WIDTH <= n; i += WIDTH) {
+            auto r = apply<OP>(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i));
+            _mm_storeu_ps(out + i, r);
+        }
+        Scalar::binary<OP>(x + i, y + i, out + i, n - i);
+    }
+
+    template <Binary OP>
+    TIMEDATA_TARGET("sse2")
+    static void broadcast(float x, float const* y, float* out, size_t n) {
+        auto vx = _mm_set1_ps(x);
+        size_t i = 0;
+        for (; i + WIDTH <= n; i += WIDTH)
+            _mm_storeu_ps(out + i, apply<OP>(vx, _mm_loadu_ps(y + i)));
+        Scalar::broadcast<OP>(x, y + i, out + i, n - i);
+    }
+
+    template <Unary OP>
+    TIMEDATA_TARGET("sse2")
+    static void unary(float const* in, float* out, size_t n) {
+        // SSE2 has no rounding instructions.
+        if (OP != Unary::abs and OP != Unary::neg)
+            return Scalar::unary<OP>(in, out, n);
+
+        auto sign = _mm_set1_ps(-0.0f);
+        size_t i = 0;
+        for (; i + WIDTH <= n; i += WIDTH) {
+            auto v = _mm_loadu_ps(in + i);
+            v = (OP == Unary::abs) ? _mm_andnot_ps(sign, v) :
+                _mm_xor_ps(sign, v);
+            _mm_storeu_ps(out + i, v);
+        }
+        Scalar::unary<OP>(in + i, out + i, n - i);
+    }
+};
+
+struct Avx2 {
+    using V = __m256;
+    static const size_t WIDTH = 8;
+
+    TIMEDATA_TARGET("avx2")
+    static V divide(V a, V b) {
+        auto zero = _mm256_cmp_ps(b, _mm256_setzero_ps(), _CMP_EQ_OQ);
+        auto inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+        auto byZero = _mm256_mul_ps(a, inf);
+        return _mm256_blendv_ps(_mm256_div_ps(a, b), byZero, zero);
+    }
+
+    template <Binary OP>
+    TIMEDATA_TARGET("avx2")
+    static V apply(V x, V y) {
+        switch (OP) {
+            case Binary::add:       return _mm256_add_ps(x, y);
+            case Binary::sub:       return _mm256_sub_ps(x, y);
+            case Binary::rsub:      return _mm256_sub_ps(y, x);
+            case Binary::mul:       return _mm256_mul_ps(x, y);
+            case Binary::div:       return divide(y, x);
+            case Binary::rdiv:      return divide(x, y);
+            case Binary::minLimit:  return _mm256_max_ps(y, x);
+            case Binary::maxLimit:  return _mm256_min_ps(y, x);
+        }
+        return x;
+    }
+
+    template <Unary OP>
+    TIMEDATA_TARGET("avx2")
+    static V apply(V x) {
+        auto sign = _mm256_set1_ps(-0.0f);
+        switch (OP) {
+            case Unary::abs:    return _mm256_andnot_ps(sign, x);
+            case Unary::neg:    return _mm256_xor_ps(sign, x);
+            case Unary::floor:  return _mm256_floor_ps(x);
+            case Unary::ceil:   return _mm256_ceil_ps(x);
+            case Unary::trunc:
+                return _mm256_round_ps(
+                    x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        }
+        return x;
+    }
+
+    template <Binary OP>
+    TIMEDATA_TARGET("avx2")
+    static void binary(float const* x, float const* y, float* out, size_t n) {
+        size_t i = 0;
+        for (; i + WIDTH <= n; i += WIDTH) {
+            auto r = apply<OP>(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i));
+            _mm256_storeu_ps(out + i, r);
+        }
+        Scalar::binary<OP>(x + i, y + i, out + i, n - i);
+    }
+
+    template <Binary OP>
+    TIMEDATA_TARGET("avx2")
+    static void broadcast(float x, float const* y, float* out, size_t n) {
+        auto vx = _mm256_set1_ps(x);
+        size_t i = 0;
+        for (; i + WIDTH <= n; i += WIDTH)
+            _mm256_storeu_ps(out + i, apply<OP>(vx, _mm256_loadu_ps(y + i)));
+        Scalar::broadcast<OP>(x, y + i, out + i, n - i);
+    }
+
+    template <Unary OP>
+    TIMEDATA_TARGET("avx2")
+    static void unary(float const* in, float* out, size_t n) {
+        size_t i = 0;
+        for (; i + WIDTH <= n; i += WIDTH)
+            _mm256_storeu_ps(out + i, apply<OP>(_mm256_loadu_ps(in + i)));
+        Scalar::unary<OP>(in + i, out + i, n - i);
+    }
+};
+
+struct Avx512 {
+    using V = __m512;
+    static const size_t WIDTH = 16;
+
+    /** GCC's unmasked forms of some AVX-512 intrinsics pass an undefined
+        vector through, which -O3 warns about, so we use the zero-masked
+        forms with every lane set. */
+    static const __mmask16 ALL = 0xFFFF;
+
+    TIMEDATA_TARGET("avx512f")
+    static __mmask16 tail(size_t n) {
+        return static_cast<__mmask16>((1u << n) - 1);
+    }
+
+    TIMEDATA_TARGET("avx512f")
+    static V divide(V a, V b) {
+        auto zero = _mm512_cmp_ps_mask(b, _mm512_setzero_ps(), _CMP_EQ_OQ);
+        auto inf = _mm512_set1_ps(std::numeric_limits<float>::infinity());
+        auto byZero = _mm512_mul_ps(a, inf);
+        return _mm512_mask_blend_ps(zero, _mm512_div_ps(a, b), byZero);
+    }
+
+    template <Binary OP>
+    TIMEDATA_TARGET("avx512f")
+    static V apply(V x, V y) {
+        switch (OP) {
+            case Binary::add:       return _mm512_add_ps(x, y);
+            case Binary::sub:       return _mm512_sub_ps(x, y);
+            case Binary::rsub:      return _mm512_sub_ps(y, x);
+            case Binary::mul:       return _mm512_mul_ps(x, y);
+            case Binary::div:       return divide(y, x);
+            case Binary::rdiv:      return divide(x, y);
+            case Binary::minLimit:  return _mm512_maskz_max_ps(ALL, y, x);
+            case Binary::maxLimit:  return _mm512_maskz_min_ps(ALL, y, x);
+        }
+        return x;
+    }
+
+    template <Unary OP>
+    TIMEDATA_TARGET("avx512f")
+    static V apply(V x) {
+        auto bits = _mm512_castps_si512(x);
+        auto sign = _mm512_set1_epi32(int32_t(0x80000000));
+        switch (OP) {
+            case Unary::abs:
+                return _mm512_castsi512_ps(
+                    _mm512_maskz_andnot_epi32(ALL, sign, bits));
+            case Unary::neg:
+                return _mm512_castsi512_ps(_mm512_xor_si512(sign, bits));
+            case Unary::floor:
+                return _mm512_maskz_roundscale_ps(
+                    ALL, x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+            case Unary::ceil:
+                return _mm512_maskz_roundscale_ps(
+                    ALL, x, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+            case Unary::trunc:
+                return _mm512_maskz_roundscale_ps(
+                    ALL, x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        }
+        return x;
+    }
+
+    template <Binary OP>
+    TIMEDATA_TARGET("avx512f")
+    static void binary(float const* x, float const* y, float* out, size_t n) {
+        size_t i = 0;
+        for (; i + WIDTH <= n; i += WIDTH) {
+            auto r = apply<OP>(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i));
+            _mm512_storeu_ps(out + i, r);
+        }
+        if (i < n) {
+            auto m = tail(n - i);
+            auto r = apply<OP>(_mm512_maskz_loadu_ps(m, x + i),
+                               _mm512_maskz_loadu_ps(m, y + i));
+            _mm512_mask_storeu_ps(out + i, m, r);
+        }
+    }
+
+    template <Binary OP>
+    TIMEDATA_TARGET("avx512f")
+    static void broadcast(float x, float const* y, float* out, size_t n) {
+        auto vx = _mm512_set1_ps(x);
+        size_t i = 0;
+        for (; i + WIDTH <= n; i += WIDTH)
+            _mm512_storeu_ps(out + i, apply<OP>(vx, _mm512_loadu_ps(y + i)));
+        if (i < n) {
+            auto m = tail(n - i);
+            auto r = apply<OP>(vx, _mm512_maskz_loadu_ps(m, y + i));
+            _mm512_mask_storeu_ps(out + i, m, r);
+        }
+    }
+
+    template <Unary OP>
+    TIMEDATA_TARGET("avx512f")
+    static void unary(float const* in, float* out, size_t n) {
+        size_t i = 0;
+        for (; i + WIDTH <= n; i += WIDTH)
+            _mm512_storeu_ps(out + i, apply<OP>(_mm512_loadu_ps(in + i)));
+        if (i < n) {
+            auto m = tail(n - i);
+            auto r = apply<OP>(_mm512_maskz_loadu_ps(m, in + i));
+            _mm512_mask_storeu_ps(out + i, m, r);
+        }
+    }
+};
+
+#endif  // TIMEDATA_SIMD_X86
+
+/** Turn the runtime operation into a compile-time one, once per call. */
+template <typename Level>
+struct Dispatch {
+    static void binary(Binary op, float const* x, float const* y,
+                       float* out, size_t n) {
+        switch (op) {
+            case Binary::add:
+                return Level::template binary<Binary::add>(x, y, out, n);
+            case Binary::sub:
+                return Level::template binary<Binary::sub>(x, y, out, n);
+            case Binary::rsub:
+                return Level::template binary<Binary::rsub>(x, y, out, n);
+            case Binary::mul:
+                return Level::template binary<Binary::mul>(x, y, out, n);
+            case Binary::div:
+                return Level::template binary<Binary::div>(x, y, out, n);
+            case Binary::rdiv:
+                return Level::template binary<Binary::rdiv>(x, y, out, n);
+            case Binary::minLimit:
+                return Level::template binary<Binary::minLimit>(x, y, out, n);
+            case Binary::maxLimit:
+                return Level::template binary<Binary::maxLimit>(x, y, out, n);
+        }
+    }
+
+    static void broadcast(Binary op, float x, float const* y,
+                          float* out, size_t n) {
+        switch (op) {
+            case Binary::add:
+                return Level::template broadcast<Binary::add>(x, y, out, n);
+            case Binary::sub:
+                return Level::template broadcast<Binary::sub>(x, y, out, n);
+            case Binary::rsub:
+                return Level::template broadcast<Binary::rsub>(x, y, out, n);
+            case Binary::mul:
+                return Level::template broadcast<Binary::mul>(x, y, out, n);
+            case Binary::div:
+                return Level::template broadcast<Binary::div>(x, y, out, n);
+            case Binary::rdiv:
+                return Level::template broadcast<Binary::rdiv>(x, y, out, n);
+            case Binary::minLimit:
+                return Level::template broadcast<Binary::minLimit>(
+                    x, y, out, n);
+            case Binary::maxLimit:
+                return Level::template broadcast<Binary::maxLimit>(
+                    x, y, out, n);
+        }
+    }
+
+    static void unary(Unary op, float const* in, float* out, size_t n) {
+        switch (op) {
+            case Unary::abs:
+                return Level::template unary<Unary::abs>(in, out, n);
+            case Unary::neg:
+                return Level::template unary<Unary::neg>(in, out, n);
+            case Unary::floor:
+                return Level::template unary<Unary::floor>(in, out, n);
+            case Unary::ceil:
+                return Level::template unary<Unary::ceil>(in, out, n);
+            case Unary::trunc:
+                return Level::template unary<Unary::trunc>(in, out, n);
+        }
+    }
+
+    static Kernels const& kernels() {
+        static const Kernels k = {&binary, &broadcast, &unary};
+        return k;
+    }
+};
+
+inline Kernels const& kernels(SimdLevel level) {
+#if TIMEDATA_SIMD_X86
+    switch (level) {
+        case SimdLevel::avx512:  return Dispatch<Avx512>::kernels();
+        case SimdLevel::avx2:    return Dispatch<Avx2>::kernels();
+        case SimdLevel::sse2:    return Dispatch<Sse2>::kernels();
+        case SimdLevel::scalar:  break;
+    }
+#else
+    (void) level;
+#endif
+    return Dispatch<Scalar>::kernels();
+}
+
+inline Kernels const& kernels() {
+    return kernels(simdLevel());
+}
+
+inline void binary(Binary op, float const* x, float const* y,
+                   float* out, size_t size) {
+    kernels().binary(op, x, y, out, size);
+}
+
+inline void broadcast(Binary op, float x, float const* y,
+                      float* out, size_t size) {
+    kernels().broadcast(op, x, y, out, size);
+}
+
+inline void periodic(Binary op, float const* x, size_t period,
+                     float const* y, float* out, size_t size) {
+    // Repeat the pattern to a multiple of every vector width we use, then
+    // apply it one block at a time.
+    static const size_t MAX_PERIOD = 8, REPEATS = 16;
+    if (period > MAX_PERIOD) {
+        for (size_t i = 0; i < size; i += period) {
+            auto n = std::min(period, size - i);
+            binary(op, x, y + i, out + i, n);
+        }
+        return;
+    }
+
+    float pattern[MAX_PERIOD * REPEATS];
+    auto block = period * REPEATS;
+    for (size_t i = 0; i < block; ++i)
+        pattern[i] = x[i % period];
+
+    auto& k = kernels();
+    for (size_t i = 0; i < size; i += block)
+        k.binary(op, pattern, y + i, out + i, std::min(block, size - i));
+}
+
+inline void unary(Unary op, float const* in, float* out, size_t size) {
+    kernels().unary(op, in, out, size);
+}
+
+} // simd
+} // timedata
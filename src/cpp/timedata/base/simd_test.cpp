@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstring>
+#include <vector>
+
+#include <timedata/base/enum.h>
+#include <timedata/base/simdMath.h>
+#include <timedata/base/simd_inl.h>
+
+namespace timedata {
+namespace simd {
+
+inline std::vector<float> simdTestData(size_t size, size_t seed) {
+    static const float SPECIAL[] = {
+        0.0f, -0.0f, 1.0f, -1.0f, 0.5f, -2.5f, 1e30f, -1e-30f,
+        std::numeric_limits<float>::infinity(), 3.75f, -0.25f};
+    static const auto SPECIALS = sizeof(SPECIAL) / sizeof(SPECIAL[0]);
+
+    std::vector<float> result;
+    for (size_t i = 0; i < size; ++i) {
+        auto j = i * 7 + seed * 13;
+        if (j % 3)
+            result.push_back(((j * 37) % 201) / 16.0f - 6.0f);
+        else
+            result.push_back(SPECIAL[j % SPECIALS]);
+    }
+    return result;
+}
+
+/** Results must be bit-identical - except for NaNs, whose sign and payload
+    vary between instruction sets.  -ffast-math lets the compiler rewrite the
+    scalar arithmetic, so there we only ask for nearly identical results. */
+inline bool simdIdentical(std::vector<float> const& x,
+                          std::vector<float> const& y) {
+    if (x.size() != y.size())
+        return false;
+    for (size_t i = 0; i < x.size(); ++i) {
+        if (std::isnan(x[i]) and std::isnan(y[i]))
+            continue;
+#ifdef __FAST_MATH__
+        if (x[i] == y[i] or std::abs(x[i] - y[i]) <= 1e-6f * std::abs(x[i]))
+            continue;
+#endif
+        if (std::memcmp(&x[i], &y[i], sizeof(float)))
+            return false;
+    }
+    return true;
+}
+
+TEST_CASE("simd kernels match scalar", "simd") {
+    auto& scalar = kernels(SimdLevel::scalar);
+
+    for (size_t size: {0, 1, 3, 4, 7, 8, 15, 16, 17, 33, 100}) {
+        auto x = simdTestData(size, 1), y = simdTestData(size, 2);
+        std::vector<float> expected(size), actual(size);
+
+        forEach<SimdLevel>([&](SimdLevel level) {
+            if (level > cpuSimdLevel())
+                return;
+            auto& k = kernels(level);
+
+            forEach<Binary>([&](Binary op) {
+                scalar.binary(op, x.data(), y.data(), expected.data(), size);
+                k.binary(op, x.data(), y.data(), actual.data(), size);
+                REQUIRE(simdIdentical(expected, actual));
+
+                for (auto b: {0.0f, -1.5f, 2.0f}) {
+                    scalar.broadcast(op, b, y.data(), expected.data(), size);
+                    k.broadcast(op, b, y.data(), actual.data(), size);
+                    REQUIRE(simdIdentical(expected, actual));
+                }
+            });
+
+            forEach<Unary>([&](Unary op) {
+                scalar.unary(op, x.data(), expected.data(), size);
+                k.unary(op, x.data(), actual.data(), size);
+                REQUIRE(simdIdentical(expected, actual));
+            });
+        });
+    }
+}
+
+TEST_CASE("simd periodic", "simd") {
+    float pattern[] = {1.0f, 2.0f, 3.0f};
+    auto y = simdTestData(100, 3);
+    std::vector<float> out(y.size());
+
+    periodic(Binary::mul, pattern, 3, y.data(), out.data(), y.size());
+    for (size_t i = 0; i < y.size(); ++i)
+        REQUIRE(out[i] == pattern[i % 3] * y[i]);
+}
+
+#if TIMEDATA_SIMD_X86
+
+namespace simd_math {
+
+/** Split 24 interleaved floats into x, y and z, then interleave them again
+    into `out`. */
+TIMEDATA_TARGET("avx2")
+inline void transposeTriples(float const* in, float* xyz, float* out) {
+    __m256 x, y, z;
+    Avx2Math::load3(in, x, y, z);
+    _mm256_storeu_ps(xyz, x);
+    _mm256_storeu_ps(xyz + 8, y);
+    _mm256_storeu_ps(xyz + 16, z);
+    Avx2Math::store3(out, x, y, z);
+}
+
+TEST_CASE("simd triples", "simd") {
+    if (cpuSimdLevel() < SimdLevel::avx2)
+        return;
+
+    auto in = simdTestData(24, 4);
+    std::vector<float> xyz(24), out(24);
+    transposeTriples(in.data(), xyz.data(), out.data());
+    for (size_t i = 0; i < 8; ++i) {
+        for (size_t c = 0; c < 3; ++c)
+            REQUIRE(simdIdentical({in[3 * i + c]}, {xyz[8 * c + i]}));
+    }
+    REQUIRE(simdIdentical(in, out));
+}
+
+} // simd_math
+
+#endif  // TIMEDATA_SIMD_X86
+
+} // simd
+} // timedata
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace timedata {
+
+/** A persistent pool of worker threads that runs one parallel job at a time.
+
+    A job is a number of independent tasks, numbered from 0.  The calling
+    thread works on the job too, and `run` doesn't return until every task is
+    finished - so a task can safely refer to anything on the caller's stack.
+
+    Calling `run` from inside a task runs the inner job on the calling thread,
+    so nesting can't deadlock.  Tasks must not throw.
+*/
+class ThreadPool {
+  public:
+    using Task = std::function<void(size_t task)>;
+
+    /** `workers` is the number of threads in addition to the caller. */
+    explicit ThreadPool(size_t workers = defaultWorkers());
+    ~ThreadPool();
+
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    /** Run tasks 0 through `tasks - 1`, returning when all are done. */
+    void run(size_t tasks, Task const&);
+
+    /** The number of threads that work on a job, including the caller. */
+    size_t threads() const { return workers_.size() + 1; }
+
+    static size_t defaultWorkers();
+
+  private:
+    struct Job {
+        Task const* task;
+        size_t tasks;
+        std::atomic<size_t> next;
+    };
+
+    static void work(Job&);
+    static bool& insideTask();
+    void loop();
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_, runMutex_;
+    std::condition_variable wake_, idle_;
+    Job* job_ = nullptr;
+    size_t generation_ = 0, active_ = 0;
+    bool stopping_ = false;
+};
+
+/** The shared pool, created on first use. */
+ThreadPool& threadPool();
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+inline ThreadPool::ThreadPool(size_t workers) {
+    for (size_t i = 0; i < workers; ++i)
+        workers_.emplace_back([this]() { loop(); });
+}
+
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& w: workers_)
+        w.join();
+}
+
+inline size_t ThreadPool::defaultWorkers() {
+    auto cores = std::thread::hardware_concurrency();
+    return cores > 1 ? cores - 1 : 0;
+}
+
+inline bool& ThreadPool::insideTask() {
+    static thread_local bool inside = false;
+    return inside;
+}
+
+inline void ThreadPool::work(Job& job) {
+    auto& inside = insideTask();
+    auto wasInside = inside;
+    inside = true;
+    for (size_t i; (i = job.next++) < job.tasks; )
+        (*job.task)(i);
+    inside = wasInside;
+}
+
+inline void ThreadPool::run(size_t tasks, Task const& task) {
+    if (tasks == 1 or workers_.empty() or insideTask()) {
+        for (size_t i = 0; i < tasks; ++i)
+            task(i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> runLock(runMutex_);
+    Job job;
+    job.task = &task;
+    job.tasks = tasks;
+    job.next = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &job;
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    work(job);
+
+    // Every task has been claimed: wait for the workers still running one.
+    std::unique_lock<std::mutex> lock(mutex_);
+    job_ = nullptr;
+    idle_.wait(lock, [this]() { return not active_; });
+}
+
+inline void ThreadPool::loop() {
+    size_t generation = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [&]() {
+            return stopping_ or (job_ and generation != generation_);
+        });
+        if (stopping_)
+            return;
+
+        generation = generation_;
+        auto& job = *job_;
+        ++active_;
+        lock.unlock();
+
+        work(job);
+
+        lock.lock();
+        if (not --active_)
+            idle_.notify_all();
+    }
+}
+
+inline ThreadPool& threadPool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+} // timedata
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include <timedata/base/parallel.h>
+#include <timedata/base/threadPool.h>
+#include <timedata/color/cython_list_inl.h>
+
+namespace timedata {
+
+TEST_CASE("threadPool runs each task once", "threadPool") {
+    ThreadPool pool(3);
+    REQUIRE(pool.threads() == 4);
+
+    for (size_t tasks: {0, 1, 2, 7, 100}) {
+        std::vector<std::atomic<int>> counts(tasks);
+        for (auto& c: counts)
+            c = 0;
+        pool.run(tasks, [&](size_t i) { ++counts[i]; });
+        for (auto& c: counts)
+            REQUIRE(c == 1);
+    }
+}
+
+TEST_CASE("threadPool nests", "threadPool") {
+    ThreadPool pool(2);
+    std::atomic<int> total(0);
+    pool.run(4, [&](size_t) {
+        pool.run(5, [&](size_t) { ++total; });
+    });
+    REQUIRE(total == 20);
+}
+
+TEST_CASE("parallel list operations", "threadPool") {
+    color_list::CColorListRGB x, y, serial, parallel;
+    for (size_t i = 0; i < 1000; ++i) {
+        x.push_back({i / 7.0f, 1.5f - i / 11.0f, (i % 5) - 2.5f});
+        y.push_back({(i % 13) + 0.5f, i / 3.0f, 2.0f});
+    }
+    color_list::math_mul(x, y, serial);
+    color_list::math_add(serial, 1.5f, serial);
+    auto min = color_list::min_cpp(serial);
+
+    auto saved = parallelism();
+    parallelism().threshold = 1;
+    parallelism().grain = 37;
+
+    color_list::math_mul(x, y, parallel);
+    color_list::math_add(parallel, 1.5f, parallel);
+    REQUIRE(parallel == serial);
+    REQUIRE(color_list::min_cpp(parallel) == min);
+
+    parallelism() = saved;
+}
+
+} // timedata
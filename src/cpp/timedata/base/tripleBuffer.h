@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include <timedata/base/alignedAllocator.h>
+
+namespace timedata {
+
+/** A wait-free exchange of frames between one producer thread and one
+    consumer thread.
+
+    There are three containers: the producer owns the back one, the consumer
+    owns the front one, and the middle one is up for grabs.  The producer
+    fills back() and calls publish(), which swaps back and middle.  The
+    consumer calls update(), which swaps middle and front if the middle
+    holds a frame it hasn't seen yet.  Each swap is a single atomic exchange,
+    so neither side ever waits for the other, and the consumer always gets
+    the latest complete frame - frames it's too slow for are just skipped.
+
+    Containers are swapped, never copied, so once all three have their
+    final size, a frame update allocates nothing.  Construct the TripleBuffer
+    from a frame of the right size to make sure of that.
+
+    Only one thread may call the producer methods, and only one thread may
+    call the consumer methods. */
+template <typename Container>
+class TripleBuffer {
+  public:
+    TripleBuffer() : middle_(MIDDLE) {}
+    explicit TripleBuffer(Container const& c)
+            : buffers_{{c, c, c}}, middle_(MIDDLE) {
+    }
+
+    TripleBuffer(TripleBuffer const&) = delete;
+    TripleBuffer& operator=(TripleBuffer const&) = delete;
+
+    /** Producer: the frame being written. */
+    Container& back() { return buffers_[back_]; }
+
+    /** Producer: publish back(), and get a new back() to write to.  The new
+        back() holds some older frame. */
+    void publish() {
+        auto fresh = static_cast<uint8_t>(back_ | FRESH);
+        back_ = middle_.exchange(fresh, std::memory_order_acq_rel)
+                & INDEX;
+    }
+
+    /** Consumer: move to the latest published frame, returning false if
+        there hasn't been one since the last update(). */
+    bool update() {
+        if (not (middle_.load(std::memory_order_acquire) & FRESH))
+            return false;
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+
+    /** Consumer: the current frame, which stays the same until update(). */
+    Container const& front() const { return buffers_[front_]; }
+
+  private:
+    static const uint8_t INDEX = 3, FRESH = 4, MIDDLE = 1;
+
+    // Each side's index gets a cache line to itself, so the producer and
+    // consumer don't contend for a line except in the atomic exchanges.
+    std::array<Container, 3> buffers_;
+    uint8_t back_ = 0;
+    char pad0_[CACHE_LINE];
+    std::atomic<uint8_t> middle_;
+    char pad1_[CACHE_LINE];
+    uint8_t front_ = 2;
+};
+
+} // timedata
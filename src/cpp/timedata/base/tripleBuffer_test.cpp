@@ -0,0 +1,70 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+
+#include <timedata/base/doubleBuffer.h>
+#include <timedata/base/tripleBuffer.h>
+
+namespace timedata {
+
+TEST_CASE("doubleBuffer", "buffer") {
+    DoubleBuffer<std::vector<int>> buffer;
+    REQUIRE(not buffer.recall());
+
+    buffer.in() = {1, 2, 3};
+    buffer.setDirty();
+    REQUIRE(buffer.out() == std::vector<int>({1, 2, 3}));
+    REQUIRE(not buffer.recall());
+
+    buffer.store({4, 5});
+    REQUIRE(buffer.out() == std::vector<int>({4, 5}));
+}
+
+TEST_CASE("tripleBuffer", "buffer") {
+    std::vector<int> frame(3);
+    TripleBuffer<std::vector<int>> buffer(frame);
+    REQUIRE(not buffer.update());
+
+    buffer.back()[0] = 1;
+    buffer.publish();
+    buffer.back()[0] = 2;
+    buffer.publish();
+
+    // The consumer skips straight to the latest frame.
+    REQUIRE(buffer.update());
+    REQUIRE(buffer.front()[0] == 2);
+    REQUIRE(not buffer.update());
+    REQUIRE(buffer.front()[0] == 2);
+}
+
+TEST_CASE("tripleBuffer threads", "buffer") {
+    static const int FRAMES = 20000;
+    std::vector<int> initial(64);
+    TripleBuffer<std::vector<int>> buffer(initial);
+
+    std::thread producer([&]() {
+        for (int frame = 1; frame <= FRAMES; ++frame) {
+            for (auto& x: buffer.back())
+                x = frame;
+            buffer.publish();
+        }
+    });
+
+    // Every frame seen must be complete, and frames never go backwards.
+    bool consistent = true;
+    int last = 0;
+    while (last < FRAMES) {
+        if (not buffer.update())
+            continue;
+        auto& front = buffer.front();
+        for (auto x: front)
+            consistent = consistent and x == front[0];
+        consistent = consistent and front[0] > last;
+        last = front[0];
+    }
+    producer.join();
+    REQUIRE(consistent);
+}
+
+} // timedata
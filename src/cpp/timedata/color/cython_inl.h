@@ -12,6 +12,9 @@
 #include <timedata/color/models/xyz.h>
 #include <timedata/color/models/yiq.h>
 #include <timedata/color/models/yuv.h>
+#include <timedata/color/models/lab.h>
+#include <timedata/color/models/oklab.h>
+#include <timedata/color/deltaE.h>
 #include <timedata/color/names_inl.h>
 
 namespace timedata {
@@ -25,6 +28,9 @@ using CColorHSL = ColorHSL;
 using CColorXYZ = ColorXYZ;
 using CColorYIQ = ColorYIQ;
 using CColorYUV = ColorYUV;
+using CColorLab = ColorLab;
+using CColorLCh = ColorLCh;
+using CColorOklab = ColorOklab;
 
 using CColorRGB256 = ColorRGB256;
 using CColorRGB255 = ColorRGB255;
@@ -35,6 +41,9 @@ using CColorConstHSL = ColorHSL;
 using CColorConstXYZ = ColorXYZ;
 using CColorConstYIQ = ColorYIQ;
 using CColorConstYUV = ColorYUV;
+using CColorConstLab = ColorLab;
+using CColorConstLCh = ColorLCh;
+using CColorConstOklab = ColorOklab;
 
 using CColorConstRGB256 = ColorRGB256;
 using CColorConstRGB255 = ColorRGB255;
@@ -156,6 +165,11 @@ float distance(Color const& x, Color const& y) {
     return std::sqrt(distance2(x, y));
 }
 
+template <typename Color>
+float delta_e(Color const& x, Color const& y) {
+    return deltaE(x, y);
+}
+
 template <typename Color>
 SampleType<Color> magic_pow(Color const& x, Color const& y) {
     return {powPython(x[0], y[0]),
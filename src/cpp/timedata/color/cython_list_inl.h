@@ -2,14 +2,21 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <limits>
+#include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <timedata/base/enum.h>
 #include <timedata/base/make.h>
 #include <timedata/base/math_inl.h>
+#include <timedata/base/parallel.h>
 #include <timedata/color/cython_inl.h>
 #include <timedata/color/for.h>
 #include <timedata/color/spread.h>
+#include <timedata/color/statistics.h>
+#include <timedata/signal/planar.h>
 #include <timedata/signal/slice.h>
 
 namespace timedata {
@@ -21,20 +28,38 @@ using CColorListHSL = color::CColorHSL::List;
 using CColorListXYZ = color::CColorXYZ::List;
 using CColorListYIQ = color::CColorYIQ::List;
 using CColorListYUV = color::CColorYUV::List;
+using CColorListLab = color::CColorLab::List;
+using CColorListLCh = color::CColorLCh::List;
+using CColorListOklab = color::CColorOklab::List;
 
 using CColorListRGB255 = color::CColorRGB255::List;
 using CColorListRGB256 = color::CColorRGB256::List;
 
+using CPlanarListRGB = PlanarList<color::CColorRGB>;
+using CPlanarListHSV = PlanarList<color::CColorHSV>;
+using CPlanarListHSL = PlanarList<color::CColorHSL>;
+using CPlanarListXYZ = PlanarList<color::CColorXYZ>;
+using CPlanarListYIQ = PlanarList<color::CColorYIQ>;
+using CPlanarListYUV = PlanarList<color::CColorYUV>;
+
+using CPlanarListRGB255 = PlanarList<color::CColorRGB255>;
+using CPlanarListRGB256 = PlanarList<color::CColorRGB256>;
+
 using CIndexList = timedata::CIndexList;
 
+/** Append a color as it appears in a list's repr: a quoted name, or a
+    parenthesized triple. */
 template <typename Color>
 void toStringItem(Color c, std::string& result) {
-    auto s = color::toString(c);
-    auto isTriple = s.find(",") != std::string::npos;
-    auto digit = isTriple ? 1 : 0;
-    result += "'("[digit];
-    result += s;
-    result += "')"[digit];
+    auto quote = result.size();
+    result += '\'';
+    if (appendColorName(c, result)) {
+        result += '\'';
+    } else {
+        result[quote] = '(';
+        appendCommaSeparated(c, 7, result);
+        result += ')';
+    }
 }
 
 template <>
@@ -43,12 +68,41 @@ inline void toStringItem(int x, std::string& result) {
 }
 
 template <typename ColorList>
-std::string toString(ColorList const& colors) {
-    std::string result = "(";
-    for (auto& c : colors) {
-        if (result.size() > 1)
+void toStringItems(ColorList const& colors, size_t begin, size_t end,
+                   std::string& result) {
+    for (auto i = begin; i < end; ++i) {
+        if (i > begin)
             result += ", ";
-        toStringItem(c, result);
+        toStringItem(colors[i], result);
+    }
+}
+
+/** Builds the whole repr in one presized string.  Huge lists are formatted
+    in parallel chunks, which are joined in order. */
+template <typename ColorList>
+std::string toString(ColorList const& colors) {
+    // Room for a typical "(0.5, 0.25, 1), " item.
+    static const size_t ITEM_SIZE = 24;
+
+    auto size = colors.size();
+    std::string result;
+    result.reserve(2 + size * ITEM_SIZE);
+    result += "(";
+    if (parallelism().isParallel(size)) {
+        auto format = [&](size_t begin, size_t end) {
+            std::string chunk;
+            chunk.reserve((end - begin) * ITEM_SIZE);
+            toStringItems(colors, begin, end, chunk);
+            return chunk;
+        };
+        auto join = [](std::string& r, std::string const& chunk) {
+            if (r.size() > 1)
+                r += ", ";
+            r += chunk;
+        };
+        result = reduceChunks(size, std::move(result), format, join);
+    } else {
+        toStringItems(colors, 0, size, result);
     }
     result += ")";
     return result;
@@ -59,12 +113,12 @@ float compare(ColorList const& x, ColorList const& y) {
     auto size = std::min(x.size(), y.size());
     for (size_t i = 0; i < size; ++i) {
         for (size_t j = 0; j < y[i].size(); ++j) {
-            if (auto d = x[i][j] - y[i][j])
+            if (auto d = float(x[i][j]) - float(y[i][j]))
                 return d;
         }
     }
 
-    return static_cast<NumberType<ColorList>>(signum(x.size(), y.size()));
+    return float(signum(x.size(), y.size()));
 }
 
 template <>
@@ -82,7 +136,7 @@ template <typename ColorList>
 float compare(ValueType<ColorList> const& x, ColorList const& y) {
     for (size_t i = 0; i < y.size(); ++i) {
         for (size_t j = 0; j < y[i].size(); ++j) {
-            if (auto d = x[j] - y[i][j])
+            if (auto d = float(x[j]) - float(y[i][j]))
                 return d;
         }
     }
@@ -108,7 +162,7 @@ template <typename ColorList>
 float compare(NumberType<ColorList> x, ColorList const& y) {
     for (size_t i = 0; i < y.size(); ++i) {
         for (size_t j = 0; j < y[i].size(); ++j) {
-            if (auto d = x - y[i][j])
+            if (auto d = float(x) - float(y[i][j]))
                 return d;
         }
     }
@@ -116,11 +170,19 @@ float compare(NumberType<ColorList> x, ColorList const& y) {
     return 0;
 }
 
+/** Copy a slice of `in` into `out`, reusing the memory `out` already has. */
+template <typename ColorVector, typename OutVector>
+void sliceOut(ColorVector const& in, int begin, int end, int step,
+              OutVector& out) {
+    auto slice = make<Slice>(begin, end, step);
+    out.clear();
+    forEach(slice, [&](int j) { out.push_back(in[j]); });
+}
+
 template <typename ColorVector>
 ColorVector sliceOut(ColorVector const& in, int begin, int end, int step) {
-    auto slice = make<Slice>(begin, end, step);
     ColorVector out;
-    forEach(slice, [&](int j) { out.push_back(in[j]); });
+    sliceOut(in, begin, end, step, out);
     return out;
 }
 
@@ -149,32 +211,65 @@ void sliceDelete(ColorVector& colors, int begin, int end, int step) {
         colors.resize(colors.size() - offset);
 }
 
+/** The starting points for min and max: the infinities where a number type
+    has them, like float or Half, and its ends where it doesn't. */
+template <typename Number>
+Number largest() {
+    using Limits = std::numeric_limits<ConstantType<Number>>;
+    return Limits::has_infinity ? Limits::infinity() : Limits::max();
+}
+
+template <typename Number>
+Number smallest() {
+    using Limits = std::numeric_limits<ConstantType<Number>>;
+    return Limits::has_infinity ? -Limits::infinity() : Limits::lowest();
+}
+
 template <typename ColorList>
 ValueType<ColorList> min_cpp(ColorList const& cl) {
     using Color = ValueType<ColorList>;
-    using value_type = ValueType<Color>;
 
     Color result;
-    result.fill(std::numeric_limits<value_type>::infinity());
-    for (auto& c: cl) {
+    result.fill(largest<NumberType<ColorList>>());
+    auto merge = [](Color& r, Color const& c) {
         for (size_t i = 0; i < c.size(); ++i)
-            result[i] = std::min(result[i], c[i]);
-    }
-    return result;
+            r[i] = std::min(r[i], c[i]);
+    };
+    return reduceChunks(cl.size(), result, [&](size_t begin, size_t end) {
+        auto r = result;
+        for (auto i = begin; i < end; ++i)
+            merge(r, cl[i]);
+        return r;
+    }, merge);
 }
 
 template <typename ColorList>
 ValueType<ColorList> max_cpp(ColorList const& cl) {
     using Color = ValueType<ColorList>;
-    using value_type = ValueType<Color>;
 
     Color result;
-    result.fill(-std::numeric_limits<value_type>::infinity());
-    for (auto& c: cl) {
+    result.fill(smallest<NumberType<ColorList>>());
+    auto merge = [](Color& r, Color const& c) {
         for (size_t i = 0; i < c.size(); ++i)
-            result[i] = std::max(result[i], c[i]);
-    }
-    return result;
+            r[i] = std::max(r[i], c[i]);
+    };
+    return reduceChunks(cl.size(), result, [&](size_t begin, size_t end) {
+        auto r = result;
+        for (auto i = begin; i < end; ++i)
+            merge(r, cl[i]);
+        return r;
+    }, merge);
+}
+
+template <typename ColorList>
+Statistics statistics_cpp(ColorList const& cl) {
+    return statistics(cl);
+}
+
+template <typename ColorList>
+std::vector<size_t> histogram_cpp(ColorList const& cl, size_t bins,
+                                  float low, float high) {
+    return histogram(cl, bins, low, high);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -305,6 +400,19 @@ void sort(ColorList const& i, ColorList& o, bool reversed) {
         std::partial_sort_copy(i.begin(), i.end(), o.rbegin(), o.rend());
 }
 
+/** Append one color for each spec in `specs`, parsed in one pass by
+    parseColors.  Returns the index of the first spec that doesn't parse, or
+    -1 if they all do; `out` is only changed if they all do. */
+template <typename ColorList>
+int extendStrings(std::vector<std::string> const& specs, ColorList& out) {
+    static thread_local ColorList parsed;
+    static thread_local std::vector<ColorParseError> errors;
+    if (not parseColors(specs, parsed, errors))
+        return static_cast<int>(errors.front().index);
+    out.insert(out.end(), parsed.begin(), parsed.end());
+    return -1;
+}
+
 template <typename ColorList>
 void spreadAppend(ValueType<ColorList> const& end, size_t size,
                   ColorList& out) {
@@ -322,25 +430,29 @@ void applyEach(ColorList& out, Function f) {
             j = f(j);
 }
 
+/** `f` is done in float, so it works on integer and Half samples too. */
 template <typename ColorList>
-void forParts1F(ColorList const& in, ColorList& out,
-                Transform<NumberType<ColorList>> f) {
-    forParts1(in, out, f);
+void forParts1F(ColorList const& in, ColorList& out, simd::Unary op,
+                Transform<float> f) {
+    using Number = NumberType<ColorList>;
+    forParts1(in, out, op, [f](Number x) {
+        return saturateCast<Number>(f(float(x)));
+    });
 }
 
 template <typename ColorList>
 void math_abs(ColorList const& in, ColorList& out) {
-    forParts1F(in, out, std::abs);
+    forParts1F(in, out, simd::Unary::abs, std::abs);
 }
 
 template <typename ColorList>
 void math_floor(ColorList const& in, ColorList& out) {
-    forParts1F(in, out, std::floor);
+    forParts1F(in, out, simd::Unary::floor, std::floor);
 }
 
 template <typename ColorList>
 void math_ceil(ColorList const& in, ColorList& out) {
-    forParts1F(in, out, std::ceil);
+    forParts1F(in, out, simd::Unary::ceil, std::ceil);
 }
 
 template <typename ColorList>
@@ -351,7 +463,10 @@ void math_invert(ColorList const& in, ColorList& out) {
 
 template <typename ColorList>
 void math_neg(ColorList const& in, ColorList& out) {
-    forParts1(in, out, [](NumberType<ColorList> c) { return -c; });
+    using Number = NumberType<ColorList>;
+    forParts1(in, out, simd::Unary::neg, [](Number c) {
+        return saturateCast<Number>(-float(c));
+    });
 }
 
 template <typename ColorList>
@@ -365,7 +480,7 @@ void math_reverse(ColorList const& in, ColorList& out) {
 
 template <typename ColorList>
 void math_trunc(ColorList const& in, ColorList& out) {
-    forParts1F(in, out, std::trunc);
+    forParts1F(in, out, simd::Unary::trunc, std::trunc);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -380,71 +495,93 @@ void math_zero(ColorList& out) {
     std::fill(out.begin(), out.end(), ValueType<ColorList>{});
 }
 
+template <typename Sample>
+void math_zero(PlanarList<Sample>& out) {
+    for (size_t j = 0; j < Sample::SIZE; ++j)
+        std::fill(out.channel(j), out.channel(j) + out.size(), 0);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 template <typename Input, typename ColorList>
 void math_add(ColorList const& in, Input const& in2, ColorList& out) {
     using Number = RangedType<ColorList>;
-     forParts2(in, in2, out, [](Number x, Number y) { return x + y; });
+    forParts2(in, in2, out, simd::Binary::add,
+              [](Number x, Number y) { return x + y; });
 }
 
 template <typename Input, typename ColorList>
 void math_div(ColorList const& in, Input const& in2, ColorList& out) {
     using Number = NumberType<ColorList>;
-    forParts2(in, in2, out, [](Number x, Number y) { return divPython(y, x); });
+    forParts2(in, in2, out, simd::Binary::div,
+              [](Number x, Number y) {
+        return saturateCast<Number>(divPython(y, x));
+    });
 }
 
 template <typename Input, typename ColorList>
 void math_rdiv(ColorList const& in, Input const& in2, ColorList& out) {
     using Number = NumberType<ColorList>;
-    forParts2(in, in2, out, [](Number x, Number y) { return divPython(x, y); });
+    forParts2(in, in2, out, simd::Binary::rdiv,
+              [](Number x, Number y) {
+        return saturateCast<Number>(divPython(x, y));
+    });
 }
 
 template <typename Input, typename ColorList>
 void math_mul(ColorList const& in, Input const& in2, ColorList& out) {
     using Number = NumberType<ColorList>;
-    forParts2(in, in2, out, [](Number x, Number y) { return x * y; });
+    forParts2(in, in2, out, simd::Binary::mul,
+              [](Number x, Number y) { return mulSaturate(x, y); });
 }
 
 template <typename Input, typename ColorList>
 void math_pow(ColorList const& in, Input const& in2, ColorList& out) {
     using Number = NumberType<ColorList>;
-    forParts2(in, in2, out, [](Number x, Number y) { return powPython(y, x); });
+    forParts2(in, in2, out, [](Number x, Number y) {
+        return saturateCast<Number>(powPython(y, x));
+    });
 }
 
 template <typename Input, typename ColorList>
 void math_rpow(ColorList const& in, Input const& in2, ColorList& out) {
     using Number = NumberType<ColorList>;
-    forParts2(in, in2, out, [](Number x, Number y) { return powPython(x, y); });
+    forParts2(in, in2, out, [](Number x, Number y) {
+        return saturateCast<Number>(powPython(x, y));
+    });
 }
 
 template <typename Input, typename ColorList>
 void math_sub(ColorList const& in, Input const& in2, ColorList& out) {
     using Number = NumberType<ColorList>;
-    forParts2(in, in2, out, [](Number x, Number y) { return x - y; });
+    forParts2(in, in2, out, simd::Binary::sub,
+              [](Number x, Number y) { return subSaturate(x, y); });
 }
 
 template <typename Input, typename ColorList>
 void math_rsub(ColorList const& in, Input const& in2, ColorList& out) {
     using Number = NumberType<ColorList>;
-    forParts2(in, in2, out, [](Number x, Number y) { return y - x; });
+    forParts2(in, in2, out, simd::Binary::rsub,
+              [](Number x, Number y) { return subSaturate(y, x); });
 }
 
 template <typename Input, typename ColorList>
 void math_min_limit(ColorList const& in, Input const& in2, ColorList& out) {
     using Number = NumberType<ColorList>;
-    forParts2(in, in2, out, [](Number x, Number y) { return std::max(x, y); });
+    forParts2(in, in2, out, simd::Binary::minLimit,
+              [](Number x, Number y) { return std::max(x, y); });
 }
 
 template <typename Input, typename ColorList>
 void math_max_limit(ColorList const& in, Input const& in2, ColorList& out) {
     using Number = NumberType<ColorList>;
-    forParts2(in, in2, out, [](Number x, Number y) { return std::min(x, y); });
+    forParts2(in, in2, out, simd::Binary::maxLimit,
+              [](Number x, Number y) { return std::min(x, y); });
 }
 
 template <typename ColorList>
 float distance2(ColorList const& x, ColorList const& y) {
-    NumberType<ColorList> result = 0.0f;
+    auto result = 0.0f;
     auto xShorter = x.size() < y.size();
     auto& shorter = xShorter ? x : y;
     auto& longer = xShorter ? y : x;
@@ -452,14 +589,15 @@ float distance2(ColorList const& x, ColorList const& y) {
     size_t i = 0;
     for (; i < shorter.size(); ++i) {
         for (size_t j = 0; j < longer[i].size(); ++j) {
-            auto d = longer[i][j] - shorter[i][j];
+            auto d = float(longer[i][j]) - float(shorter[i][j]);
             result += d * d;
         }
     }
 
     for (; i < longer.size(); ++i) {
         for (size_t j = 0; j < longer[i].size(); ++j) {
-            result += longer[i][j] * longer[i][j];
+            auto d = float(longer[i][j]);
+            result += d * d;
         }
     }
 
@@ -486,12 +624,11 @@ float distance2(CIndexList const& x, CIndexList const& y) {
 }
 
 template <typename ColorList>
-NumberType<ColorList> distance2(
-        ValueType<ColorList> const& x, ColorList const& y) {
-    NumberType<ColorList> result = 0.0f;
+float distance2(ValueType<ColorList> const& x, ColorList const& y) {
+    auto result = 0.0f;
     for (size_t i = 0; i < y.size(); ++i) {
         for (size_t j = 0; j < y[i].size(); ++j) {
-            auto d = x[j] - y[i][j];
+            auto d = float(x[j]) - float(y[i][j]);
             result += d * d;
         }
     }
@@ -510,11 +647,11 @@ float distance2(float x, CIndexList const& y) {
 }
 
 template <typename ColorList>
-NumberType<ColorList> distance2(NumberType<ColorList> x, ColorList const& y) {
-    NumberType<ColorList> result = 0.0f;
+float distance2(NumberType<ColorList> x, ColorList const& y) {
+    auto result = 0.0f;
     for (size_t i = 0; i < y.size(); ++i) {
         for (size_t j = 0; j < y[i].size(); ++j) {
-            auto d = x - y[i][j];
+            auto d = float(x) - float(y[i][j]);
             result += d * d;
         }
     }
@@ -522,7 +659,7 @@ NumberType<ColorList> distance2(NumberType<ColorList> x, ColorList const& y) {
 }
 
 template <typename Input, typename ColorList>
-NumberType<ColorList> distance(Input x, ColorList const& y) {
+float distance(Input x, ColorList const& y) {
     return std::sqrt(distance2(x, y));
 }
 
@@ -536,6 +673,20 @@ float distance(size_t x, CIndexList const& y) {
     return std::sqrt(distance2(x, y));
 }
 
+/** The mean deltaE between corresponding samples of two lists, over the
+    length of the shorter one. */
+template <typename ColorList>
+float delta_e(ColorList const& x, ColorList const& y) {
+    return meanDeltaE(x, y);
+}
+
+/** Write the deltaE between corresponding samples of two lists into `out`,
+    which has room for the length of the shorter one. */
+template <typename ColorList>
+void delta_e_to_cpp(ColorList const& x, ColorList const& y, float* out) {
+    deltaE(x, y, out);
+}
+
 template <typename ColorList>
 void magic_add(ColorList const& in, ColorList& out) {
     out.insert(out.end(), in.begin(), in.end());
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <timedata/base/parallel.h>
+#include <timedata/color/models/lab.h>
+#include <timedata/color/perceptualSimd.h>
+#include <timedata/signal/convertList.h>
+
+namespace timedata {
+
+/** The CIE76 deltaE - the distance in CIELAB - between two samples of any
+    color model. */
+template <typename ColorX, typename ColorY>
+float deltaE(ColorX const& x, ColorY const& y);
+
+/** out[i] = deltaE(x[i], y[i]) over the length of the shorter list, into
+    caller storage with room for that many floats.  The lists are converted
+    to ColorLab a tile at a time on the stack, and the distances are then
+    taken eight at a time, so nothing is allocated. */
+template <typename ListX, typename ListY>
+void deltaE(ListX const& x, ListY const& y, float* out);
+
+/** The same, resizing `out` to fit. */
+template <typename ListX, typename ListY>
+void deltaE(ListX const& x, ListY const& y, std::vector<float>& out);
+
+/** The mean of deltaE(x[i], y[i]) over the length of the shorter list, or 0
+    if it is empty, without allocating.  The sum is pairwise, so the answer
+    doesn't depend on how the work is split over threads. */
+template <typename ListX, typename ListY>
+float meanDeltaE(ListX const& x, ListY const& y);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename ColorX, typename ColorY>
+float deltaE(ColorX const& x, ColorY const& y) {
+    ColorLab lx, ly;
+    converter::convertSample(x, lx);
+    converter::convertSample(y, ly);
+
+    float total = 0;
+    for (size_t i = 0; i < lx.size(); ++i) {
+        auto d = *lx[i] - *ly[i];
+        total += d * d;
+    }
+    return std::sqrt(total);
+}
+
+// Two tiles of 256 ColorLabs and their distances come to 7K of stack.
+static const size_t DELTA_E_TILE = 256;
+
+namespace detail {
+
+/** deltaE for the `size` samples starting at `begin`, which must be no more
+    than DELTA_E_TILE. */
+template <typename ListX, typename ListY>
+void deltaETile(ListX const& x, ListY const& y, size_t begin, size_t size,
+                float* out) {
+    using converter::ListConverter;
+    ColorLab lx[DELTA_E_TILE], ly[DELTA_E_TILE];
+    ListConverter<ValueType<ListX>, ColorLab>::convert(
+        x.data() + begin, lx, size);
+    ListConverter<ValueType<ListY>, ColorLab>::convert(
+        y.data() + begin, ly, size);
+    simd::deltaE(reinterpret_cast<float const*>(lx),
+                 reinterpret_cast<float const*>(ly), out, size);
+}
+
+} // detail
+
+template <typename ListX, typename ListY>
+void deltaE(ListX const& x, ListY const& y, float* out) {
+    auto size = std::min(x.size(), y.size());
+    forChunks(size, [&](size_t begin, size_t end) {
+        for (auto i = begin; i < end; i += DELTA_E_TILE) {
+            detail::deltaETile(
+                x, y, i, std::min(end - i, DELTA_E_TILE), out + i);
+        }
+    });
+}
+
+template <typename ListX, typename ListY>
+void deltaE(ListX const& x, ListY const& y, std::vector<float>& out) {
+    out.resize(std::min(x.size(), y.size()));
+    deltaE(x, y, out.data());
+}
+
+template <typename ListX, typename ListY>
+float meanDeltaE(ListX const& x, ListY const& y) {
+    auto size = std::min(x.size(), y.size());
+    auto tile = [&](size_t begin, size_t end) {
+        float d[DELTA_E_TILE];
+        detail::deltaETile(x, y, begin, end - begin, d);
+
+        double total = 0;
+        for (size_t i = 0; i < end - begin; ++i)
+            total += d[i];
+        return total;
+    };
+    auto add = [](double& total, double t) { total += t; };
+    auto total = reducePairwise(size, DELTA_E_TILE, 0.0, tile, add);
+    return size ? static_cast<float>(total / size) : 0.0f;
+}
+
+} // timedata
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include <timedata/base/enum.h>
+#include <timedata/base/simd_inl.h>
+#include <timedata/signal/planar.h>
+#include <timedata/signal/sampleFunctions.h>
+
+namespace timedata {
+namespace color_list {
+
+/** Lazy expressions over lists of samples.
+
+    Each math_* function makes one full pass over memory, so something like
+
+        out = limit_min(limit_max(a * b + c, 1), 0)
+
+    done one operation at a time reads and writes every sample four times and
+    needs a temporary list for each step.  For big lists, that's all memory
+    bandwidth.
+
+    Instead, `lazy(list)` wraps a list in an Expression.  Arithmetic on
+    Expressions doesn't compute anything - it just records the operations in
+    the type of the result.  `evaluate(expression, out)` then computes the
+    whole chain in a single pass, one number at a time, with no intermediate
+    lists at all:
+
+        evaluate(limit_min(limit_max(lazy(a) * lazy(b) + lazy(c), 1), 0), out);
+
+    The operands of an Expression can be other Expressions, Samples or plain
+    numbers.  The arithmetic is exactly that of the corresponding math_*
+    functions, since it's shared with the simd::Scalar kernels.
+
+    Expressions hold references to their lists, so they must be evaluated
+    before any of those lists go away.  `out` may be one of the input lists.
+*/
+template <typename Derived>
+struct Expression {
+    Derived const& self() const { return static_cast<Derived const&>(*this); }
+};
+
+/** The size of a term that isn't a list, like a Sample or a number. */
+static const auto UNBOUNDED = std::numeric_limits<size_t>::max();
+
+template <typename ColorList>
+struct ListTerm : Expression<ListTerm<ColorList>> {
+    using sample_type = ValueType<ColorList>;
+    using number_type = NumberType<sample_type>;
+
+    ColorList const& list;
+
+    ListTerm(ColorList const& l) : list(l) {}
+
+    size_t size() const { return list.size(); }
+    number_type operator()(size_t i, size_t j) const { return list[i][j]; }
+};
+
+template <typename Sample>
+struct ListTerm<PlanarList<Sample>>
+        : Expression<ListTerm<PlanarList<Sample>>> {
+    using sample_type = Sample;
+    using number_type = NumberType<Sample>;
+
+    PlanarList<Sample> const& list;
+
+    ListTerm(PlanarList<Sample> const& l) : list(l) {}
+
+    size_t size() const { return list.size(); }
+    number_type operator()(size_t i, size_t j) const {
+        return list.channel(j)[i];
+    }
+};
+
+template <typename Sample>
+struct SampleTerm : Expression<SampleTerm<Sample>> {
+    using sample_type = Sample;
+    using number_type = NumberType<Sample>;
+
+    Sample sample;
+
+    SampleTerm(Sample const& s) : sample(s) {}
+
+    size_t size() const { return UNBOUNDED; }
+    number_type operator()(size_t, size_t j) const { return sample[j]; }
+};
+
+template <typename Sample>
+struct NumberTerm : Expression<NumberTerm<Sample>> {
+    using sample_type = Sample;
+    using number_type = NumberType<Sample>;
+
+    number_type number;
+
+    NumberTerm(number_type n) : number(n) {}
+
+    size_t size() const { return UNBOUNDED; }
+    number_type operator()(size_t, size_t) const { return number; }
+};
+
+template <simd::Binary OP, typename Left, typename Right>
+struct BinaryTerm : Expression<BinaryTerm<OP, Left, Right>> {
+    using sample_type = SampleType<Left>;
+    using number_type = NumberType<Left>;
+
+    Left left;
+    Right right;
+
+    BinaryTerm(Left const& l, Right const& r) : left(l), right(r) {}
+
+    size_t size() const { return std::min(left.size(), right.size()); }
+    number_type operator()(size_t i, size_t j) const {
+        return simd::Scalar::apply<OP>(left(i, j), right(i, j));
+    }
+};
+
+template <simd::Unary OP, typename Term>
+struct UnaryTerm : Expression<UnaryTerm<OP, Term>> {
+    using sample_type = SampleType<Term>;
+    using number_type = NumberType<Term>;
+
+    Term term;
+
+    UnaryTerm(Term const& t) : term(t) {}
+
+    size_t size() const { return term.size(); }
+    number_type operator()(size_t i, size_t j) const {
+        return simd::Scalar::apply<OP>(term(i, j));
+    }
+};
+
+template <typename X>
+using IsExpression = std::is_base_of<Expression<X>, X>;
+
+/** The term type for an operand X in an expression over Samples of type
+    Sample. */
+template <typename Sample, typename X, typename Enable = void>
+struct TermOf {
+    using type = NumberTerm<Sample>;
+};
+
+template <typename Sample, typename X>
+struct TermOf<Sample, X, enable_if_t<IsExpression<X>::value>> {
+    using type = X;
+};
+
+template <typename Sample>
+struct TermOf<Sample, Sample> {
+    using type = SampleTerm<Sample>;
+};
+
+template <typename Term, typename X>
+using TermType = typename TermOf<SampleType<Term>, X>::type;
+
+template <typename Term, typename X>
+using IfNotExpression = enable_if_t<not IsExpression<X>::value, Term>;
+
+/** Wrap a list in an Expression. */
+template <typename ColorList>
+ListTerm<ColorList> lazy(ColorList const& list) {
+    return {list};
+}
+
+#define TIMEDATA_EXPRESSION_OPERATOR(OPERATOR, OP, ROP)                   \
+template <typename L, typename X>                                          \
+BinaryTerm<simd::Binary::OP, L, TermType<L, X>>                            \
+operator OPERATOR(Expression<L> const& l, X const& r) {                    \
+    return {l.self(), TermType<L, X>(r)};                                  \
+}                                                                          \
+                                                                           \
+template <typename X, typename R>                                          \
+IfNotExpression<BinaryTerm<simd::Binary::ROP, R, TermType<R, X>>, X>       \
+operator OPERATOR(X const& l, Expression<R> const& r) {                    \
+    return {r.self(), TermType<R, X>(l)};                                  \
+}
+
+// In simd::Binary, `sub` is x - y, `rsub` is y - x and so on.
+TIMEDATA_EXPRESSION_OPERATOR(+, add, add)
+TIMEDATA_EXPRESSION_OPERATOR(-, sub, rsub)
+TIMEDATA_EXPRESSION_OPERATOR(*, mul, mul)
+TIMEDATA_EXPRESSION_OPERATOR(/, rdiv, div)
+
+#undef TIMEDATA_EXPRESSION_OPERATOR
+
+template <typename E>
+UnaryTerm<simd::Unary::neg, E> operator-(Expression<E> const& e) {
+    return {e.self()};
+}
+
+/** Limit the expression to be at least x, like math_min_limit. */
+template <typename E, typename X>
+BinaryTerm<simd::Binary::minLimit, TermType<E, X>, E>
+limit_min(Expression<E> const& e, X const& x) {
+    return {TermType<E, X>(x), e.self()};
+}
+
+/** Limit the expression to be at most x, like math_max_limit. */
+template <typename E, typename X>
+BinaryTerm<simd::Binary::maxLimit, TermType<E, X>, E>
+limit_max(Expression<E> const& e, X const& x) {
+    return {TermType<E, X>(x), e.self()};
+}
+
+template <typename E>
+UnaryTerm<simd::Unary::abs, E> lazy_abs(Expression<E> const& e) {
+    return {e.self()};
+}
+
+template <typename E>
+UnaryTerm<simd::Unary::floor, E> lazy_floor(Expression<E> const& e) {
+    return {e.self()};
+}
+
+template <typename E>
+UnaryTerm<simd::Unary::ceil, E> lazy_ceil(Expression<E> const& e) {
+    return {e.self()};
+}
+
+template <typename E>
+UnaryTerm<simd::Unary::trunc, E> lazy_trunc(Expression<E> const& e) {
+    return {e.self()};
+}
+
+/** Compute an expression in a single pass, resizing `out` to fit. */
+template <typename E>
+void evaluate(Expression<E> const& expression,
+              typename SampleType<E>::List& out) {
+    auto& e = expression.self();
+    auto size = e.size();
+    out.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        auto& o = out[i];
+        for (size_t j = 0; j < o.size(); ++j)
+            o[j] = e(i, j);
+    }
+}
+
+template <typename E>
+void evaluate(Expression<E> const& expression,
+              PlanarList<SampleType<E>>& out) {
+    auto& e = expression.self();
+    auto size = e.size();
+    out.resize(size);
+    for (size_t j = 0; j < SampleType<E>::SIZE; ++j) {
+        auto o = out.channel(j);
+        for (size_t i = 0; i < size; ++i)
+            o[i] = e(i, j);
+    }
+}
+
+} // color_list
+} // timedata
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <timedata/color/cython_list_inl.h>
+#include <timedata/color/expression.h>
+
+namespace timedata {
+namespace color_list {
+
+inline CColorListRGB expressionList(size_t size, float offset) {
+    CColorListRGB list;
+    for (size_t i = 0; i < size; ++i)
+        list.push_back({offset + i / 7.0f, 2.0f - i / 5.0f, offset * i});
+    return list;
+}
+
+TEST_CASE("expression fuses math", "expression") {
+    auto a = expressionList(23, 0.25f), b = expressionList(23, 1.5f);
+    auto c = expressionList(23, -0.75f);
+
+    CColorListRGB expected;
+    math_mul(a, b, expected);
+    math_add(expected, c, expected);
+    math_min_limit(expected, 0.0f, expected);
+    math_max_limit(expected, 1.0f, expected);
+
+    CColorListRGB actual;
+    evaluate(limit_max(limit_min(lazy(a) * lazy(b) + lazy(c), 0.0f), 1.0f),
+             actual);
+    REQUIRE(actual == expected);
+
+    CPlanarListRGB planar;
+    evaluate(limit_max(limit_min(lazy(a) * lazy(b) + lazy(c), 0.0f), 1.0f),
+             planar);
+    REQUIRE(planar.toList() == expected);
+}
+
+TEST_CASE("expression operand order", "expression") {
+    auto a = expressionList(9, 0.5f);
+    color::CColorRGB s{1.0f, 2.0f, 4.0f};
+
+    CColorListRGB expected, actual;
+    math_rsub(a, s, expected);
+    evaluate(lazy(a) - s, actual);
+    REQUIRE(actual == expected);
+
+    math_sub(a, s, expected);
+    evaluate(s - lazy(a), actual);
+    REQUIRE(actual == expected);
+
+    math_div(a, 2.0f, expected);
+    evaluate(lazy(a) / 2.0f, actual);
+    REQUIRE(actual == expected);
+
+    math_neg(a, expected);
+    math_abs(expected, expected);
+    evaluate(lazy_abs(-lazy(a)), actual);
+    REQUIRE(actual == expected);
+
+    // Evaluating into one of the inputs is fine.
+    math_mul(a, a, expected);
+    evaluate(lazy(a) * lazy(a), a);
+    REQUIRE(a == expected);
+}
+
+} // color_list
+} // timedata
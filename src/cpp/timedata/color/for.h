@@ -1,18 +1,32 @@
  #pragma once
 
+#include <array>
 #include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include <timedata/base/parallel.h>
+#include <timedata/base/saturate.h>
+#include <timedata/base/simd_inl.h>
+#include <timedata/signal/planar.h>
 
 namespace timedata {
 namespace color_list {
 
+// All of these loops go through forChunks, so big lists are split over the
+// thread pool when parallelism() says so.  `out` is always resized first,
+// since the chunks can't do that.
+
 template <typename ColorList, typename Function>
 void forParts1(ColorList const& in, ColorList& out, Function f) {
     if (out.size() < in.size())
         out.resize(in.size());
-    for (size_t i = 0; i < in.size(); ++i) {
-        for (size_t j = 0; j < in[i].size(); ++j)
-            out[i][j] = f(in[i][j]);
-    }
+    forChunks(in.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            for (size_t j = 0; j < in[i].size(); ++j)
+                out[i][j] = f(in[i][j]);
+        }
+    });
 }
 
 template <typename ColorList, typename Function>
@@ -22,17 +36,19 @@ void forParts1(ColorList& out, Function f) {
 
 template <typename ColorList, typename Function, typename Getter>
 void forParts2Imp(ColorList const& in, ColorList& out, Function f, Getter get) {
-    for (size_t i = 0; i < in.size(); ++i) {
-        for (size_t j = 0; j < in[i].size(); ++j)
-            out[i][j] = f(get(i, j), in[i][j]);
-    }
+    if (out.size() < in.size())
+        out.resize(in.size());
+    forChunks(in.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            for (size_t j = 0; j < in[i].size(); ++j)
+                out[i][j] = f(get(i, j), in[i][j]);
+        }
+    });
 }
 
 template <typename ColorList, typename Function>
 void forParts2(ColorList const& in, ColorList const& in2,
                ColorList& out, Function f) {
-    if (out.size() < in.size())
-        out.resize(in.size());
     forParts2Imp(in, out, f, [&](size_t i, size_t j) { return in2[i][j]; });
 }
 
@@ -53,6 +69,311 @@ void forParts2(Input in2, ColorList& out, Function f) {
     forParts2(out, in2, out, f);
 }
 
+// Planar versions of forParts1 and forParts2 - each channel is a flat array.
+
+template <typename Sample, typename Function>
+void forParts1(PlanarList<Sample> const& in, PlanarList<Sample>& out,
+               Function f) {
+    if (out.size() < in.size())
+        out.resize(in.size());
+    forChunks(in.size(), [&](size_t begin, size_t end) {
+        for (size_t j = 0; j < Sample::SIZE; ++j) {
+            auto i = in.channel(j);
+            auto o = out.channel(j);
+            for (size_t k = begin; k < end; ++k)
+                o[k] = f(i[k]);
+        }
+    });
+}
+
+template <typename Sample, typename Function>
+void forParts1(PlanarList<Sample>& out, Function f) {
+    forParts1(out, out, f);
+}
+
+template <typename Sample>
+using Planes = std::array<NumberType<Sample> const*, Sample::SIZE>;
+
+/** If `broadcast` is true, each entry in `in2` points to a single number
+    to be used for the whole channel. */
+template <typename Sample, typename Function>
+void forParts2Imp(PlanarList<Sample> const& in, Planes<Sample> const& in2,
+                  bool broadcast, PlanarList<Sample>& out, Function f) {
+    if (out.size() < in.size())
+        out.resize(in.size());
+    forChunks(in.size(), [&](size_t begin, size_t end) {
+        for (size_t j = 0; j < Sample::SIZE; ++j) {
+            auto i = in.channel(j);
+            auto o = out.channel(j);
+            auto g = in2[j];
+            if (broadcast) {
+                auto x = *g;
+                for (size_t k = begin; k < end; ++k)
+                    o[k] = f(x, i[k]);
+            } else {
+                for (size_t k = begin; k < end; ++k)
+                    o[k] = f(g[k], i[k]);
+            }
+        }
+    });
+}
+
+template <typename Sample, typename Function>
+void forParts2(PlanarList<Sample> const& in, PlanarList<Sample> const& in2,
+               PlanarList<Sample>& out, Function f) {
+    Planes<Sample> planes;
+    for (size_t j = 0; j < Sample::SIZE; ++j)
+        planes[j] = in2.channel(j);
+    forParts2Imp(in, planes, false, out, f);
+}
+
+template <typename Sample, typename Function>
+void forParts2(PlanarList<Sample> const& in, Sample const& in2,
+               PlanarList<Sample>& out, Function f) {
+    Planes<Sample> planes;
+    for (size_t j = 0; j < Sample::SIZE; ++j)
+        planes[j] = &*in2[j];
+    forParts2Imp(in, planes, true, out, f);
+}
+
+template <typename Sample, typename Function>
+void forParts2(PlanarList<Sample> const& in, NumberType<Sample> const& in2,
+               PlanarList<Sample>& out, Function f) {
+    Planes<Sample> planes;
+    planes.fill(&in2);
+    forParts2Imp(in, planes, true, out, f);
+}
+
+// Versions of forParts1 and forParts2 that take a simd operation equivalent to
+// the function, and use the vectorized kernels in base/simd.h when the list's
+// storage is a flat array of floats.
+
+/** Is a list of Samples laid out in memory as one flat array of floats? */
+template <typename ColorList>
+struct IsFlatFloat : std::integral_constant<bool,
+    std::is_same<NumberType<ColorList>, float>::value and
+    sizeof(ValueType<ColorList>) ==
+    ValueType<ColorList>::SIZE * sizeof(float)> {
+};
+
+/** Is a list of Samples laid out in memory as one flat array of unsigned
+    integers, whose arithmetic saturates? */
+template <typename ColorList>
+struct IsFlatInteger : std::integral_constant<bool,
+    std::is_integral<NumberType<ColorList>>::value and
+    std::is_unsigned<NumberType<ColorList>>::value and
+    sizeof(ValueType<ColorList>) ==
+    ValueType<ColorList>::SIZE * sizeof(NumberType<ColorList>)> {
+};
+
+template <typename ColorList>
+NumberType<ColorList> const* flatData(ColorList const& x) {
+    return reinterpret_cast<NumberType<ColorList> const*>(x.data());
+}
+
+template <typename ColorList>
+NumberType<ColorList>* flatData(ColorList& x) {
+    return reinterpret_cast<NumberType<ColorList>*>(x.data());
+}
+
+template <typename ColorList>
+size_t flatSize(ColorList const& x) {
+    return x.size() * ValueType<ColorList>::SIZE;
+}
+
+template <typename ColorList, typename Function>
+void forParts1Simd(ColorList const& in, ColorList& out,
+                   simd::Unary, Function f, std::false_type) {
+    forParts1(in, out, f);
+}
+
+template <typename ColorList, typename Function>
+void forParts1Simd(ColorList const& in, ColorList& out,
+                   simd::Unary op, Function, std::true_type) {
+    if (out.size() < in.size())
+        out.resize(in.size());
+    static const auto SIZE = ValueType<ColorList>::SIZE;
+    auto i = flatData(in);
+    auto o = flatData(out);
+    forChunks(in.size(), [&](size_t begin, size_t end) {
+        simd::unary(op, i + begin * SIZE, o + begin * SIZE,
+                    (end - begin) * SIZE);
+    });
+}
+
+template <typename ColorList, typename Function>
+void forParts1(ColorList const& in, ColorList& out,
+               simd::Unary op, Function f) {
+    forParts1Simd(in, out, op, f, IsFlatFloat<ColorList>());
+}
+
+template <typename Sample, typename Function>
+void forParts1(PlanarList<Sample> const& in, PlanarList<Sample>& out,
+               simd::Unary op, Function) {
+    if (out.size() < in.size())
+        out.resize(in.size());
+    forChunks(in.size(), [&](size_t begin, size_t end) {
+        for (size_t j = 0; j < Sample::SIZE; ++j) {
+            simd::unary(op, in.channel(j) + begin, out.channel(j) + begin,
+                        end - begin);
+        }
+    });
+}
+
+template <typename ColorList, typename Input, typename Function>
+void forParts2Saturate(ColorList const& in, Input const& in2, ColorList& out,
+                       simd::Binary, Function f, std::false_type) {
+    forParts2(in, in2, out, f);
+}
+
+// An integer list with a single sample or number goes through `f`, which
+// must saturate too.
+template <typename ColorList, typename Input, typename Function>
+void forParts2Saturate(ColorList const& in, Input const& in2, ColorList& out,
+                       simd::Binary, Function f, std::true_type) {
+    forParts2(in, in2, out, f);
+}
+
+/** Two integer lists use the saturating kernels in base/saturate.h for
+    add, sub, rsub and mul, and `f` for everything else. */
+template <typename ColorList, typename Function>
+void forParts2Saturate(ColorList const& in, ColorList const& in2,
+                       ColorList& out, simd::Binary op, Function f,
+                       std::true_type) {
+    using simd::Binary;
+    using simd::Saturating;
+
+    auto saturating = Saturating::add;
+    auto swap = false;
+    switch (op) {
+        case Binary::add:
+            break;
+        case Binary::sub:
+            saturating = Saturating::sub;
+            break;
+        case Binary::rsub:
+            saturating = Saturating::sub;
+            swap = true;
+            break;
+        case Binary::mul:
+            saturating = Saturating::mul;
+            break;
+        default:
+            return forParts2(in, in2, out, f);
+    }
+
+    if (out.size() < in.size())
+        out.resize(in.size());
+    static const auto SIZE = ValueType<ColorList>::SIZE;
+    auto x = flatData(in2);
+    auto y = flatData(in);
+    auto o = flatData(out);
+    if (swap)
+        std::swap(x, y);
+    forChunks(in.size(), [&](size_t begin, size_t end) {
+        auto b = begin * SIZE;
+        simd::saturating(saturating, x + b, y + b, o + b,
+                         (end - begin) * SIZE);
+    });
+}
+
+template <typename ColorList, typename Input, typename Function>
+void forParts2Simd(ColorList const& in, Input const& in2, ColorList& out,
+                   simd::Binary op, Function f, std::false_type) {
+    forParts2Saturate(in, in2, out, op, f, IsFlatInteger<ColorList>());
+}
+
+template <typename ColorList, typename Function>
+void forParts2Simd(ColorList const& in, ColorList const& in2, ColorList& out,
+                   simd::Binary op, Function, std::true_type) {
+    if (out.size() < in.size())
+        out.resize(in.size());
+    static const auto SIZE = ValueType<ColorList>::SIZE;
+    auto x = flatData(in2);
+    auto y = flatData(in);
+    auto o = flatData(out);
+    forChunks(in.size(), [&](size_t begin, size_t end) {
+        auto b = begin * SIZE;
+        simd::binary(op, x + b, y + b, o + b, (end - begin) * SIZE);
+    });
+}
+
+template <typename ColorList, typename Function>
+void forParts2Simd(ColorList const& in, ValueType<ColorList> const& in2,
+                   ColorList& out, simd::Binary op, Function, std::true_type) {
+    if (out.size() < in.size())
+        out.resize(in.size());
+    static const auto SIZE = ValueType<ColorList>::SIZE;
+    auto x = reinterpret_cast<float const*>(in2.data());
+    auto y = flatData(in);
+    auto o = flatData(out);
+
+    // Chunks start on a sample boundary, so the pattern stays in phase.
+    forChunks(in.size(), [&](size_t begin, size_t end) {
+        auto b = begin * SIZE;
+        simd::periodic(op, x, SIZE, y + b, o + b, (end - begin) * SIZE);
+    });
+}
+
+template <typename ColorList, typename Function>
+void forParts2Simd(ColorList const& in, NumberType<ColorList> const& in2,
+                   ColorList& out, simd::Binary op, Function, std::true_type) {
+    if (out.size() < in.size())
+        out.resize(in.size());
+    static const auto SIZE = ValueType<ColorList>::SIZE;
+    auto y = flatData(in);
+    auto o = flatData(out);
+    forChunks(in.size(), [&](size_t begin, size_t end) {
+        auto b = begin * SIZE;
+        simd::broadcast(op, in2, y + b, o + b, (end - begin) * SIZE);
+    });
+}
+
+template <typename ColorList, typename Input, typename Function>
+void forParts2(ColorList const& in, Input const& in2, ColorList& out,
+               simd::Binary op, Function f) {
+    forParts2Simd(in, in2, out, op, f, IsFlatFloat<ColorList>());
+}
+
+template <typename Sample, typename Function>
+void forParts2(PlanarList<Sample> const& in, PlanarList<Sample> const& in2,
+               PlanarList<Sample>& out, simd::Binary op, Function) {
+    if (out.size() < in.size())
+        out.resize(in.size());
+    forChunks(in.size(), [&](size_t begin, size_t end) {
+        for (size_t j = 0; j < Sample::SIZE; ++j) {
+            simd::binary(op, in2.channel(j) + begin, in.channel(j) + begin,
+                         out.channel(j) + begin, end - begin);
+        }
+    });
+}
+
+template <typename Sample, typename Function>
+void forParts2(PlanarList<Sample> const& in, Sample const& in2,
+               PlanarList<Sample>& out, simd::Binary op, Function) {
+    if (out.size() < in.size())
+        out.resize(in.size());
+    forChunks(in.size(), [&](size_t begin, size_t end) {
+        for (size_t j = 0; j < Sample::SIZE; ++j) {
+            simd::broadcast(op, in2[j], in.channel(j) + begin,
+                            out.channel(j) + begin, end - begin);
+        }
+    });
+}
+
+template <typename Sample, typename Function>
+void forParts2(PlanarList<Sample> const& in, NumberType<Sample> const& in2,
+               PlanarList<Sample>& out, simd::Binary op, Function) {
+    if (out.size() < in.size())
+        out.resize(in.size());
+    forChunks(in.size(), [&](size_t begin, size_t end) {
+        for (size_t j = 0; j < Sample::SIZE; ++j) {
+            simd::broadcast(op, in2, in.channel(j) + begin,
+                            out.channel(j) + begin, end - begin);
+        }
+    });
+}
+
 // Hopefully obsolete.
 template <typename ColorList, typename Func>
 void forEach(ColorList const& in, ColorList& out, Func f) {
@@ -0,0 +1,415 @@
+#pragma once
+
+#include <cstddef>
+
+#include <timedata/base/cpu.h>
+#include <timedata/base/simdMath.h>
+#include <timedata/color/models/hsl.h>
+#include <timedata/color/models/hsv.h>
+
+namespace timedata {
+namespace simd {
+
+/** The models with a hue that have vectorized conversions to and from RGB. */
+enum class HueModel { hsv, hsl, last = hsl };
+
+/** Convert flat arrays of `size` interleaved float samples from RGB to a hue
+    model, or back.
+
+    There's no branch on the hue sector: every sector's result is computed
+    and the right one selected, 8 samples at a time with AVX2 or 16 with
+    AVX-512.  The arithmetic is the same, operation by operation, as
+    convertSample's, so the results are identical to it, NaNs and all -
+    except that a zero may come out with a different sign. */
+void fromRgb(HueModel, float const* rgb, float* out, size_t size);
+void toRgb(HueModel, float const* in, float* rgb, size_t size);
+
+/** The same, at a specific SimdLevel - useful for testing.  SSE2 has no
+    blend instructions, so it uses the scalar converters. */
+void fromRgb(SimdLevel, HueModel, float const* rgb, float* out, size_t size);
+void toRgb(SimdLevel, HueModel, float const* in, float* rgb, size_t size);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+struct ScalarHue {
+    template <typename Color>
+    static void fromRgb(float const* rgb, float* out, size_t n) {
+        for (size_t i = 0; i < n; ++i, rgb += 3, out += 3) {
+            ColorRGB in{rgb[0], rgb[1], rgb[2]};
+            Color c;
+            converter::convertSample(in, c);
+            for (size_t j = 0; j < 3; ++j)
+                out[j] = *c[j];
+        }
+    }
+
+    template <typename Color>
+    static void toRgb(float const* in, float* rgb, size_t n) {
+        for (size_t i = 0; i < n; ++i, in += 3, rgb += 3) {
+            Color c{in[0], in[1], in[2]};
+            ColorRGB out;
+            converter::convertSample(c, out);
+            for (size_t j = 0; j < 3; ++j)
+                rgb[j] = *out[j];
+        }
+    }
+
+    static void fromRgb(HueModel model, float const* rgb, float* out,
+                        size_t n) {
+        if (model == HueModel::hsv)
+            fromRgb<ColorHSV>(rgb, out, n);
+        else
+            fromRgb<ColorHSL>(rgb, out, n);
+    }
+
+    static void toRgb(HueModel model, float const* in, float* rgb, size_t n) {
+        if (model == HueModel::hsv)
+            toRgb<ColorHSV>(in, rgb, n);
+        else
+            toRgb<ColorHSL>(in, rgb, n);
+    }
+};
+
+#if TIMEDATA_SIMD_X86
+
+struct Avx2Hue {
+    using V = __m256;
+    static const size_t WIDTH = 8;
+
+    TIMEDATA_TARGET("avx2")
+    static V select(V mask, V yes, V no) {
+        return _mm256_blendv_ps(no, yes, mask);
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static V abs(V x) {
+        return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static V is(__m256i sector, int i) {
+        return _mm256_castsi256_ps(
+            _mm256_cmpeq_epi32(sector, _mm256_set1_epi32(i)));
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static void rgbToHsv(V r, V g, V b, V& h, V& s, V& v) {
+        auto zero = _mm256_setzero_ps();
+        // max and min return their second operand if either is a NaN, so
+        // the running value goes second to match std::max({r, g, b}).
+        v = _mm256_max_ps(b, _mm256_max_ps(g, r));
+        auto delta = _mm256_sub_ps(v, _mm256_min_ps(b, _mm256_min_ps(g, r)));
+        s = _mm256_div_ps(delta, v);
+
+        auto isRed = _mm256_cmp_ps(v, r, _CMP_EQ_OQ);
+        auto isGreen = _mm256_cmp_ps(v, g, _CMP_EQ_OQ);
+        auto num = select(isRed, _mm256_sub_ps(g, b),
+                          select(isGreen, _mm256_sub_ps(b, r),
+                                 _mm256_sub_ps(r, g)));
+        auto q = _mm256_div_ps(num, delta);
+        h = select(isRed, q, _mm256_add_ps(
+            q, select(isGreen, _mm256_set1_ps(2), _mm256_set1_ps(4))));
+
+        h = _mm256_div_ps(h, _mm256_set1_ps(6));
+        auto negative = _mm256_cmp_ps(h, zero, _CMP_LT_OQ);
+        h = select(negative, _mm256_add_ps(h, _mm256_set1_ps(1)), h);
+
+        auto black = _mm256_cmp_ps(v, zero, _CMP_EQ_OQ);
+        h = _mm256_andnot_ps(black, h);
+        s = _mm256_andnot_ps(black, s);
+        v = _mm256_andnot_ps(black, v);
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static void hsvToRgb(V h, V s, V v, V& r, V& g, V& b) {
+        auto one = _mm256_set1_ps(1);
+        h = _mm256_mul_ps(h, _mm256_set1_ps(6));
+        auto sector = _mm256_cvttps_epi32(h);
+        auto f = _mm256_sub_ps(h, _mm256_cvtepi32_ps(sector));
+
+        auto x = _mm256_mul_ps(v, _mm256_sub_ps(one, s));
+        auto y = _mm256_mul_ps(v, _mm256_sub_ps(one, _mm256_mul_ps(s, f)));
+        auto z = _mm256_mul_ps(v, _mm256_sub_ps(
+            one, _mm256_mul_ps(s, _mm256_sub_ps(one, f))));
+
+        auto s0 = is(sector, 0), s1 = is(sector, 1), s2 = is(sector, 2);
+        auto s3 = is(sector, 3), s4 = is(sector, 4);
+
+        // Sectors 0 to 5 are (v, z, x), (y, v, x), (x, v, z), (x, y, v),
+        // (z, x, v) and (v, x, y); anything else is sector 5.
+        r = select(s1, y, select(_mm256_or_ps(s2, s3), x, select(s4, z, v)));
+        g = select(s0, z, select(_mm256_or_ps(s1, s2), v, select(s3, y, x)));
+        b = select(_mm256_or_ps(s0, s1), x,
+                   select(s2, z, select(_mm256_or_ps(s3, s4), v, y)));
+
+        auto gray = _mm256_cmp_ps(s, _mm256_setzero_ps(), _CMP_EQ_OQ);
+        r = select(gray, v, r);
+        g = select(gray, v, g);
+        b = select(gray, v, b);
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static void hsvToHsl(V s, V v, V& sOut, V& l) {
+        auto one = _mm256_set1_ps(1), two = _mm256_set1_ps(2);
+        l = _mm256_div_ps(_mm256_mul_ps(v, _mm256_sub_ps(two, s)), two);
+        auto divisor = _mm256_sub_ps(
+            one, abs(_mm256_sub_ps(_mm256_mul_ps(two, l), one)));
+        sOut = _mm256_div_ps(_mm256_mul_ps(v, s), divisor);
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static void hslToHsv(V s, V l, V& sOut, V& v) {
+        auto one = _mm256_set1_ps(1), two = _mm256_set1_ps(2);
+        auto t = _mm256_sub_ps(
+            one, abs(_mm256_sub_ps(_mm256_mul_ps(two, l), one)));
+        v = _mm256_div_ps(
+            _mm256_add_ps(_mm256_mul_ps(two, l), _mm256_mul_ps(s, t)), two);
+        sOut = _mm256_div_ps(
+            _mm256_mul_ps(two, _mm256_sub_ps(v, l)), v);
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static void fromRgb(HueModel model, float const* rgb, float* out,
+                        size_t n) {
+        size_t i = 0;
+        for (; i + WIDTH <= n; i += WIDTH) {
+            V r, g, b, h, s, v;
+            Avx2Math::load3(rgb + 3 * i, r, g, b);
+            rgbToHsv(r, g, b, h, s, v);
+            if (model == HueModel::hsl)
+                hsvToHsl(s, v, s, v);
+            Avx2Math::store3(out + 3 * i, h, s, v);
+        }
+        ScalarHue::fromRgb(model, rgb + 3 * i, out + 3 * i, n - i);
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static void toRgb(HueModel model, float const* in, float* rgb, size_t n) {
+        size_t i = 0;
+        for (; i + WIDTH <= n; i += WIDTH) {
+            V h, s, v, r, g, b;
+            Avx2Math::load3(in + 3 * i, h, s, v);
+            if (model == HueModel::hsl)
+                hslToHsv(s, v, s, v);
+            hsvToRgb(h, s, v, r, g, b);
+            Avx2Math::store3(rgb + 3 * i, r, g, b);
+        }
+        ScalarHue::toRgb(model, in + 3 * i, rgb + 3 * i, n - i);
+    }
+};
+
+/** The same as Avx2Hue, with comparisons into mask registers, and scatter
+    stores and masked tails instead of a scalar loop. */
+struct Avx512Hue {
+    using V = __m512;
+    using M = __mmask16;
+    static const size_t WIDTH = 16;
+
+    /** As in Avx512, zero-masked forms with every lane set avoid GCC's
+        warnings about undefined pass-through vectors. */
+    static const M ALL = 0xFFFF;
+
+    /** AVX-512F implies FMA, which the compiler would otherwise fuse our
+        multiplies and adds into, rounding differently from convertSample.
+        An explicit rounding mode stops that. */
+    TIMEDATA_TARGET("avx512f")
+    static V mul(V x, V y) {
+        return _mm512_maskz_mul_round_ps(
+            ALL, x, y, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    TIMEDATA_TARGET("avx512f")
+    static V abs(V x) {
+        return _mm512_castsi512_ps(_mm512_maskz_andnot_epi32(
+            ALL, _mm512_set1_epi32(int32_t(0x80000000)), _mm512_castps_si512(x)));
+    }
+
+    TIMEDATA_TARGET("avx512f")
+    static M is(__m512i sector, int i) {
+        return _mm512_cmpeq_epi32_mask(sector, _mm512_set1_epi32(i));
+    }
+
+    TIMEDATA_TARGET("avx512f")
+    static __m512i index() {
+        return _mm512_setr_epi32(
+            0, 3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 33, 36, 39, 42, 45);
+    }
+
+    TIMEDATA_TARGET("avx512f")
+    static void load(M m, float const* p, V& x, V& y, V& z) {
+        auto zero = _mm512_setzero_ps();
+        x = _mm512_mask_i32gather_ps(zero, m, index(), p, 4);
+        y = _mm512_mask_i32gather_ps(zero, m, index(), p + 1, 4);
+        z = _mm512_mask_i32gather_ps(zero, m, index(), p + 2, 4);
+    }
+
+    TIMEDATA_TARGET("avx512f")
+    static void store(M m, float* p, V x, V y, V z) {
+        _mm512_mask_i32scatter_ps(p, m, index(), x, 4);
+        _mm512_mask_i32scatter_ps(p + 1, m, index(), y, 4);
+        _mm512_mask_i32scatter_ps(p + 2, m, index(), z, 4);
+    }
+
+    TIMEDATA_TARGET("avx512f")
+    static void rgbToHsv(V r, V g, V b, V& h, V& s, V& v) {
+        auto zero = _mm512_setzero_ps();
+        v = _mm512_maskz_max_ps(ALL, b, _mm512_maskz_max_ps(ALL, g, r));
+        auto delta = _mm512_sub_ps(
+            v, _mm512_maskz_min_ps(ALL, b, _mm512_maskz_min_ps(ALL, g, r)));
+        s = _mm512_div_ps(delta, v);
+
+        auto isRed = _mm512_cmp_ps_mask(v, r, _CMP_EQ_OQ);
+        auto isGreen = _mm512_cmp_ps_mask(v, g, _CMP_EQ_OQ);
+        auto num = _mm512_mask_blend_ps(
+            isGreen, _mm512_sub_ps(r, g), _mm512_sub_ps(b, r));
+        num = _mm512_mask_blend_ps(isRed, num, _mm512_sub_ps(g, b));
+        auto q = _mm512_div_ps(num, delta);
+        auto offset = _mm512_mask_blend_ps(
+            isGreen, _mm512_set1_ps(4), _mm512_set1_ps(2));
+        h = _mm512_mask_blend_ps(isRed, _mm512_add_ps(q, offset), q);
+
+        h = _mm512_div_ps(h, _mm512_set1_ps(6));
+        auto negative = _mm512_cmp_ps_mask(h, zero, _CMP_LT_OQ);
+        h = _mm512_mask_add_ps(h, negative, h, _mm512_set1_ps(1));
+
+        auto black = _mm512_cmp_ps_mask(v, zero, _CMP_EQ_OQ);
+        h = _mm512_mask_mov_ps(h, black, zero);
+        s = _mm512_mask_mov_ps(s, black, zero);
+        v = _mm512_mask_mov_ps(v, black, zero);
+    }
+
+    TIMEDATA_TARGET("avx512f")
+    static void hsvToRgb(V h, V s, V v, V& r, V& g, V& b) {
+        auto one = _mm512_set1_ps(1);
+        h = mul(h, _mm512_set1_ps(6));
+        auto sector = _mm512_maskz_cvttps_epi32(ALL, h);
+        auto f = _mm512_sub_ps(h, _mm512_maskz_cvtepi32_ps(ALL, sector));
+
+        auto x = mul(v, _mm512_sub_ps(one, s));
+        auto y = mul(v, _mm512_sub_ps(one, mul(s, f)));
+        auto z = mul(v, _mm512_sub_ps(
+            one, mul(s, _mm512_sub_ps(one, f))));
+
+        auto s0 = is(sector, 0), s1 = is(sector, 1), s2 = is(sector, 2);
+        auto s3 = is(sector, 3), s4 = is(sector, 4);
+
+        // See Avx2Hue::hsvToRgb.
+        r = _mm512_mask_mov_ps(v, s4, z);
+        r = _mm512_mask_mov_ps(r, s2 | s3, x);
+        r = _mm512_mask_mov_ps(r, s1, y);
+        g = _mm512_mask_mov_ps(x, s3, y);
+        g = _mm512_mask_mov_ps(g, s1 | s2, v);
+        g = _mm512_mask_mov_ps(g, s0, z);
+        b = _mm512_mask_mov_ps(y, s3 | s4, v);
+        b = _mm512_mask_mov_ps(b, s2, z);
+        b = _mm512_mask_mov_ps(b, s0 | s1, x);
+
+        auto gray = _mm512_cmp_ps_mask(s, _mm512_setzero_ps(), _CMP_EQ_OQ);
+        r = _mm512_mask_mov_ps(r, gray, v);
+        g = _mm512_mask_mov_ps(g, gray, v);
+        b = _mm512_mask_mov_ps(b, gray, v);
+    }
+
+    TIMEDATA_TARGET("avx512f")
+    static void hsvToHsl(V s, V v, V& sOut, V& l) {
+        auto one = _mm512_set1_ps(1), two = _mm512_set1_ps(2);
+        l = _mm512_div_ps(mul(v, _mm512_sub_ps(two, s)), two);
+        auto divisor = _mm512_sub_ps(
+            one, abs(_mm512_sub_ps(mul(two, l), one)));
+        sOut = _mm512_div_ps(mul(v, s), divisor);
+    }
+
+    TIMEDATA_TARGET("avx512f")
+    static void hslToHsv(V s, V l, V& sOut, V& v) {
+        auto one = _mm512_set1_ps(1), two = _mm512_set1_ps(2);
+        auto t = _mm512_sub_ps(
+            one, abs(_mm512_sub_ps(mul(two, l), one)));
+        v = _mm512_div_ps(
+            _mm512_add_ps(mul(two, l), mul(s, t)), two);
+        sOut = _mm512_div_ps(
+            mul(two, _mm512_sub_ps(v, l)), v);
+    }
+
+    TIMEDATA_TARGET("avx512f")
+    static void fromRgb(HueModel model, float const* rgb, float* out,
+                        size_t n) {
+        for (size_t i = 0; i < n; i += WIDTH) {
+            auto m = static_cast<M>(n - i >= WIDTH ? 0xFFFF :
+                                    (1u << (n - i)) - 1);
+            V r, g, b, h, s, v;
+            load(m, rgb + 3 * i, r, g, b);
+            rgbToHsv(r, g, b, h, s, v);
+            if (model == HueModel::hsl)
+                hsvToHsl(s, v, s, v);
+            store(m, out + 3 * i, h, s, v);
+        }
+    }
+
+    TIMEDATA_TARGET("avx512f")
+    static void toRgb(HueModel model, float const* in, float* rgb, size_t n) {
+        for (size_t i = 0; i < n; i += WIDTH) {
+            auto m = static_cast<M>(n - i >= WIDTH ? 0xFFFF :
+                                    (1u << (n - i)) - 1);
+            V h, s, v, r, g, b;
+            load(m, in + 3 * i, h, s, v);
+            if (model == HueModel::hsl)
+                hslToHsv(s, v, s, v);
+            hsvToRgb(h, s, v, r, g, b);
+            store(m, rgb + 3 * i, r, g, b);
+        }
+    }
+};
+
+#endif  // TIMEDATA_SIMD_X86
+
+inline void fromRgb(SimdLevel level, HueModel model, float const* rgb,
+                    float* out, size_t size) {
+#if TIMEDATA_SIMD_X86
+    switch (level) {
+        case SimdLevel::avx512:
+            return Avx512Hue::fromRgb(model, rgb, out, size);
+        case SimdLevel::avx2:
+            return Avx2Hue::fromRgb(model, rgb, out, size);
+        case SimdLevel::sse2:
+        case SimdLevel::scalar:
+            break;
+    }
+#else
+    (void) level;
+#endif
+    ScalarHue::fromRgb(model, rgb, out, size);
+}
+
+inline void toRgb(SimdLevel level, HueModel model, float const* in,
+                  float* rgb, size_t size) {
+#if TIMEDATA_SIMD_X86
+    switch (level) {
+        case SimdLevel::avx512:
+            return Avx512Hue::toRgb(model, in, rgb, size);
+        case SimdLevel::avx2:
+            return Avx2Hue::toRgb(model, in, rgb, size);
+        case SimdLevel::sse2:
+        case SimdLevel::scalar:
+            break;
+    }
+#else
+    (void) level;
+#endif
+    ScalarHue::toRgb(model, in, rgb, size);
+}
+
+inline void fromRgb(HueModel model, float const* rgb, float* out,
+                    size_t size) {
+    fromRgb(simdLevel(), model, rgb, out, size);
+}
+
+inline void toRgb(HueModel model, float const* in, float* rgb, size_t size) {
+    toRgb(simdLevel(), model, in, rgb, size);
+}
+
+} // simd
+} // timedata
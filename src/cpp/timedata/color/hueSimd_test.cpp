@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include <timedata/base/enum.h>
+#include <timedata/color/hueSimd.h>
+
+namespace timedata {
+namespace simd {
+
+inline std::vector<float> hueTestInputs() {
+    // Includes blacks, grays, each channel as the maximum, out-of-band
+    // values, hues at and past the ends of the circle, and NaNs in each
+    // channel.
+    std::vector<float> x = {
+        0, 0, 0,  0.5f, 0.5f, 0.5f,  1, 1, 1,  1, 0, 0,  0, 1, 0,  0, 0, 1,
+        1, 1, 0,  0, 1, 1,  1, 0, 1,  -0.5f, 0.25f, 2,  1, 0.5f, 0.5f,
+        0.999f, 1, 0.5f,  1.5f, 0.5f, 0.25f,  -0.25f, 1, 1,  0.5f, 0, 0.5f,
+        NAN, 0.5f, 0.2f,  0.2f, 0.5f, NAN,  0.5f, NAN, 0.2f,  0, 0, NAN,
+        NAN, 0, 0,  0, NAN, 0,  NAN, NAN, NAN};
+
+    uint32_t seed = 2017;
+    while (x.size() < 3 * 1003) {
+        seed = seed * 1664525 + 1013904223;
+        x.push_back(((seed >> 8) % 1001) / 1000.0f);
+    }
+    return x;
+}
+
+inline void requireSame(std::vector<float> const& x,
+                        std::vector<float> const& y) {
+    REQUIRE(x.size() == y.size());
+    for (size_t i = 0; i < x.size(); ++i)
+        REQUIRE((x[i] == y[i] or (std::isnan(x[i]) and std::isnan(y[i]))));
+}
+
+TEST_CASE("hue kernels", "hueSimd") {
+    auto in = hueTestInputs();
+    auto size = in.size() / 3;
+
+    forEach<HueModel>([&](HueModel model) {
+        std::vector<float> from(in.size()), to(in.size());
+        ScalarHue::fromRgb(model, in.data(), from.data(), size);
+        ScalarHue::toRgb(model, in.data(), to.data(), size);
+
+        forEach<SimdLevel>([&](SimdLevel level) {
+            if (level > cpuSimdLevel())
+                return;
+            for (auto n: {size, size_t(17), size_t(3)}) {
+                std::vector<float> out(3 * n);
+                fromRgb(level, model, in.data(), out.data(), n);
+                requireSame(out, {from.begin(), from.begin() + 3 * n});
+                toRgb(level, model, in.data(), out.data(), n);
+                requireSame(out, {to.begin(), to.begin() + 3 * n});
+            }
+        });
+    });
+}
+
+TEST_CASE("hue kernels round trip", "hueSimd") {
+    std::vector<float> rgb = {0.25f, 0.5f, 0.75f, 1, 0.5f, 0, 0.1f, 0.9f, 0.3f};
+    forEach<HueModel>([&](HueModel model) {
+        std::vector<float> hue(rgb.size()), back(rgb.size());
+        fromRgb(model, rgb.data(), hue.data(), 3);
+        toRgb(model, hue.data(), back.data(), 3);
+        for (size_t i = 0; i < rgb.size(); ++i)
+            REQUIRE(std::abs(rgb[i] - back[i]) < 1e-6f);
+    });
+}
+
+} // simd
+} // timedata
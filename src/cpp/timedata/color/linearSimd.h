@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+
+#include <timedata/base/cpu.h>
+#include <timedata/base/simdMath.h>
+#include <timedata/color/models/linear.h>
+
+namespace timedata {
+namespace simd {
+
+/** Multiply `size` interleaved triples of floats by a LinearMatrix.
+
+    Each result is computed in the same order as linearTransform, so every
+    SimdLevel gives exactly the same numbers. */
+void transform(LinearMatrix const&, float const* in, float* out, size_t size);
+
+/** The same, at a specific SimdLevel - useful for testing. */
+void transform(SimdLevel, LinearMatrix const&, float const* in, float* out,
+               size_t size);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+struct ScalarLinear {
+    static void transform(LinearMatrix const& matrix, float const* in,
+                          float* out, size_t n) {
+        for (size_t i = 0; i < n; ++i, in += 3, out += 3)
+            linearTransform(matrix, in, out);
+    }
+};
+
+#if TIMEDATA_SIMD_X86
+
+struct Avx2Linear {
+    using V = __m256;
+    using M = Avx2Math;
+    static const size_t WIDTH = 8;
+
+    TIMEDATA_TARGET("avx2")
+    static V row(float const (&m)[3], V x, V y, V z) {
+        return _mm256_add_ps(
+            _mm256_add_ps(_mm256_mul_ps(M::set(m[0]), x),
+                          _mm256_mul_ps(M::set(m[1]), y)),
+            _mm256_mul_ps(M::set(m[2]), z));
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static void transform(LinearMatrix const& matrix, float const* in,
+                          float* out, size_t n) {
+        size_t i = 0;
+        for (; i + WIDTH <= n; i += WIDTH) {
+            V x, y, z;
+            M::load3(in + 3 * i, x, y, z);
+            M::store3(out + 3 * i,
+                      row(matrix.m[0], x, y, z),
+                      row(matrix.m[1], x, y, z),
+                      row(matrix.m[2], x, y, z));
+        }
+        ScalarLinear::transform(matrix, in + 3 * i, out + 3 * i, n - i);
+    }
+};
+
+#endif  // TIMEDATA_SIMD_X86
+
+inline void transform(SimdLevel level, LinearMatrix const& matrix,
+                      float const* in, float* out, size_t size) {
+    TIMEDATA_DISPATCH(level, ScalarLinear, Avx2Linear,
+                      Kernel::transform(matrix, in, out, size));
+}
+
+inline void transform(LinearMatrix const& matrix, float const* in,
+                      float* out, size_t size) {
+    transform(simdLevel(), matrix, in, out, size);
+}
+
+} // simd
+} // timedata
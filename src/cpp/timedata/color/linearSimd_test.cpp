@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include <timedata/base/enum.h>
+#include <timedata/color/linearSimd.h>
+#include <timedata/color/models/xyz.h>
+#include <timedata/color/models/yiq.h>
+#include <timedata/color/models/yuv.h>
+#include <timedata/signal/convertList.h>
+
+namespace timedata {
+namespace simd {
+
+TEST_CASE("linear kernel", "linearSimd") {
+    static constexpr auto matrix = linearMatrix<ColorXYZ, ColorYIQ>();
+    std::vector<float> in;
+    for (size_t i = 0; i < 3 * 101; ++i)
+        in.push_back(((i * 7) % 23) / 11.0f - 0.5f);
+    auto size = in.size() / 3;
+
+    std::vector<float> expected(in.size());
+    ScalarLinear::transform(matrix, in.data(), expected.data(), size);
+
+    forEach<SimdLevel>([&](SimdLevel level) {
+        if (level > cpuSimdLevel())
+            return;
+        for (auto n: {size, size_t(17), size_t(3)}) {
+            std::vector<float> out(3 * n);
+            transform(level, matrix, in.data(), out.data(), n);
+            for (size_t i = 0; i < out.size(); ++i)
+                REQUIRE(out[i] == expected[i]);
+        }
+    });
+}
+
+template <typename SampleIn, typename SampleOut>
+void testLinearMatrix(SampleIn const& in) {
+    ColorRGB rgb;
+    SampleOut chained, composed;
+    converter::convertSample(in, rgb);
+    converter::convertSample(rgb, chained);
+    converter::SampleConverter<SampleIn, SampleOut>::convert(in, composed);
+
+    for (size_t i = 0; i < composed.size(); ++i) {
+        auto x = *chained[i], y = *composed[i];
+        REQUIRE(std::abs(x - y) <= 1e-5f * std::max(1.0f, std::abs(x)));
+    }
+}
+
+TEST_CASE("linear matrices", "linearSimd") {
+    using ColorXYZ255 = Sample<XYZ, Range255<float>>;
+    static_assert(IsLinearSample<ColorXYZ255>::value, "");
+    static_assert(not IsLinearSample<ColorRGB8>::value, "");
+    static_assert(not IsLinearSample<ColorHSV>::value, "");
+
+    // RGB on either side of the matrix is exactly the model's own matrix.
+    static constexpr auto toXyz = linearMatrix<ColorRGB, ColorXYZ>();
+    static constexpr auto fromRgb = LinearModel<XYZ>::fromRgb();
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j)
+            REQUIRE(toXyz.m[i][j] == fromRgb.m[i][j]);
+    }
+
+    ColorXYZ xyz{0.25f, 0.5f, 0.75f};
+    testLinearMatrix<ColorXYZ, ColorYIQ>(xyz);
+    testLinearMatrix<ColorXYZ, ColorYUV>(xyz);
+    testLinearMatrix<ColorYIQ, ColorXYZ>({0.5f, 0.1f, -0.2f});
+    testLinearMatrix<ColorYUV, ColorRGB255>({0.5f, 0.1f, -0.2f});
+    testLinearMatrix<ColorRGB255, ColorXYZ>({64, 128, 255});
+    testLinearMatrix<ColorXYZ255, ColorYIQ>({64, 128, 255});
+}
+
+} // simd
+} // timedata
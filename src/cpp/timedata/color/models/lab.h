@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cmath>
+
+#include <timedata/color/models/rgb.h>
+#include <timedata/signal/convert.h>
+
+namespace timedata {
+
+/** CIELAB, from sRGB with a D65 white point.  Lightness goes from 0 to 100,
+    and a and b are roughly -128 to 128, so the Euclidean distance between
+    two ColorLabs is the CIE76 deltaE, where 2.3 is a just noticeable
+    difference. */
+enum class Lab { lightness, a, b, last = b };
+
+/** CIELAB in polar coordinates: lightness and chroma as in Lab, and the hue
+    goes from 0 to 1, like the hue of HSV. */
+enum class LCh { lightness, chroma, hue, last = hue };
+
+using ColorLab = Sample<Lab>;
+using ColorLCh = Sample<LCh>;
+
+template <> inline std::string className<ColorLab>() { return "ColorLab"; }
+template <> inline std::string className<ColorLCh>() { return "ColorLCh"; }
+
+/** The sRGB transfer functions, between gamma-encoded and linear light. */
+float srgbToLinear(float);
+float linearToSrgb(float);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+// See: https://en.wikipedia.org/wiki/SRGB
+// https://en.wikipedia.org/wiki/CIELAB_color_space
+
+inline float srgbToLinear(float x) {
+    return x <= 0.04045f ? x / 12.92f : std::pow((x + 0.055f) / 1.055f, 2.4f);
+}
+
+inline float linearToSrgb(float x) {
+    return x <= 0.0031308f ? 12.92f * x :
+        1.055f * std::pow(x, 1.0f / 2.4f) - 0.055f;
+}
+
+namespace lab {
+
+/** The matrices between linear sRGB and XYZ, with XYZ divided by the D65
+    white point so that white is (1, 1, 1). */
+static const float RGB_TO_XYZ[3][3] = {
+    {0.4124564f / 0.95047f, 0.3575761f / 0.95047f, 0.1804375f / 0.95047f},
+    {0.2126729f,            0.7151522f,            0.0721750f},
+    {0.0193339f / 1.08883f, 0.1191920f / 1.08883f, 0.9503041f / 1.08883f}};
+
+static const float XYZ_TO_RGB[3][3] = {
+    { 3.2404542f * 0.95047f, -1.5371385f, -0.4985314f * 1.08883f},
+    {-0.9692660f * 0.95047f,  1.8760108f,  0.0415560f * 1.08883f},
+    { 0.0556434f * 0.95047f, -0.2040259f,  1.0572252f * 1.08883f}};
+
+// Below EPSILON, the cube root becomes a straight line.
+static const float EPSILON = 216.0f / 24389.0f;
+static const float DELTA = 6.0f / 29.0f;
+static const float SLOPE = 3.0f * DELTA * DELTA;
+static const float OFFSET = 4.0f / 29.0f;
+
+inline void multiply(float const (&m)[3][3], float const* in, float* out) {
+    for (auto i = 0; i < 3; ++i)
+        out[i] = m[i][0] * in[0] + m[i][1] * in[1] + m[i][2] * in[2];
+}
+
+inline float f(float t) {
+    return t > EPSILON ? std::cbrt(t) : t / SLOPE + OFFSET;
+}
+
+inline float fInverse(float t) {
+    return t > DELTA ? t * t * t : SLOPE * (t - OFFSET);
+}
+
+inline float turns(float y, float x) {
+    static const auto TAU = 6.2831853f;
+    auto h = std::atan2(y, x) / TAU;
+    return h < 0 ? h + 1 : h;
+}
+
+} // lab
+
+namespace converter {
+
+template <>
+inline void convertSample(ColorRGB const& in, ColorLab& out) {
+    float rgb[3], xyz[3];
+    for (auto i = 0; i < 3; ++i)
+        rgb[i] = srgbToLinear(*in[i]);
+    lab::multiply(lab::RGB_TO_XYZ, rgb, xyz);
+    for (auto& x: xyz)
+        x = lab::f(x);
+
+    out[Lab::lightness] = 116.0f * xyz[1] - 16.0f;
+    out[Lab::a] = 500.0f * (xyz[0] - xyz[1]);
+    out[Lab::b] = 200.0f * (xyz[1] - xyz[2]);
+}
+
+template <>
+inline void convertSample(ColorLab const& in, ColorRGB& out) {
+    auto y = (*in[Lab::lightness] + 16.0f) / 116.0f;
+    float xyz[3] = {
+        lab::fInverse(y + *in[Lab::a] / 500.0f),
+        lab::fInverse(y),
+        lab::fInverse(y - *in[Lab::b] / 200.0f)}, rgb[3];
+
+    lab::multiply(lab::XYZ_TO_RGB, xyz, rgb);
+    for (auto i = 0; i < 3; ++i)
+        out[i] = linearToSrgb(rgb[i]);
+}
+
+template <>
+inline void convertSample(ColorLab const& in, ColorLCh& out) {
+    auto a = *in[Lab::a], b = *in[Lab::b];
+    out[LCh::lightness] = in[Lab::lightness];
+    out[LCh::chroma] = std::sqrt(a * a + b * b);
+    out[LCh::hue] = lab::turns(b, a);
+}
+
+template <>
+inline void convertSample(ColorLCh const& in, ColorLab& out) {
+    static const auto TAU = 6.2831853f;
+    auto chroma = *in[LCh::chroma], angle = TAU * *in[LCh::hue];
+    out[Lab::lightness] = in[LCh::lightness];
+    out[Lab::a] = chroma * std::cos(angle);
+    out[Lab::b] = chroma * std::sin(angle);
+}
+
+template <>
+inline void convertSample(ColorRGB const& in, ColorLCh& out) {
+    ColorLab lab;
+    convertSample(in, lab);
+    convertSample(lab, out);
+}
+
+template <>
+inline void convertSample(ColorLCh const& in, ColorRGB& out) {
+    ColorLab lab;
+    convertSample(in, lab);
+    convertSample(lab, out);
+}
+
+} // converter
+} // timedata
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include <timedata/color/models/rgb.h>
+
+namespace timedata {
+
+/** A 3x3 matrix that can be built and multiplied at compile time. */
+struct LinearMatrix {
+    float m[3][3];
+};
+
+constexpr LinearMatrix operator*(LinearMatrix const&, LinearMatrix const&);
+
+/** The matrix that multiplies each row by a number. */
+constexpr LinearMatrix diagonal(float);
+
+/** A model is linear if it is a fixed matrix away from RGB.  Each linear
+    model specializes LinearModel with two constexpr functions, fromRgb() and
+    toRgb(). */
+template <typename Model>
+struct LinearModel : std::false_type {};
+
+template <>
+struct LinearModel<RGB> : std::true_type {
+    static constexpr LinearMatrix fromRgb() {
+        return {{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}};
+    }
+    static constexpr LinearMatrix toRgb() { return fromRgb(); }
+};
+
+/** A Sample is linear if its model is linear and its range only scales
+    floats - so Sample<XYZ, Range255<float>> is linear, but ColorRGB8 and
+    ColorRGBHalf are not. */
+template <typename Sample>
+struct IsLinearSample : std::integral_constant<bool,
+    LinearModel<typename Sample::model_type>::value and
+    std::is_same<typename Sample::number_type, float>::value and
+    Sample::range_type::START == 0> {
+};
+
+/** The matrix that takes the raw numbers of a linear SampleIn straight to
+    the raw numbers of a linear SampleOut, with any change of range folded
+    in, so that a chain like XYZ to RGB255 to YIQ is one multiply. */
+template <typename SampleIn, typename SampleOut>
+constexpr LinearMatrix linearMatrix();
+
+/** Apply a LinearMatrix to one triple of floats. */
+void linearTransform(LinearMatrix const&, float const* in, float* out);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+constexpr float dot(LinearMatrix const& x, LinearMatrix const& y,
+                    size_t i, size_t j) {
+    return x.m[i][0] * y.m[0][j] + x.m[i][1] * y.m[1][j] +
+           x.m[i][2] * y.m[2][j];
+}
+
+} // detail
+
+constexpr LinearMatrix operator*(LinearMatrix const& x,
+                                 LinearMatrix const& y) {
+    using detail::dot;
+    return {{{dot(x, y, 0, 0), dot(x, y, 0, 1), dot(x, y, 0, 2)},
+             {dot(x, y, 1, 0), dot(x, y, 1, 1), dot(x, y, 1, 2)},
+             {dot(x, y, 2, 0), dot(x, y, 2, 1), dot(x, y, 2, 2)}}};
+}
+
+constexpr LinearMatrix diagonal(float x) {
+    return {{{x, 0, 0}, {0, x, 0}, {0, 0, x}}};
+}
+
+template <typename SampleIn, typename SampleOut>
+constexpr LinearMatrix linearMatrix() {
+    using ModelIn = LinearModel<typename SampleIn::model_type>;
+    using ModelOut = LinearModel<typename SampleOut::model_type>;
+
+    return diagonal(SampleOut::range_type::RANGE) * ModelOut::fromRgb() *
+        ModelIn::toRgb() * diagonal(1.0f / SampleIn::range_type::RANGE);
+}
+
+inline void linearTransform(LinearMatrix const& matrix, float const* in,
+                            float* out) {
+    for (size_t i = 0; i < 3; ++i) {
+        auto& m = matrix.m[i];
+        out[i] = m[0] * in[0] + m[1] * in[1] + m[2] * in[2];
+    }
+}
+
+} // timedata
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cmath>
+
+#include <timedata/color/models/lab.h>
+#include <timedata/signal/convert.h>
+
+namespace timedata {
+
+/** Oklab, a perceptual model that predicts hue and lightness better than
+    CIELAB, from sRGB.  Lightness goes from 0 to 1, and a and b are roughly
+    -0.4 to 0.4. */
+enum class Oklab { lightness, a, b, last = b };
+
+using ColorOklab = Sample<Oklab>;
+
+template <> inline std::string className<ColorOklab>() { return "ColorOklab"; }
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+// See: https://bottosson.github.io/posts/oklab/
+
+namespace oklab {
+
+/** Linear sRGB to cone responses, and the cube roots of those to Oklab. */
+static const float RGB_TO_LMS[3][3] = {
+    {0.4122214708f, 0.5363325363f, 0.0514459929f},
+    {0.2119034982f, 0.6806995451f, 0.1073969566f},
+    {0.0883024619f, 0.2817188376f, 0.6299787005f}};
+
+static const float LMS_TO_LAB[3][3] = {
+    {0.2104542553f,  0.7936177850f, -0.0040720468f},
+    {1.9779984951f, -2.4285922050f,  0.4505937099f},
+    {0.0259040371f,  0.7827717662f, -0.8086757660f}};
+
+static const float LAB_TO_LMS[3][3] = {
+    {1.0f,  0.3963377774f,  0.2158037573f},
+    {1.0f, -0.1055613458f, -0.0638541728f},
+    {1.0f, -0.0894841775f, -1.2914855480f}};
+
+static const float LMS_TO_RGB[3][3] = {
+    { 4.0767416621f, -3.3077115913f,  0.2309699292f},
+    {-1.2684380046f,  2.6097574011f, -0.3413193965f},
+    {-0.0041960863f, -0.7034186147f,  1.7076147010f}};
+
+} // oklab
+
+namespace converter {
+
+template <>
+inline void convertSample(ColorRGB const& in, ColorOklab& out) {
+    float rgb[3], lms[3], ok[3];
+    for (auto i = 0; i < 3; ++i)
+        rgb[i] = srgbToLinear(*in[i]);
+    lab::multiply(oklab::RGB_TO_LMS, rgb, lms);
+    for (auto& x: lms)
+        x = std::cbrt(x);
+    lab::multiply(oklab::LMS_TO_LAB, lms, ok);
+    out = {ok[0], ok[1], ok[2]};
+}
+
+template <>
+inline void convertSample(ColorOklab const& in, ColorRGB& out) {
+    float ok[3] = {*in[0], *in[1], *in[2]}, lms[3], rgb[3];
+    lab::multiply(oklab::LAB_TO_LMS, ok, lms);
+    for (auto& x: lms)
+        x = x * x * x;
+    lab::multiply(oklab::LMS_TO_RGB, lms, rgb);
+    for (auto i = 0; i < 3; ++i)
+        out[i] = linearToSrgb(rgb[i]);
+}
+
+} // converter
+} // timedata
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <timedata/base/className.h>
+#include <timedata/base/half.h>
 #include <timedata/signal/sample.h>
 
 namespace timedata {
@@ -12,9 +14,23 @@ using ColorRGB = Sample<RGB>;
 using ColorRGB256 = Sample<RGB, Range256<float>>;
 using ColorRGB255 = Sample<RGB, Range255<float>>;
 
+/** Colors stored as integers, at a quarter or a half of the size of a
+    ColorRGB255.  Arithmetic on them saturates. */
+using ColorRGB8 = Sample<RGB, Range255<uint8_t>>;
+using ColorRGB16 = Sample<RGB, Range65535<uint16_t>>;
+
+/** Normalized colors stored as half precision floats, at half the size of a
+    ColorRGB.  Arithmetic is done in float. */
+using ColorRGBHalf = Sample<RGB, Normal<Half>>;
+
 template <> inline std::string className<ColorRGB>() { return "ColorRGB"; }
 template <> inline std::string className<ColorRGB255>() { return "ColorRGB255"; }
 template <> inline std::string className<ColorRGB256>() { return "ColorRGB256"; }
+template <> inline std::string className<ColorRGB8>() { return "ColorRGB8"; }
+template <> inline std::string className<ColorRGB16>() { return "ColorRGB16"; }
+template <> inline std::string className<ColorRGBHalf>() {
+    return "ColorRGBHalf";
+}
 
 template <typename Sample>
 struct NormalSample {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <timedata/color/models/linear.h>
 #include <timedata/color/models/rgb.h>
 #include <timedata/signal/convert.h>
 
@@ -11,29 +12,39 @@ using ColorXYZ = Sample<XYZ>;
 
 template <> inline std::string className<ColorXYZ>() { return "ColorXYZ"; }
 
-namespace converter {
-
 // See: https://en.wikipedia.org/wiki/XYZ
 
 template <>
-inline void convertSample(ColorRGB const& in, ColorXYZ& out) {
-    static const auto d = 0.17697f;
-    static const float matrix[3][3] = {
-        {0.49f / d, 0.31f   / d, 0.2f     / d},
-        {d     / d, 0.8124f / d, 0.01063f / d},
-        {0.0f  / d, 0.01f   / d, 0.99f    / d}};
+struct LinearModel<XYZ> : std::true_type {
+    static constexpr LinearMatrix fromRgb() {
+        return {{
+            {0.49f / D, 0.31f   / D, 0.2f     / D},
+            {D     / D, 0.8124f / D, 0.01063f / D},
+            {0.0f  / D, 0.01f   / D, 0.99f    / D}}};
+    }
+
+    static constexpr LinearMatrix toRgb() {
+        return {{
+            { 0.41847f,   -0.15866f,  -0.082835f},
+            {-0.091169f,   0.25243f,   0.015708f},
+            { 0.0009209f, -0.0025498f, 0.1786f}}};
+    }
+
+    static constexpr float D = 0.17697f;
+};
+
+namespace converter {
 
-    matrixMultiply(matrix, in, out);
+template <>
+inline void convertSample(ColorRGB const& in, ColorXYZ& out) {
+    static constexpr auto matrix = LinearModel<XYZ>::fromRgb();
+    matrixMultiply(matrix.m, in, out);
 }
 
 template <>
 inline void convertSample(ColorXYZ const& in, ColorRGB& out) {
-    static const float matrix[3][3] = {
-        { 0.41847f,    0.15866f,  -0.082835f},
-        {-0.091169f,   0.25243f,   0.015708f},
-        { 0.0009209f, -0.0025498f, 0.1786f}};
-
-    matrixMultiply(matrix, in, out);
+    static constexpr auto matrix = LinearModel<XYZ>::toRgb();
+    matrixMultiply(matrix.m, in, out);
 }
 
 } // converter
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <timedata/color/models/linear.h>
 #include <timedata/color/models/rgb.h>
 #include <timedata/signal/convert.h>
 
@@ -11,28 +12,37 @@ using ColorYUV = Sample<YUV>;
 
 template <> inline std::string className<ColorYUV>() { return "ColorYUV"; }
 
-namespace converter {
-
 // See: https://en.wikipedia.org/wiki/YUV
 
 template <>
-inline void convertSample(ColorRGB const& in, ColorYUV& out) {
-    static const float matrix[3][3] = {
-        {0.299f,    0.587f,    0.114f},
-        {0.14713f, -0.28886f,  0.436f},
-        {0.615f,   -0.51499f, -0.10001f}};
+struct LinearModel<YUV> : std::true_type {
+    static constexpr LinearMatrix fromRgb() {
+        return {{
+            {0.299f,    0.587f,    0.114f},
+            {-0.14713f, -0.28886f, 0.436f},
+            {0.615f,   -0.51499f, -0.10001f}}};
+    }
+
+    static constexpr LinearMatrix toRgb() {
+        return {{
+            {1.0f,  0.0f,      1.13983f},
+            {1.0f, -0.39465f, -0.58060f},
+            {1.0f,  2.03211f,  0.0f}}};
+    }
+};
+
+namespace converter {
 
-    matrixMultiply(matrix, in, out);
+template <>
+inline void convertSample(ColorRGB const& in, ColorYUV& out) {
+    static constexpr auto matrix = LinearModel<YUV>::fromRgb();
+    matrixMultiply(matrix.m, in, out);
 }
 
 template <>
 inline void convertSample(ColorYUV const& in, ColorRGB& out) {
-    static const float matrix[3][3] = {
-        {1.0f,  0.0f,      1.13983f},
-        {1.0f, -0.39465f, -0.58060f},
-        {1.0f,  2.03211f,  0.0f}};
-
-    matrixMultiply(matrix, in, out);
+    static constexpr auto matrix = LinearModel<YUV>::toRgb();
+    matrixMultiply(matrix.m, in, out);
 }
 
 } // converter
@@ -0,0 +1,129 @@
+#pragma once
+
+// Generated by src/py/timedata_build/names_hash.py from names_table_inl.h.
+// DO NOT EDIT.
+
+#include <cstdint>
+
+namespace timedata {
+namespace names_hash {
+
+static const uint32_t NAME_BUCKETS = 120;
+static const uint32_t NAME_SLOTS = 601;
+static const uint32_t HEX_BUCKETS = 108;
+static const uint32_t HEX_SLOTS = 541;
+
+inline uint16_t const* nameDisplacements() {
+    static const uint16_t table[] = {
+        56, 18, 1, 3, 35, 1, 6, 5, 2, 18, 36, 29, 2, 18, 12, 50, 1, 57, 1, 16,
+        33, 1, 6, 27, 14, 17, 35, 16, 18, 27, 8, 39, 10, 5, 34, 3, 4, 37, 8, 9,
+        4, 32, 2, 18, 1, 1, 21, 2, 3, 29, 4, 1, 2, 1, 1, 30, 17, 8, 51, 18, 7,
+        19, 2, 1, 11, 6, 8, 12, 4, 54, 1, 12, 2, 4, 2, 8, 14, 4, 5, 7, 41, 7,
+        4, 3, 21, 96, 36, 29, 10, 2, 108, 33, 0, 1, 4, 19, 20, 1, 44, 52, 1, 3,
+        1, 1, 1, 3, 118, 197, 1, 1, 17, 5, 9, 8, 23, 12, 164, 4, 39, 14
+    };
+    return table;
+}
+
+inline int16_t const* nameSlots() {
+    static const int16_t table[] = {
+        271, -1, 21, 8, 55, -1, -1, 471, -1, 476, 169, 111, 215, 201, 424, -1,
+        249, 44, 7, 146, 387, 141, 173, -1, -1, 104, -1, 470, 426, 57, 90, 150,
+        -1, 467, 434, 274, 282, 284, -1, 221, 478, 206, 172, 359, 134, 198, -1,
+        -1, 321, 124, 18, 412, -1, 448, -1, 454, 39, 406, 110, 366, 225, 149,
+        -1, -1, -1, 211, -1, 337, 94, -1, -1, 200, -1, 374, -1, 261, 28, -1,
+        393, 87, -1, -1, 399, 417, 138, 139, 235, -1, 132, 71, 213, -1, 24, -1,
+        246, 174, 473, 164, 62, 180, 334, 205, 463, 56, 433, 219, 351, 330,
+        178, 89, 129, 439, 362, 407, 227, 29, 265, 297, 414, 40, 283, 121, 460,
+        202, 25, 165, 63, 77, 41, 161, 306, 324, 381, 382, 410, 187, -1, -1,
+        197, 373, -1, 108, 231, -1, 119, -1, 313, 183, 46, 355, -1, 356, 36,
+        85, 135, 375, -1, 107, 332, 144, 479, 389, 166, 315, 75, 23, 170, 465,
+        278, 342, 45, -1, 358, -1, 5, 208, -1, 126, 480, 400, -1, 143, 182,
+        435, 72, -1, 340, 453, -1, 304, 2, 367, 199, 268, 228, 449, 464, 293,
+        -1, -1, 34, 281, 242, 419, 61, 66, 325, -1, 396, 422, -1, -1, 260, 326,
+        409, -1, 99, 285, -1, -1, 256, 117, 13, 96, 403, 427, 203, -1, 20, 474,
+        275, -1, 429, 299, 128, 436, -1, 233, 344, -1, 378, -1, 370, 352, 47,
+        384, 113, 348, 343, 48, 459, -1, 97, 80, 377, 322, -1, 430, 53, -1, 0,
+        455, 443, -1, -1, 171, 328, 31, 148, 157, -1, 250, 431, 73, 106, -1,
+        214, 175, -1, 84, 245, 189, 49, 222, 477, 237, 186, 451, 456, 413, -1,
+        272, 317, -1, 153, -1, 236, 363, 30, -1, 331, 102, 440, -1, -1, 204,
+        118, 291, 160, 11, -1, -1, 305, -1, 298, 316, 475, 16, 391, -1, 395,
+        411, 212, 78, 386, 295, 52, -1, 162, 462, 195, 368, 120, 339, 441, 276,
+        405, 277, 27, 194, 38, 279, 401, 446, 33, 266, 247, -1, 329, 336, 408,
+        -1, 273, -1, 301, 64, 267, 35, 218, 196, 323, 472, -1, -1, 68, 43, 447,
+        353, 300, -1, 251, 210, -1, 361, 270, 254, 92, -1, 159, 392, -1, 209,
+        86, -1, 450, 14, 333, 244, 314, 404, 81, 364, -1, 376, 296, 98, 103,
+        243, -1, 50, 239, 294, 22, -1, 437, -1, -1, 100, 259, 303, -1, 74, 385,
+        185, -1, -1, 383, 191, 79, -1, 123, -1, 461, 418, 220, 466, 37, 388,
+        155, 287, 156, 341, 286, 255, 310, 302, 432, 307, 252, 147, -1, -1,
+        360, -1, 354, 309, 442, -1, 457, 308, 320, 223, 93, 394, 188, 114, -1,
+        -1, 428, -1, -1, 380, 59, 469, 151, 226, 184, 158, 290, 346, -1, 122,
+        -1, 190, 133, 345, 60, 349, -1, 32, 229, 452, 10, 101, -1, 421, 127,
+        -1, 248, 232, 91, 65, 131, 372, 288, 289, -1, 15, 264, 240, 263, -1,
+        217, 70, 350, 105, 369, 95, 4, 177, 365, 312, 109, 3, 88, 152, 319,
+        253, -1, 224, 230, 154, 416, 292, 318, 140, 17, 425, 241, 258, 83, -1,
+        390, 445, 112, 438, -1, 311, -1, 69, 6, 19, 397, 176, 67, 402, -1, 115,
+        398, 42, -1, 357, 54, 347, -1, 9, 167, 335, 142, 257, -1, 130, 379,
+        458, -1, 468, 26, 423, 371, 193, -1, 216, 136, 238, 145, 1, -1, 137,
+        125, -1, 262, 58, 207, 163, 116, 76, 415, 234, 179, 168, 338, 444, 269,
+        280, 12, 181, 51, 82, 420, 192, 327
+    };
+    return table;
+}
+
+inline uint16_t const* hexDisplacements() {
+    static const uint16_t table[] = {
+        17, 14, 40, 10, 2, 5, 1, 12, 3, 17, 13, 1, 1, 2, 13, 6, 2, 2, 8, 6, 1,
+        2, 21, 6, 24, 1, 1, 17, 4, 11, 8, 20, 2, 10, 40, 1, 10, 1, 5, 34, 17,
+        3, 4, 14, 43, 5, 30, 33, 4, 4, 33, 115, 4, 60, 35, 29, 4, 8, 10, 1, 80,
+        1, 15, 85, 1, 1, 2, 3, 36, 44, 20, 16, 121, 5, 10, 2, 1, 52, 69, 6, 9,
+        9, 2, 69, 1, 1, 1, 10, 2, 1, 0, 2, 139, 4, 73, 170, 1, 12, 3, 20, 8, 1,
+        15, 2, 9, 10, 41, 83
+    };
+    return table;
+}
+
+inline int16_t const* hexSlots() {
+    static const int16_t table[] = {
+        56, -1, 24, 89, 366, 473, 193, 176, 67, 68, 46, 297, 350, -1, 354, 408,
+        183, 469, 88, 165, -1, 19, 281, 223, 396, 364, 317, -1, 191, 21, 195,
+        298, -1, 479, 454, 268, -1, 188, 466, 139, 310, 274, 423, -1, 461, 26,
+        -1, -1, 47, 347, 307, 156, 140, 239, 435, 405, -1, 27, -1, 150, 58,
+        404, 87, 352, 292, 104, 18, 92, 309, -1, -1, 81, 118, 360, 433, 116,
+        362, 321, 449, 464, 25, 50, 207, -1, 406, 3, 34, -1, 431, 75, -1, 256,
+        459, 200, 99, 180, 119, 334, -1, 472, 333, 414, -1, 166, 250, 48, -1,
+        189, 465, 126, 98, 36, 467, -1, 32, 182, 112, 238, 235, -1, 372, -1,
+        327, 167, 452, 240, 427, 82, -1, 31, 283, 443, 109, 412, 52, 113, -1,
+        194, 210, 2, 1, 315, 458, 440, -1, 72, 213, 370, 358, 102, 303, 335,
+        128, -1, 172, 197, 146, 214, -1, 269, 434, 154, -1, 148, -1, 478, 5,
+        163, 402, 450, -1, 323, 252, 267, 456, 363, 39, 379, 394, 259, 377,
+        237, 177, 192, 38, -1, -1, 111, 264, 407, 422, 432, 106, 23, 110, -1,
+        234, 65, 273, 64, -1, 425, 441, -1, 328, 438, 33, 316, 231, -1, -1,
+        445, -1, -1, 228, 463, 151, 401, -1, 385, -1, 186, 367, -1, 357, 245,
+        418, 369, 17, 136, -1, 145, 290, 295, -1, 203, 35, 57, 411, 302, 419,
+        462, 42, 437, 159, 132, 429, 336, -1, 332, 446, 313, 90, 340, -1, -1,
+        361, 353, 229, 175, 160, 196, 318, 400, 16, 122, 202, 220, 266, 218,
+        114, 383, 471, 227, 73, -1, 308, 86, 7, 85, -1, 272, -1, 455, 457, -1,
+        -1, 0, 253, 428, 49, 480, -1, 249, 84, 69, 123, 168, 9, -1, 178, 45,
+        70, 230, -1, -1, 60, 161, 242, 206, 320, -1, 74, 387, 474, 448, 261,
+        -1, 348, -1, 393, 286, 95, 287, 97, 447, 162, 390, 324, 217, 395, 147,
+        378, 285, 460, 138, 278, 475, 376, -1, 279, 51, 212, 430, 341, 444,
+        101, 152, 339, 141, 420, 277, 410, 198, 222, 91, 127, -1, 103, 14, 144,
+        359, 344, 403, -1, 246, 63, 134, -1, -1, 208, 453, -1, -1, 107, 219,
+        349, 224, 43, 248, 260, 11, 133, 330, -1, -1, 157, 289, 312, 337, 15,
+        304, 225, 299, -1, 375, -1, -1, -1, 100, 306, 380, 421, 254, 62, 338,
+        382, 59, 66, 4, -1, 79, 436, 78, -1, -1, -1, -1, 381, -1, -1, 77, 185,
+        54, 173, -1, -1, 37, 413, 121, -1, 265, 291, 215, 137, -1, 345, 125,
+        355, 368, 221, -1, -1, 204, 342, 12, 130, 120, 174, 477, -1, 409, 322,
+        -1, 373, -1, 296, -1, 158, 211, 391, -1, 236, 96, 351, -1, 365, -1,
+        142, 424, -1, -1, 179, 416, 386, 388, 184, 343, 392, -1, 468, 76, 117,
+        41, 243, -1, 241, 384, 226, 131, 301, 155, 94, 115, -1, 105, 398, 55,
+        30, 201, 325, -1, 293, 40, -1, -1, -1, 470, 143, 417, 263, -1, 415, 83,
+        190, 258, 275, 244, 280, 329, -1, -1, 247, 232, 439, -1, 356, 108, 44,
+        22, -1, -1, -1, 181, 271, 389, 209, 326, 276, 170, 270
+    };
+    return table;
+}
+
+} // names_hash
+} // timedata
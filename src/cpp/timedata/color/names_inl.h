@@ -1,10 +1,11 @@
 #pragma once
 
-#include <stdlib.h>
+#include <string.h>
 #include <algorithm>
-#include <iomanip>
-#include <iostream>
-#include <map>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 #include <timedata/base/enum.h>
 #include <timedata/base/math_inl.h>
@@ -30,46 +31,161 @@ void hexToColor(unsigned hex, Color& out) {
     converter::convertSample(c, out);
 };
 
-inline float strtof(const char *nptr, char const **endptr) {
-    char* ep;
-    auto r = ::strtof(nptr, &ep);
-    *endptr = ep;
-    return r;
+inline bool isSpace(char c) {
+    return c == ' ' or c == '\t' or c == '\n' or c == '\r' or
+        c == '\f' or c == '\v';
 }
 
-inline bool getHexFromName(char const* name, unsigned& hex) {
-    auto i = colorMap().find(name);
-    if (i != colorMap().end())
-        hex = i->second;
-    else if (not fromHexWithPrefix(name, hex))
-        return false;
+inline bool isDigit(char c) {
+    return c >= '0' and c <= '9';
+}
+
+inline void trim(char const*& begin, char const*& end) {
+    for (; begin != end and isSpace(*begin); ++begin);
+    for (; end != begin and isSpace(end[-1]); --end);
+}
+
+/** If [p, end) starts with `word`, in any case, advance p past it. */
+inline bool skipWord(char const*& p, char const* end, char const* word) {
+    auto q = p;
+    for (; *word; ++word, ++q) {
+        if (q == end or (*q | 0x20) != *word)
+            return false;
+    }
+    p = q;
     return true;
 }
 
-template <typename Color>
-bool colorFromCommaSeparated(char const* p, Color& color) {
-    auto getNumber = [&]() {
-        auto x = strtof(p, &p);
-        skipSpaces(p);
-        return static_cast<float>(x);
-    };
-
-    color[0] = getNumber();
-    if (*p++ != ',')
+/** Parse a decimal number like `-1.5e3` from the front of [p, end),
+    advancing p past it.  Like strtod, it also takes nan, inf and infinity,
+    in any case. */
+inline bool parseNumber(char const*& p, char const* end, float& result) {
+    static const double POWERS[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    static const int MAX_POWER = 22, MAX_DIGITS = 19;
+
+    auto negative = p != end and *p == '-';
+    if (p != end and (*p == '-' or *p == '+'))
+        ++p;
+
+    if (skipWord(p, end, "nan")) {
+        result = negative ? -NAN : NAN;
+        return true;
+    }
+    if (skipWord(p, end, "inf")) {
+        skipWord(p, end, "inity");
+        result = negative ? -INFINITY : INFINITY;
+        return true;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0, exponent = 0;
+    bool any = false;
+    for (; p != end and isDigit(*p); ++p, any = true) {
+        if (digits < MAX_DIGITS) {
+            mantissa = 10 * mantissa + (*p - '0');
+            digits += bool(mantissa);
+        } else {
+            ++exponent;
+        }
+    }
+    if (p != end and *p == '.') {
+        for (++p; p != end and isDigit(*p); ++p, any = true) {
+            if (digits < MAX_DIGITS) {
+                mantissa = 10 * mantissa + (*p - '0');
+                digits += bool(mantissa);
+                --exponent;
+            }
+        }
+    }
+    if (not any)
         return false;
 
-    color[1] = getNumber();
-    if (*p++ != ',')
+    if (p != end and (*p == 'e' or *p == 'E')) {
+        ++p;
+        auto negativeExponent = p != end and *p == '-';
+        if (p != end and (*p == '-' or *p == '+'))
+            ++p;
+        if (p == end or not isDigit(*p))
+            return false;
+        int e = 0;
+        for (; p != end and isDigit(*p); ++p)
+            e = std::min(10 * e + (*p - '0'), 1000);
+        exponent += negativeExponent ? -e : e;
+    }
+
+    double x = static_cast<double>(mantissa);
+    if (exponent < -MAX_POWER or exponent > MAX_POWER)
+        x *= std::pow(10.0, exponent);
+    else if (exponent < 0)
+        x /= POWERS[-exponent];
+    else
+        x *= POWERS[exponent];
+
+    result = static_cast<float>(negative ? -x : x);
+    return true;
+}
+
+inline int hexDigit(char c) {
+    if (c >= '0' and c <= '9')
+        return c - '0';
+    if (c >= 'a' and c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' and c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+/** Six hex digits, optionally prefixed by # or 0x. */
+inline bool parseHex(char const* p, char const* end, unsigned& hex) {
+    if (p != end and *p == '#')
+        ++p;
+    else if (end - p > 2 and p[0] == '0' and (p[1] == 'x' or p[1] == 'X'))
+        p += 2;
+
+    if (end - p != 6)
         return false;
 
-    color[2] = getNumber();
-    return not *p;
+    hex = 0;
+    for (; p != end; ++p) {
+        auto d = hexDigit(*p);
+        if (d < 0)
+            return false;
+        hex = 16 * hex + static_cast<unsigned>(d);
+    }
+    return true;
+}
+
+inline bool getHexFromName(char const* begin, char const* end,
+                           unsigned& hex) {
+    uint32_t h;
+    if (not colorHexFromName(begin, end, h))
+        return parseHex(begin, end, hex);
+    hex = h;
+    return true;
 }
 
 template <typename Color>
-bool colorFromHex(char const* name, Color& color) {
+bool colorFromCommaSeparated(char const* p, char const* end, Color& color) {
+    for (size_t i = 0; i < 3; ++i) {
+        trim(p, end);
+        float x;
+        if (not parseNumber(p, end, x))
+            return false;
+        color[i] = x;
+
+        trim(p, end);
+        if (i < 2 and (p == end or *p++ != ','))
+            return false;
+    }
+    return p == end;
+}
+
+template <typename Color>
+bool colorFromHex(char const* begin, char const* end, Color& color) {
     unsigned hex;
-    if (not getHexFromName(name, hex))
+    if (not getHexFromName(begin, end, hex))
         return false;
 
     hexToColor(hex, color);
@@ -77,56 +193,133 @@ bool colorFromHex(char const* name, Color& color) {
 }
 
 template <typename Color>
-bool colorFromGray(char const* name, Color& result) {
-    // Special case for grey and gray.
-    if (not (strstr(name, "gray ") or strstr(name, "grey ")))
+bool colorFromGray(char const* p, char const* end, Color& result) {
+    // Special case for "gray 50" and "grey 50".
+    if (end - p < 5 or not (std::equal(p, p + 4, "gray") or
+                            std::equal(p, p + 4, "grey"))) {
+        return false;
+    }
+    if (p[4] != ' ' and p[4] != '_')
         return false;
 
-    char* endptr;
-    auto gray = Color::value_type::scale(strtod(name + 5, &endptr) / 100);
-    if (*endptr)
+    p += 5;
+    float percent;
+    if (not parseNumber(p, end, percent) or p != end)
         return false;
+
+    auto gray = Color::value_type::scale(percent / 100);
     result = {gray, gray, gray};
     return true;
 }
 
 template <typename Color>
-bool toColorNonNegative(char const* name, Color& result) {
-    return colorFromHex(name, result) or
-        colorFromGray(name, result) or
-        colorFromCommaSeparated(name, result);
+bool toColorNonNegative(char const* begin, char const* end, Color& result) {
+    return colorFromHex(begin, end, result) or
+        colorFromGray(begin, end, result) or
+        colorFromCommaSeparated(begin, end, result);
 }
 
+inline char const* specBegin(std::string const& s) { return s.data(); }
+inline char const* specEnd(std::string const& s) {
+    return s.data() + s.size();
+}
+
+inline char const* specBegin(char const* s) { return s; }
+inline char const* specEnd(char const* s) { return s + strlen(s); }
+
 } // detail
 
+/** Parse one color spec in [begin, end), which needn't be null-terminated,
+    in one pass and without allocating.
+
+    A spec is a color name, with underscores or spaces; six hex digits,
+    optionally prefixed with # or 0x; "gray" or "grey" followed by a
+    percentage; or three comma-separated numbers.  Any of these can be
+    followed by exactly three + or - signs, to negate components. */
 template <typename Color>
-bool toColor(char const* name, Color& result) {
-    // HACK: replace _ with spaces.  Fix once we're done.
-    std::string nameS = name;
-    for (auto& c: nameS)
-        if (c == '_')
-            c = ' ';
-    name = nameS.c_str();
+bool parseColor(char const* begin, char const* end, Color& result) {
+    detail::trim(begin, end);
 
     auto isSign = [](char ch) { return ch == '-' or ch == '+'; };
-    auto len = strlen(name), end = len;
-    for (; end > 0 && isSign(name[end - 1]); --end);
+    auto body = end;
+    for (; body != begin and isSign(body[-1]); --body);
 
-    if (end == len)
-        return detail::toColorNonNegative(name, result);
+    if (body == end)
+        return detail::toColorNonNegative(begin, end, result);
 
-    if ((not end) or len - end != 3)
+    if (body == begin or end - body != 3)
         return false;
 
-    std::string n(name, len - 3);
-    if (not detail::toColorNonNegative(n.c_str(), result))
+    if (not detail::toColorNonNegative(begin, body, result))
         return false;
 
     for (auto i = 0; i < 3; ++i) {
-        if (name[len - 3 + i] == '-')
+        if (body[i] == '-')
             result[i] = - result[i];
     }
     return true;
 }
 
+template <typename Color>
+bool toColor(char const* name, Color& result) {
+    return parseColor(name, name + strlen(name), result);
+}
+
+/** A color spec that couldn't be parsed by parseColors. */
+struct ColorParseError {
+    /** Which spec it was. */
+    size_t index;
+
+    /** Where the spec starts in the buffer - or 0 for a sequence. */
+    size_t offset;
+};
+
+/** Parse a sequence of color specs - std::strings or C strings - into a
+    list, one color for each spec.
+
+    Specs that don't parse become black, and are reported in `errors`.
+    Returns true if every spec parsed.  Reusing `out` and `errors` means no
+    allocation at all. */
+template <typename Specs, typename ColorList>
+bool parseColors(Specs const& specs, ColorList& out,
+                 std::vector<ColorParseError>& errors) {
+    using Color = ValueType<ColorList>;
+    out.clear();
+    errors.clear();
+
+    size_t index = 0;
+    for (auto& spec: specs) {
+        out.emplace_back();
+        auto b = detail::specBegin(spec), e = detail::specEnd(spec);
+        if (not parseColor(b, e, out.back())) {
+            out.back() = Color();
+            errors.push_back({index, 0});
+        }
+        ++index;
+    }
+    return errors.empty();
+}
+
+/** Parse a buffer of color specs separated by `delimiter` - for example,
+    one per line - into a list.  A delimiter at the very end is ignored.
+    Otherwise the same as parseColors for a sequence. */
+template <typename ColorList>
+bool parseColors(char const* begin, char const* end, char delimiter,
+                 ColorList& out, std::vector<ColorParseError>& errors) {
+    using Color = ValueType<ColorList>;
+    out.clear();
+    errors.clear();
+
+    for (auto spec = begin; spec != end; ) {
+        auto next = std::find(spec, end, delimiter);
+        out.emplace_back();
+        if (not parseColor(spec, next, out.back())) {
+            out.back() = Color();
+            errors.push_back({out.size() - 1, size_t(spec - begin)});
+        }
+        spec = (next == end) ? end : next + 1;
+    }
+    return errors.empty();
+}
+
 }  // timedata
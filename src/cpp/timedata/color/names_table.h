@@ -1,25 +1,40 @@
 #pragma once
 
-#include <map>
-#include <set>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace timedata {
 
-using ColorMap = std::map<std::string, uint32_t>;
-using ColorMapInverse = std::map<int, std::string>;
-using ColorNames = std::set<std::string>;
+struct ColorName {
+    char const* name;
+    uint32_t hex;
 
-/** Names of hex colors we recognize. */
-ColorMap const& colorMap();
+    /** Secondary names are alternatives, like "aqua" for "cyan", which are
+        never used when turning a color back into a name. */
+    bool secondary;
+};
 
-/** Names of hex colors we recognize. */
-std::vector<std::string> const& colorNames();
+static const size_t COLOR_NAME_COUNT = 481;
+
+/** All the named colors we recognize, sorted by name.  The table is
+    constant-initialized, so it costs nothing at startup. */
+ColorName const* colorNameTable();
+
+/** Look up the hex value of a color name in O(1), through a perfect hash
+    table.  Returns false if there's no such name. */
+bool colorHexFromName(char const* name, uint32_t& hex);
 
-/** Best inverse of color map, taking into account secondaryColors. */
-ColorMapInverse const& colorMapInverse();
+/** The same for the name in [begin, end), which needn't be null-terminated,
+    reading underscores as spaces. */
+bool colorHexFromName(char const* begin, char const* end, uint32_t& hex);
 
-/** Alternate color names we recognize. */
-ColorNames const& secondaryColors();
+/** Look up the best name for a hex color in O(1), ignoring secondary names.
+    Returns nullptr if there's no such color. */
+char const* colorNameFromHex(uint32_t hex);
+
+/** Names of hex colors we recognize, sorted. */
+std::vector<std::string> const& colorNames();
 
 }  // timedata
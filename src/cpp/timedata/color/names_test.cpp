@@ -1,9 +1,148 @@
 #pragma once
 
+#include <timedata/color/cython_list_inl.h>
 #include <timedata/color/names_inl.h>
 
 namespace timedata {
 namespace color {
 
+static_assert(names_hash::hash("red", 0) == names_hash::hash("red", 0) and
+              names_hash::hash("red", 0) != names_hash::hash("red", 1),
+              "Color name hashes must be usable at compile time");
+
+TEST_CASE("colorNames", "names") {
+    REQUIRE(colorNames().size() == COLOR_NAME_COUNT);
+    REQUIRE(std::is_sorted(colorNames().begin(), colorNames().end()));
+
+    size_t primaries = 0;
+    for (size_t i = 0; i < COLOR_NAME_COUNT; ++i) {
+        auto& entry = colorNameTable()[i];
+        uint32_t hex = 0;
+        REQUIRE(colorHexFromName(entry.name, hex));
+        REQUIRE(hex == entry.hex);
+
+        auto name = colorNameFromHex(entry.hex);
+        REQUIRE(name);
+        if (not entry.secondary) {
+            REQUIRE(std::string(name) == entry.name);
+            ++primaries;
+        }
+    }
+    REQUIRE(primaries == 433);
+
+    uint32_t hex;
+    for (auto name: {"", "rex", "red 5", "Red", "aqua ", "alice blu"})
+        REQUIRE(not colorHexFromName(name, hex));
+    REQUIRE(std::string(colorNameFromHex(0x00ffff)) == "cyan");
+    REQUIRE(not colorNameFromHex(0x123456));
+}
+
+TEST_CASE("parseColor", "names") {
+    auto parses = [](char const* s, float r, float g, float b) {
+        ColorRGB255 c;
+        return toColor(s, c) and c == ColorRGB255(r, g, b);
+    };
+    auto fails = [](char const* s) {
+        ColorRGB255 c;
+        return not toColor(s, c);
+    };
+
+    REQUIRE(parses("red", 255, 0, 0));
+    REQUIRE(parses("  alice_blue ", 240, 248, 255));
+    REQUIRE(parses("#ff8000", 255, 128, 0));
+    REQUIRE(parses("0X0080FF", 0, 128, 255));
+    REQUIRE(parses("gray 50", 127.5f, 127.5f, 127.5f));
+    REQUIRE(parses("grey_10", 25.5f, 25.5f, 25.5f));
+    REQUIRE(parses("1, 2.5,-3e1", 1, 2.5f, -30));
+    REQUIRE(parses(".5,0.25,100.", 0.5f, 0.25f, 100));
+    REQUIRE(parses("red-+-", -255, 0, 0));
+
+    ColorRGB special;
+    REQUIRE(toColor("inf, -Infinity, +INF", special));
+    REQUIRE(*special[0] == INFINITY);
+    REQUIRE(*special[1] == -INFINITY);
+    REQUIRE(*special[2] == INFINITY);
+    REQUIRE(toColor("nan, -NaN, 0", special));
+    REQUIRE(std::isnan(*special[0]));
+    REQUIRE(std::isnan(*special[1]));
+
+    for (auto s: {"", "rex", "#ff80", "#ff800g", "gray 5x", "gray x", "1, 2",
+                  "1, 2, 3, 4", "1,, 2, 3", "red--", "+++", "1e, 2, 3",
+                  "in, 0, 0", "nana, 0, 0", "infinit, 0, 0"}) {
+        REQUIRE(fails(s));
+    }
+}
+
+TEST_CASE("parseColors", "names") {
+    ColorRGB::List colors;
+    std::vector<ColorParseError> errors;
+
+    std::vector<std::string> specs{"red", "bogus", "0, 0.5, 1", "gray 100"};
+    REQUIRE(not parseColors(specs, colors, errors));
+    REQUIRE(colors.size() == 4);
+    REQUIRE(colors[0] == ColorRGB(1, 0, 0));
+    REQUIRE(colors[1] == ColorRGB());
+    REQUIRE(colors[2] == ColorRGB(0, 0.5f, 1));
+    REQUIRE(colors[3] == ColorRGB(1, 1, 1));
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].index == 1);
+
+    std::string buffer = "red\n1, 0, 0\nnope\n\n#0000ff\n";
+    auto b = buffer.data();
+    REQUIRE(not parseColors(b, b + buffer.size(), '\n', colors, errors));
+    REQUIRE(colors.size() == 5);
+    REQUIRE(colors[1] == colors[0]);
+    REQUIRE(colors[4] == ColorRGB(0, 0, 1));
+    REQUIRE(errors.size() == 2);
+    REQUIRE(errors[0].index == 2);
+    REQUIRE(errors[0].offset == 12);
+    REQUIRE(errors[1].index == 3);
+
+    char const* good[] = {"blue", "green"};
+    REQUIRE(parseColors(good, colors, errors));
+    REQUIRE(errors.empty());
+    REQUIRE(colors[1] == ColorRGB(0, 1, 0));
+
+    // What a ColorList does when it's made or extended from strings.
+    REQUIRE(color_list::extendStrings({"red", "1, 1, 1"}, colors) == -1);
+    REQUIRE(colors.size() == 4);
+    REQUIRE(colors[3] == ColorRGB(1, 1, 1));
+    REQUIRE(color_list::extendStrings({"red", "bogus"}, colors) == 1);
+    REQUIRE(colors.size() == 4);
+}
+
+TEST_CASE("listToString", "names") {
+    color_list::CColorListRGB colors;
+    for (auto i = 0; i < 1000; ++i) {
+        auto x = i / 999.0f;
+        colors.push_back({x, x, x});
+        colors.push_back({x, 1.0f - x, 0.5f});
+        colors.push_back({-x, 0.0f, 0.0f});
+    }
+
+    std::string expected = "(";
+    for (auto& c: colors) {
+        if (expected.size() > 1)
+            expected += ", ";
+        auto s = colorToString(c);
+        auto isTriple = s.find(",") != std::string::npos;
+        expected += (isTriple ? "(" : "'") + s + (isTriple ? ")" : "'");
+    }
+    expected += ")";
+
+    REQUIRE(color_list::toString(colors) == expected);
+
+    auto saved = parallelism();
+    parallelism().threshold = 1;
+    parallelism().grain = 37;
+    auto parallel = color_list::toString(colors);
+    parallelism() = saved;
+    REQUIRE(parallel == expected);
+
+    REQUIRE(color_list::toString(color_list::CColorListRGB()) == "()");
+    REQUIRE(color_list::toString(color_list::CColorListRGB{{1, 0, 0}}) ==
+            "('red')");
+}
+
 } // color
 } // timedata
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+#include <timedata/base/cpu.h>
+#include <timedata/base/simdMath.h>
+#include <timedata/color/models/lab.h>
+#include <timedata/color/models/oklab.h>
+
+namespace timedata {
+namespace simd {
+
+/** The perceptual models, which have vectorized conversions to and from
+    RGB. */
+enum class PerceptualModel { lab, lch, oklab, last = oklab };
+
+/** Convert flat arrays of `size` interleaved float samples from RGB to a
+    perceptual model, or back.
+
+    With AVX2 or better, eight samples are done at a time with polynomial
+    approximations of the gamma curves, cube roots and trigonometry.  The
+    results are within 1e-4 of convertSample's, relative to the range of
+    each component. */
+void fromRgb(PerceptualModel, float const* rgb, float* out, size_t size);
+void toRgb(PerceptualModel, float const* in, float* rgb, size_t size);
+
+/** The same, at a specific SimdLevel - useful for testing. */
+void fromRgb(SimdLevel, PerceptualModel, float const* rgb, float* out,
+             size_t size);
+void toRgb(SimdLevel, PerceptualModel, float const* in, float* rgb,
+           size_t size);
+
+/** out[i] is the Euclidean distance between the i-th triples of x and y -
+    which for two arrays of ColorLab is the CIE76 deltaE. */
+void deltaE(float const* x, float const* y, float* out, size_t size);
+void deltaE(SimdLevel, float const* x, float const* y, float* out,
+            size_t size);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+struct ScalarPerceptual {
+    template <typename Color>
+    static void fromRgb(float const* rgb, float* out, size_t n) {
+        for (size_t i = 0; i < n; ++i, rgb += 3, out += 3) {
+            ColorRGB in{rgb[0], rgb[1], rgb[2]};
+            Color c;
+            converter::convertSample(in, c);
+            for (size_t j = 0; j < 3; ++j)
+                out[j] = *c[j];
+        }
+    }
+
+    template <typename Color>
+    static void toRgb(float const* in, float* rgb, size_t n) {
+        for (size_t i = 0; i < n; ++i, in += 3, rgb += 3) {
+            Color c{in[0], in[1], in[2]};
+            ColorRGB out;
+            converter::convertSample(c, out);
+            for (size_t j = 0; j < 3; ++j)
+                rgb[j] = *out[j];
+        }
+    }
+
+    static void fromRgb(PerceptualModel model, float const* rgb, float* out,
+                        size_t n) {
+        switch (model) {
+            case PerceptualModel::lab:
+                return fromRgb<ColorLab>(rgb, out, n);
+            case PerceptualModel::lch:
+                return fromRgb<ColorLCh>(rgb, out, n);
+            case PerceptualModel::oklab:
+                return fromRgb<ColorOklab>(rgb, out, n);
+        }
+    }
+
+    static void toRgb(PerceptualModel model, float const* in, float* rgb,
+                      size_t n) {
+        switch (model) {
+            case PerceptualModel::lab:
+                return toRgb<ColorLab>(in, rgb, n);
+            case PerceptualModel::lch:
+                return toRgb<ColorLCh>(in, rgb, n);
+            case PerceptualModel::oklab:
+                return toRgb<ColorOklab>(in, rgb, n);
+        }
+    }
+
+    static void deltaE(float const* x, float const* y, float* out,
+                       size_t n) {
+        for (size_t i = 0; i < n; ++i, x += 3, y += 3) {
+            auto d0 = x[0] - y[0], d1 = x[1] - y[1], d2 = x[2] - y[2];
+            out[i] = std::sqrt(d0 * d0 + d1 * d1 + d2 * d2);
+        }
+    }
+};
+
+#if TIMEDATA_SIMD_X86
+
+struct Avx2Perceptual {
+    using V = __m256;
+    using M = Avx2Math;
+    static const size_t WIDTH = 8;
+
+    TIMEDATA_TARGET("avx2")
+    static void multiply(float const (&m)[3][3], V& x, V& y, V& z) {
+        V in[3] = {x, y, z}, out[3];
+        for (auto i = 0; i < 3; ++i) {
+            out[i] = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(M::set(m[i][0]), in[0]),
+                              _mm256_mul_ps(M::set(m[i][1]), in[1])),
+                _mm256_mul_ps(M::set(m[i][2]), in[2]));
+        }
+        x = out[0];
+        y = out[1];
+        z = out[2];
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static V srgbToLinear(V x) {
+        auto linear = _mm256_cmp_ps(x, M::set(0.04045f), _CMP_LE_OQ);
+        auto base = _mm256_div_ps(_mm256_add_ps(x, M::set(0.055f)),
+                                  M::set(1.055f));
+        return M::select(linear, _mm256_div_ps(x, M::set(12.92f)),
+                         M::pow(base, 2.4f));
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static V linearToSrgb(V x) {
+        auto linear = _mm256_cmp_ps(x, M::set(0.0031308f), _CMP_LE_OQ);
+        auto curve = _mm256_sub_ps(
+            _mm256_mul_ps(M::set(1.055f), M::pow(x, 1.0f / 2.4f)),
+            M::set(0.055f));
+        return M::select(linear, _mm256_mul_ps(M::set(12.92f), x), curve);
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static V labF(V t) {
+        auto linear = _mm256_add_ps(_mm256_div_ps(t, M::set(lab::SLOPE)),
+                                    M::set(lab::OFFSET));
+        auto cube = _mm256_cmp_ps(t, M::set(lab::EPSILON), _CMP_GT_OQ);
+        return M::select(cube, M::cbrt(t), linear);
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static V labFInverse(V t) {
+        auto linear = _mm256_mul_ps(M::set(lab::SLOPE),
+                                    _mm256_sub_ps(t, M::set(lab::OFFSET)));
+        auto cube = _mm256_cmp_ps(t, M::set(lab::DELTA), _CMP_GT_OQ);
+        return M::select(cube, _mm256_mul_ps(t, _mm256_mul_ps(t, t)), linear);
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static void fromRgb(PerceptualModel model, V& x, V& y, V& z) {
+        x = srgbToLinear(x);
+        y = srgbToLinear(y);
+        z = srgbToLinear(z);
+
+        if (model == PerceptualModel::oklab) {
+            multiply(oklab::RGB_TO_LMS, x, y, z);
+            x = M::cbrt(x);
+            y = M::cbrt(y);
+            z = M::cbrt(z);
+            multiply(oklab::LMS_TO_LAB, x, y, z);
+            return;
+        }
+
+        multiply(lab::RGB_TO_XYZ, x, y, z);
+        auto fx = labF(x), fy = labF(y), fz = labF(z);
+        x = _mm256_sub_ps(_mm256_mul_ps(M::set(116), fy), M::set(16));
+        y = _mm256_mul_ps(M::set(500), _mm256_sub_ps(fx, fy));
+        z = _mm256_mul_ps(M::set(200), _mm256_sub_ps(fy, fz));
+
+        if (model == PerceptualModel::lch) {
+            auto chroma = _mm256_sqrt_ps(
+                _mm256_add_ps(_mm256_mul_ps(y, y), _mm256_mul_ps(z, z)));
+            z = M::atan2Turns(z, y);
+            y = chroma;
+        }
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static void toRgb(PerceptualModel model, V& x, V& y, V& z) {
+        if (model == PerceptualModel::oklab) {
+            multiply(oklab::LAB_TO_LMS, x, y, z);
+            x = _mm256_mul_ps(x, _mm256_mul_ps(x, x));
+            y = _mm256_mul_ps(y, _mm256_mul_ps(y, y));
+            z = _mm256_mul_ps(z, _mm256_mul_ps(z, z));
+            multiply(oklab::LMS_TO_RGB, x, y, z);
+        } else {
+            if (model == PerceptualModel::lch) {
+                V sin, cos;
+                M::sinCosTurns(z, sin, cos);
+                z = _mm256_mul_ps(y, sin);
+                y = _mm256_mul_ps(y, cos);
+            }
+            auto fy = _mm256_div_ps(_mm256_add_ps(x, M::set(16)),
+                                    M::set(116));
+            auto fx = _mm256_add_ps(fy, _mm256_div_ps(y, M::set(500)));
+            auto fz = _mm256_sub_ps(fy, _mm256_div_ps(z, M::set(200)));
+            x = labFInverse(fx);
+            y = labFInverse(fy);
+            z = labFInverse(fz);
+            multiply(lab::XYZ_TO_RGB, x, y, z);
+        }
+
+        x = linearToSrgb(x);
+        y = linearToSrgb(y);
+        z = linearToSrgb(z);
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static void fromRgb(PerceptualModel model, float const* rgb, float* out,
+                        size_t n) {
+        size_t i = 0;
+        for (; i + WIDTH <= n; i += WIDTH) {
+            V x, y, z;
+            M::load3(rgb + 3 * i, x, y, z);
+            fromRgb(model, x, y, z);
+            M::store3(out + 3 * i, x, y, z);
+        }
+        ScalarPerceptual::fromRgb(model, rgb + 3 * i, out + 3 * i, n - i);
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static void toRgb(PerceptualModel model, float const* in, float* rgb,
+                      size_t n) {
+        size_t i = 0;
+        for (; i + WIDTH <= n; i += WIDTH) {
+            V x, y, z;
+            M::load3(in + 3 * i, x, y, z);
+            toRgb(model, x, y, z);
+            M::store3(rgb + 3 * i, x, y, z);
+        }
+        ScalarPerceptual::toRgb(model, in + 3 * i, rgb + 3 * i, n - i);
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static void deltaE(float const* x, float const* y, float* out,
+                       size_t n) {
+        size_t i = 0;
+        for (; i + WIDTH <= n; i += WIDTH) {
+            V x0, x1, x2, y0, y1, y2;
+            M::load3(x + 3 * i, x0, x1, x2);
+            M::load3(y + 3 * i, y0, y1, y2);
+            auto d0 = _mm256_sub_ps(x0, y0);
+            auto d1 = _mm256_sub_ps(x1, y1);
+            auto d2 = _mm256_sub_ps(x2, y2);
+            auto sum = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(d0, d0), _mm256_mul_ps(d1, d1)),
+                _mm256_mul_ps(d2, d2));
+            _mm256_storeu_ps(out + i, _mm256_sqrt_ps(sum));
+        }
+        ScalarPerceptual::deltaE(x + 3 * i, y + 3 * i, out + i, n - i);
+    }
+};
+
+#endif  // TIMEDATA_SIMD_X86
+
+inline void fromRgb(SimdLevel level, PerceptualModel model, float const* rgb,
+                    float* out, size_t size) {
+    TIMEDATA_DISPATCH(level, ScalarPerceptual, Avx2Perceptual,
+                      Kernel::fromRgb(model, rgb, out, size));
+}
+
+inline void toRgb(SimdLevel level, PerceptualModel model, float const* in,
+                  float* rgb, size_t size) {
+    TIMEDATA_DISPATCH(level, ScalarPerceptual, Avx2Perceptual,
+                      Kernel::toRgb(model, in, rgb, size));
+}
+
+inline void deltaE(SimdLevel level, float const* x, float const* y,
+                   float* out, size_t size) {
+    TIMEDATA_DISPATCH(level, ScalarPerceptual, Avx2Perceptual,
+                      Kernel::deltaE(x, y, out, size));
+}
+
+inline void fromRgb(PerceptualModel model, float const* rgb, float* out,
+                    size_t size) {
+    fromRgb(simdLevel(), model, rgb, out, size);
+}
+
+inline void toRgb(PerceptualModel model, float const* in, float* rgb,
+                  size_t size) {
+    toRgb(simdLevel(), model, in, rgb, size);
+}
+
+inline void deltaE(float const* x, float const* y, float* out, size_t size) {
+    deltaE(simdLevel(), x, y, out, size);
+}
+
+} // simd
+} // timedata
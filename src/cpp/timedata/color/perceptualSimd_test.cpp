@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include <timedata/base/enum.h>
+#include <timedata/color/deltaE.h>
+#include <timedata/color/perceptualSimd.h>
+
+namespace timedata {
+namespace simd {
+
+TEST_CASE("perceptual models", "perceptualSimd") {
+    auto near = [](ColorRGB const& rgb, float x, float y, float z, float d) {
+        ColorLab lab;
+        converter::convertSample(rgb, lab);
+        return std::abs(*lab[0] - x) < d and std::abs(*lab[1] - y) < d and
+            std::abs(*lab[2] - z) < d;
+    };
+    REQUIRE(near({1, 1, 1}, 100, 0, 0, 0.01f));
+    REQUIRE(near({0, 0, 0}, 0, 0, 0, 0.01f));
+    REQUIRE(near({1, 0, 0}, 53.24f, 80.09f, 67.20f, 0.01f));
+    REQUIRE(near({0, 0, 1}, 32.30f, 79.19f, -107.86f, 0.01f));
+
+    ColorOklab ok;
+    converter::convertSample(ColorRGB{1, 0, 0}, ok);
+    REQUIRE(std::abs(*ok[0] - 0.62796f) < 1e-4f);
+    REQUIRE(std::abs(*ok[1] - 0.22486f) < 1e-4f);
+    REQUIRE(std::abs(*ok[2] - 0.12585f) < 1e-4f);
+
+    ColorLCh lch;
+    converter::convertSample(ColorRGB{0, 0, 1}, lch);
+    REQUIRE(std::abs(*lch[1] - 133.81f) < 0.01f);
+    REQUIRE(std::abs(*lch[2] - 306.29f / 360) < 1e-4f);
+
+    REQUIRE(std::abs(deltaE(ColorRGB{1, 0, 0}, ColorRGB{1, 0, 0})) < 1e-4f);
+    REQUIRE(std::abs(deltaE(ColorRGB{1, 1, 1}, ColorRGB{0, 0, 0}) - 100) <
+            0.01f);
+}
+
+TEST_CASE("perceptual kernels", "perceptualSimd") {
+    // An odd size, so the AVX2 kernels also run their scalar tails.
+    static const size_t SIZE = 1001;
+    std::vector<float> rgb = {0, 0, 0, 1, 1, 1, 0.5f, 0.5f, 0.5f, 1, 0, 0,
+                              0.01f, 0.02f, 0.03f, 0, 0, 1};
+    uint32_t seed = 76;
+    while (rgb.size() < 3 * SIZE) {
+        seed = seed * 1664525 + 1013904223;
+        rgb.push_back(((seed >> 8) % 1001) / 1000.0f);
+    }
+
+    forEach<PerceptualModel>([&](PerceptualModel model) {
+        // The largest value of each component, to scale the tolerance.
+        auto scale = model == PerceptualModel::oklab ? 1.0f : 100.0f;
+        auto isLCh = model == PerceptualModel::lch;
+
+        std::vector<float> from(rgb.size()), to(rgb.size());
+        ScalarPerceptual::fromRgb(model, rgb.data(), from.data(), SIZE);
+        ScalarPerceptual::toRgb(model, from.data(), to.data(), SIZE);
+        for (size_t i = 0; i < rgb.size(); ++i)
+            REQUIRE(std::abs(to[i] - rgb[i]) < 1e-4f);
+
+        forEach<SimdLevel>([&](SimdLevel level) {
+            if (level > cpuSimdLevel())
+                return;
+            std::vector<float> out(rgb.size());
+            fromRgb(level, model, rgb.data(), out.data(), SIZE);
+            for (size_t i = 0; i < rgb.size(); ++i) {
+                auto d = std::abs(out[i] - from[i]);
+                if (isLCh and i % 3 == 2) {
+                    // Hue is circular, and meaningless without chroma.
+                    d = std::min(d, 1 - d) * (from[i - 1] > 0.1f);
+                    REQUIRE(d < 1e-4f);
+                } else {
+                    REQUIRE(d < 1e-4f * scale);
+                }
+            }
+
+            toRgb(level, model, from.data(), out.data(), SIZE);
+            for (size_t i = 0; i < rgb.size(); ++i)
+                REQUIRE(std::abs(out[i] - to[i]) < 1e-4f);
+        });
+    });
+}
+
+TEST_CASE("deltaE lists", "perceptualSimd") {
+    // More than two tiles, so the tiles and the tail are all exercised.
+    ColorRGB::List x, y;
+    for (size_t i = 0; i < 600; ++i) {
+        auto f = i / 599.0f;
+        x.push_back({f, 1 - f, 0.5f});
+        y.push_back({0.25f, f, f * f});
+    }
+    y.push_back({1, 1, 1});
+
+    forEach<SimdLevel>([&](SimdLevel level) {
+        if (level > cpuSimdLevel())
+            return;
+        auto saved = simdLevel();
+        setSimdLevel(level);
+        std::vector<float> d, into(x.size() + 1, -1.0f);
+        deltaE(x, y, d);
+        deltaE(x, y, into.data());
+        auto mean = meanDeltaE(x, y);
+        setSimdLevel(saved);
+
+        REQUIRE(d.size() == x.size());
+        double total = 0;
+        for (size_t i = 0; i < x.size(); ++i) {
+            REQUIRE(std::abs(d[i] - deltaE(x[i], y[i])) < 0.01f);
+            REQUIRE(into[i] == d[i]);
+            total += d[i];
+        }
+        REQUIRE(into.back() == -1.0f);
+        REQUIRE(std::abs(mean - total / x.size()) < 1e-4f);
+    });
+
+    REQUIRE(meanDeltaE(x, ColorRGB::List()) == 0.0f);
+}
+
+} // simd
+} // timedata
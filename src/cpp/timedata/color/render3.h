@@ -7,6 +7,7 @@ namespace timedata {
 
 struct Render3 {
     enum class Permutation {rgb, rbg, grb, gbr, brg, bgr};
+    enum class Output {u8, u16be, u16le};
 
     float gamma = 1.0f;
     uint8_t min = 0;
@@ -14,6 +15,9 @@ struct Render3 {
     float offset = 0.0f;
     Permutation permutation = Permutation::rgb;
     size_t prefix = 0; // Number of 0xff to prepad the rendering.
+    Output output = Output::u8; // 8-bit, or 16-bit big or little endian.
+    uint8_t bits = 16; // Significant bits in each 16-bit output.
+    uint8_t indexBits = 0; // 2 ** indexBits gamma entries; 0 is the default.
 };
 
 } // timedata
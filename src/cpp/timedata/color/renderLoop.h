@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <timedata/base/clock.h>
+#include <timedata/color/renderer_inl.h>
+
+namespace timedata {
+namespace color_list {
+
+/** Timing statistics for a RenderLoop. */
+template <typename Duration>
+struct FrameStats {
+    /** Frames rendered. */
+    size_t frames = 0;
+
+    /** Frames that weren't delivered before the next frame was due, or were
+        skipped entirely because the loop fell more than a frame behind. */
+    size_t misses = 0;
+
+    /** The longest time to produce, render and deliver one frame. */
+    Duration worst = Duration::zero();
+
+    /** histogram[i] counts the frames that took between i and i + 1 times
+        `bucket`.  The last entry counts every frame longer than that. */
+    std::vector<size_t> histogram;
+    Duration bucket = Duration::zero();
+
+    void record(Duration frameTime);
+};
+
+/** A fixed-rate real-time render loop, running in C++ so that nothing in
+    Python can delay a frame.
+
+    Each frame, the loop waits for the frame's deadline on its Clock, calls
+    the producer to fill the frame's colors, renders them with its CRenderer,
+    and hands the bytes to the output.  Deadlines are start + n * period, so
+    errors don't accumulate.  If a frame runs over, the loop counts a miss;
+    if it falls more than a whole frame behind, it skips the frames it
+    missed rather than rushing to catch up.
+
+    The producer and output are called on the loop's thread and must not
+    block for long.  They get the frame number, counting from 0 and
+    including skipped frames. */
+template <typename ColorList, typename Clock = SteadyClock>
+class RenderLoop {
+  public:
+    using Duration = typename Clock::duration;
+    using TimePoint = typename Clock::time_point;
+    using Stats = FrameStats<Duration>;
+
+    using Producer = std::function<void(size_t frame, ColorList&)>;
+    using Output = std::function<void(size_t frame, char const*, size_t)>;
+
+    /** The histogram has `buckets` buckets covering one frame period. */
+    RenderLoop(Duration period, CRenderer const&, Producer, Output,
+               size_t buckets = 32, Clock clock = Clock());
+    ~RenderLoop() { stop(); }
+
+    RenderLoop(RenderLoop const&) = delete;
+    RenderLoop& operator=(RenderLoop const&) = delete;
+
+    /** Run the loop on its own thread until stop(). */
+    void start();
+    void stop();
+
+    /** Run `count` frames on the calling thread. */
+    void run(size_t count);
+
+    /** A copy of the statistics so far. */
+    Stats stats() const;
+
+    /** The renderer level, which can be changed while the loop runs. */
+    float level() const { return level_; }
+    void setLevel(float level) { level_ = level; }
+
+  private:
+    void frame();
+
+    Duration period_;
+    CRenderer renderer_;
+    Producer producer_;
+    Output output_;
+    Clock clock_;
+
+    ColorList colors_;
+    std::vector<char> bytes_;
+
+    TimePoint start_;
+    size_t next_ = 0;
+    bool started_ = false;
+
+    std::atomic<float> level_;
+    std::atomic<bool> running_;
+    std::thread thread_;
+
+    mutable std::mutex statsMutex_;
+    Stats stats_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename Duration>
+void FrameStats<Duration>::record(Duration frameTime) {
+    ++frames;
+    worst = std::max(worst, frameTime);
+    if (histogram.empty())
+        return;
+
+    auto last = histogram.size() - 1;
+    auto i = bucket.count() ? size_t(frameTime.count() / bucket.count()) : 0;
+    ++histogram[std::min(i, last)];
+}
+
+template <typename ColorList, typename Clock>
+RenderLoop<ColorList, Clock>::RenderLoop(
+    Duration period, CRenderer const& renderer, Producer producer,
+    Output output, size_t buckets, Clock clock)
+        : period_(period),
+          renderer_(renderer),
+          producer_(producer),
+          output_(output),
+          clock_(clock),
+          level_(1.0f),
+          running_(false) {
+    stats_.histogram.resize(buckets + 1);
+    using Rep = typename Duration::rep;
+    stats_.bucket = buckets ? period / static_cast<Rep>(buckets) : period;
+}
+
+template <typename ColorList, typename Clock>
+void RenderLoop<ColorList, Clock>::start() {
+    if (running_.exchange(true))
+        return;
+    thread_ = std::thread([this]() {
+        while (running_)
+            frame();
+    });
+}
+
+template <typename ColorList, typename Clock>
+void RenderLoop<ColorList, Clock>::stop() {
+    running_ = false;
+    if (thread_.joinable())
+        thread_.join();
+}
+
+template <typename ColorList, typename Clock>
+void RenderLoop<ColorList, Clock>::run(size_t count) {
+    for (size_t i = 0; i < count; ++i)
+        frame();
+}
+
+template <typename ColorList, typename Clock>
+auto RenderLoop<ColorList, Clock>::stats() const -> Stats {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    return stats_;
+}
+
+template <typename ColorList, typename Clock>
+void RenderLoop<ColorList, Clock>::frame() {
+    if (not started_) {
+        start_ = clock_.now();
+        started_ = true;
+    }
+
+    using Rep = typename Duration::rep;
+    auto deadline = start_ + static_cast<Rep>(next_) * period_;
+    clock_.sleepUntil(deadline);
+    auto begin = clock_.now();
+
+    producer_(next_, colors_);
+    bytes_.resize(colors_.size() * renderer_.stride());
+    renderer_.render(level_, colors_, 0, colors_.size(), bytes_.data());
+    output_(next_, bytes_.data(), bytes_.size());
+
+    auto end = clock_.now();
+    size_t missed = end > deadline + period_;
+
+    // Skip every frame whose whole period has already gone by.
+    ++next_;
+    auto behind = (end - start_) / period_;
+    if (behind >= 0 and size_t(behind) > next_) {
+        missed += size_t(behind) - next_;
+        next_ = size_t(behind);
+    }
+
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    stats_.record(end - begin);
+    stats_.misses += missed;
+}
+
+} // color_list
+} // timedata
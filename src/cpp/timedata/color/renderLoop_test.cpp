@@ -0,0 +1,61 @@
+#pragma once
+
+#include <timedata/color/renderLoop.h>
+
+namespace timedata {
+namespace color_list {
+
+/** A clock that only moves when it's told to. */
+struct ManualClock {
+    using duration = std::chrono::microseconds;
+    using time_point = std::chrono::time_point<
+        std::chrono::steady_clock, duration>;
+
+    time_point* time;
+
+    time_point now() const { return *time; }
+    void sleepUntil(time_point t) const { *time = std::max(*time, t); }
+};
+
+TEST_CASE("renderLoop", "renderLoop") {
+    using Loop = RenderLoop<CColorListRGB, ManualClock>;
+    using us = std::chrono::microseconds;
+
+    ManualClock::time_point time;
+    std::vector<size_t> frames;
+    std::vector<us> work{us(100), us(900), us(1500), us(100), us(3200),
+                         us(100)};
+    std::string bytes;
+
+    auto producer = [&](size_t frame, CColorListRGB& colors) {
+        colors.assign(2, ColorRGB(1.0f, 0.0f, 0.5f));
+        time += work[frames.size()];
+        frames.push_back(frame);
+    };
+    auto output = [&](size_t, char const* data, size_t size) {
+        bytes.assign(data, size);
+    };
+
+    Loop loop(us(1000), CRenderer(Render3()), producer, output, 10,
+              ManualClock{&time});
+    loop.run(work.size());
+
+    // Frame 2 runs 500us into frame 3's period, so frame 3 starts late.
+    // Frame 4 runs more than a whole frame over, so frames 5 and 6 are
+    // skipped.
+    REQUIRE(frames == std::vector<size_t>({0, 1, 2, 3, 4, 7}));
+    REQUIRE(bytes == std::string("\xff\x00\x80\xff\x00\x80", 6));
+
+    auto stats = loop.stats();
+    REQUIRE(stats.frames == 6);
+    REQUIRE(stats.misses == 4);
+    REQUIRE(stats.worst == us(3200));
+    REQUIRE(stats.bucket == us(100));
+    REQUIRE(stats.histogram.size() == 11);
+    REQUIRE(stats.histogram[1] == 3);
+    REQUIRE(stats.histogram[9] == 1);
+    REQUIRE(stats.histogram[10] == 2);
+}
+
+} // color_list
+} // timedata
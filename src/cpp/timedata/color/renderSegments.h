@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <timedata/base/arena.h>
+#include <timedata/base/parallel.h>
+#include <timedata/color/renderer_inl.h>
+
+namespace timedata {
+namespace color_list {
+
+/** One strip of a scatter-gather render: `size` samples starting at
+    `source` in the color list are rendered by `renderer` at `level`, and
+    written starting at byte `destination` of the output buffer.
+
+    The renderer carries the strip's permutation, prefix, output format and
+    gamma table, so strips that share settings can share a renderer. */
+struct RenderSegment {
+    CRenderer const* renderer;
+    float level;
+    size_t source;
+    size_t size;
+    size_t destination;
+};
+
+using RenderSegments = std::vector<RenderSegment>;
+
+/** Render every segment from `colors` into one buffer of `outSize` bytes.
+
+    Returns false, without writing anything, if any segment reads past the
+    end of `colors` or writes past the end of `out`.  Bytes of `out` not
+    covered by any segment are left alone.
+
+    Segments are cut into pieces of parallelism().grain samples, and if the
+    policy says so, the pieces are spread over the thread pool.  Segments
+    whose output bytes overlap are always rendered serially, in order, so
+    where they overlap the later segment wins.
+
+    The bookkeeping for a parallel render lives in this thread's
+    frameArena(), so rendering a frame doesn't touch the heap. */
+template <typename ColorList>
+bool renderSegments(ColorList const& colors, RenderSegments const& segments,
+                    char* out, size_t outSize);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/** Do any two segments write to the same bytes? */
+inline bool overlaps(RenderSegments const& segments) {
+    using Range = std::pair<size_t, size_t>;
+    std::vector<Range, ArenaAllocator<Range>> ranges;
+    ranges.reserve(segments.size());
+    for (auto& s: segments) {
+        if (s.size)
+            ranges.emplace_back(s.destination,
+                                s.destination + s.size * s.renderer->stride());
+    }
+
+    std::sort(ranges.begin(), ranges.end());
+    for (size_t i = 1; i < ranges.size(); ++i) {
+        if (ranges[i].first < ranges[i - 1].second)
+            return true;
+    }
+    return false;
+}
+
+} // detail
+
+template <typename ColorList>
+bool renderSegments(ColorList const& colors, RenderSegments const& segments,
+                    char* out, size_t outSize) {
+    size_t total = 0;
+    for (auto& s: segments) {
+        if (not s.renderer or
+            s.source > colors.size() or s.size > colors.size() - s.source or
+            s.destination > outSize or
+            s.size * s.renderer->stride() > outSize - s.destination) {
+            return false;
+        }
+        total += s.size;
+    }
+
+    auto render = [&](RenderSegment const& s, size_t begin, size_t end) {
+        auto dest = out + s.destination + begin * s.renderer->stride();
+        s.renderer->render(s.level, colors, s.source + begin, end - begin,
+                           dest);
+    };
+
+    auto& p = parallelism();
+    FrameArena::Scope scope(frameArena());
+    if (not p.isParallel(total) or detail::overlaps(segments)) {
+        for (auto& s: segments)
+            render(s, 0, s.size);
+        return true;
+    }
+
+    struct Piece {
+        RenderSegment const* segment;
+        size_t begin, end;
+    };
+
+    std::vector<Piece, ArenaAllocator<Piece>> pieces;
+    pieces.reserve(total / p.grain + segments.size());
+    for (auto& s: segments) {
+        for (size_t b = 0; b < s.size; b += p.grain)
+            pieces.push_back({&s, b, std::min(s.size, b + p.grain)});
+    }
+
+    threadPool().run(pieces.size(), [&](size_t i) {
+        auto& piece = pieces[i];
+        render(*piece.segment, piece.begin, piece.end);
+    });
+    return true;
+}
+
+} // color_list
+} // timedata
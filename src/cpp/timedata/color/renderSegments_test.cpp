@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+
+#include <timedata/color/renderSegments.h>
+
+namespace timedata {
+namespace color_list {
+
+TEST_CASE("renderSegments", "renderer") {
+    CColorListRGB colors;
+    for (size_t i = 0; i < 1000; ++i)
+        colors.push_back({(i % 7) / 6.0f, (i % 11) / 10.0f, (i % 5) / 4.0f});
+
+    Render3 r1, r2;
+    r2.gamma = 2.5f;
+    r2.permutation = Render3::Permutation::grb;
+    r2.prefix = 1;
+    r2.output = Render3::Output::u16le;
+    CRenderer c1(r1), c2(r2);
+
+    RenderSegments segments{
+        {&c1, 1.0f, 0, 300, 0},
+        {&c2, 0.5f, 300, 500, 900},
+        {&c1, 0.75f, 900, 100, 4500}};
+    auto size = 4800;
+
+    std::string expected(size, '\0');
+    c1.render(1.0f, colors, 0, 300, &expected[0]);
+    c2.render(0.5f, colors, 300, 500, &expected[900]);
+    c1.render(0.75f, colors, 900, 100, &expected[4500]);
+
+    std::string actual(size, '\0');
+    REQUIRE(renderSegments(colors, segments, &actual[0], size));
+    REQUIRE(actual == expected);
+
+    auto saved = parallelism();
+    parallelism().threshold = 1;
+    parallelism().grain = 64;
+
+    std::string parallel(size, '\0');
+    REQUIRE(renderSegments(colors, segments, &parallel[0], size));
+    REQUIRE(parallel == expected);
+
+    // Overlapping segments render in order, even in parallel.
+    RenderSegments overlapping{
+        {&c1, 1.0f, 0, 500, 0},
+        {&c2, 0.5f, 100, 300, 600},
+        {&c1, 0.25f, 700, 200, 300}};
+    std::string serial(size, '\0');
+    c1.render(1.0f, colors, 0, 500, &serial[0]);
+    c2.render(0.5f, colors, 100, 300, &serial[600]);
+    c1.render(0.25f, colors, 700, 200, &serial[300]);
+    for (auto i = 0; i < 10; ++i) {
+        std::string rendered(size, '\0');
+        REQUIRE(renderSegments(colors, overlapping, &rendered[0], size));
+        REQUIRE(rendered == serial);
+    }
+    parallelism() = saved;
+
+    REQUIRE(not renderSegments(colors, segments, &actual[0], size - 1));
+    segments.push_back({&c1, 1.0f, 990, 20, 0});
+    REQUIRE(not renderSegments(colors, segments, &actual[0], size));
+}
+
+} // color_list
+} // timedata
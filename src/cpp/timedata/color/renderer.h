@@ -1,14 +1,18 @@
 #pragma once
 
 #include <cstddef>
-#include <timedata/base/gammaTable.h>
+#include <timedata/base/gammaLut.h>
 #include <timedata/color/cython_list_inl.h>
 #include <timedata/color/render3.h>
+#include <timedata/color/rgbAdaptor.h>
 #include <timedata/signal/convert_inl.h>
 
 namespace timedata {
 namespace color_list {
 
+/** The number of samples CRenderer renders in each block. */
+static const size_t RENDER_BLOCK = 256;
+
 class CRenderer {
   public:
     CRenderer(Render3);
@@ -16,17 +20,55 @@ class CRenderer {
     CRenderer& operator=(CRenderer const&) = default;
 
     /** Render a generic RGBIndexer to a byte buffer.  The number of bytes
-        pointed to by `out` must be at least 3 times the number of colors. */
+        pointed to by `out` must be at least stride() times the number of
+        colors. */
     void render(
         float level, RGBIndexer const&, size_t pos, size_t size, char* out);
 
+    /** Render `size` samples starting at `pos` of a list of any color model
+        to a byte buffer, giving the same bytes as rendering its RGBIndexer.
+
+        The samples are read straight from the list's memory.  Lists that
+        aren't ColorRGB are converted to RGB in small blocks on the stack.
+        Level and gamma are computed for a block at a time in one vectorized
+        pass, and then the bytes are written out with the permutation fixed
+        at compile time. */
+    template <typename ColorList>
+    void render(float level, ColorList const&, size_t pos, size_t size,
+                char* out) const;
+
+    /** The number of bytes rendered for each sample. */
+    size_t stride() const {
+        return prefix_ + (output_ == Render3::Output::u8 ? 3 : 6);
+    }
+
   private:
     using Perm = std::array<uint8_t, 3>;
 
     static Perm getPerm(Render3::Permutation);
 
-    GammaTable gammaTable_;
+    void renderSamples(float level, ColorRGB const*, size_t size,
+                       char* out) const;
+
+    template <typename Sample>
+    void renderSamples(float level, Sample const*, size_t size,
+                       char* out) const;
+
+    template <size_t R, size_t G, size_t B>
+    void renderOutput(float level, ColorRGB const*, size_t size,
+                      char* out) const;
+
+    template <size_t R, size_t G, size_t B, typename Writer, typename Lut>
+    void renderBlocks(float level, ColorRGB const*, size_t size, char* out,
+                      Lut const&) const;
+
+    void writeChannel(float x, char*& out) const;
+
+    GammaLut8 lut8_;
+    GammaLut16 lut16_;
     Perm perm_;
+    Render3::Permutation permutation_;
+    Render3::Output output_;
     size_t prefix_;
 };
 
@@ -2,36 +2,171 @@
 
 #include <timedata/color/renderer.h>
 
+#include <algorithm>
+#include <timedata/base/gammaLut.h>
 #include <timedata/base/gammaTable.h>
+#include <timedata/base/parallel.h>
 #include <timedata/signal/convert_inl.h>
+#include <timedata/signal/convertList.h>
 #include <timedata/color/cython_list_inl.h>
 #include <timedata/color/rgbAdaptor.h>
 
 namespace timedata {
 namespace color_list {
+namespace detail {
+
+/** Write one channel of rendered output. */
+struct WriteU8 {
+    static void write(uint8_t x, char*& out) {
+        *out++ = static_cast<char>(x);
+    }
+};
+
+struct WriteU16BE {
+    static void write(uint16_t x, char*& out) {
+        *out++ = static_cast<char>(x >> 8);
+        *out++ = static_cast<char>(x & 0xFF);
+    }
+};
+
+struct WriteU16LE {
+    static void write(uint16_t x, char*& out) {
+        *out++ = static_cast<char>(x & 0xFF);
+        *out++ = static_cast<char>(x >> 8);
+    }
+};
+
+/** Compute GammaLut::index for `size` numbers at once, in a loop that
+    vectorizes.  As there, NaN goes to index 0 rather than to an undefined
+    cast. */
+inline void gammaIndexes(float level, float const* in, size_t size,
+                         size_t lutSize, int32_t* out) {
+    auto scale = static_cast<float>(lutSize);
+    auto top = static_cast<float>(lutSize - 1);
+    for (size_t i = 0; i < size; ++i) {
+        auto x = scale * std::max(0.0f, level * in[i]);
+        out[i] = static_cast<int32_t>(std::min(x, top));
+    }
+}
+
+} // detail
 
 inline CRenderer::CRenderer(Render3 r)
-        : gammaTable_(makeGammaTable(r.gamma, r.offset, r.min, r.max)),
-          perm_(getPerm(r.permutation)),
+        : perm_(getPerm(r.permutation)),
+          permutation_(r.permutation),
+          output_(r.output),
           prefix_(r.prefix) {
+    auto g = r.gamma, o = r.offset;
+    if (output_ != Render3::Output::u8) {
+        auto indexBits = r.indexBits ? r.indexBits :
+            GammaLut16::DEFAULT_INDEX_BITS;
+        lut16_ = GammaLut16(g, r.bits, indexBits, o, r.min, r.max);
+    } else if (r.indexBits) {
+        lut8_ = GammaLut8(g, 8, r.indexBits, o, r.min, r.max);
+    } else {
+        // The default is the classic table, so 8-bit output is byte for
+        // byte what it always was.
+        lut8_ = GammaLut8(makeGammaTable(g, o, r.min, r.max));
+    }
 }
 
 inline void CRenderer::render(
         float level, RGBIndexer const& colors,
         size_t position, size_t size, char* out) {
-    for (size_t i = 0, o = 0; i < size; ++i) {
+    for (size_t i = 0; i < size; ++i) {
         auto color = colors(i + position);
         for (size_t p = 0; p < prefix_; ++p)
-            out[o++] = '\xff';
+            *out++ = '\xff';
 
-        for (size_t j = 0; j < color.size(); ++j) {
-            auto component = level * color[perm_[j]];
-            auto gamma = getGamma(gammaTable_, component);
-            out[o++] = static_cast<char>(gamma);
-        }
+        for (size_t j = 0; j < color.size(); ++j)
+            writeChannel(level * color[perm_[j]], out);
+    }
+}
+
+inline void CRenderer::writeChannel(float x, char*& out) const {
+    switch (output_) {
+        case Render3::Output::u8:
+            return detail::WriteU8::write(lut8_(x), out);
+        case Render3::Output::u16be:
+            return detail::WriteU16BE::write(lut16_(x), out);
+        case Render3::Output::u16le:
+            return detail::WriteU16LE::write(lut16_(x), out);
     }
 }
 
+template <typename ColorList>
+void CRenderer::render(float level, ColorList const& colors,
+                       size_t position, size_t size, char* out) const {
+    renderSamples(level, colors.data() + position, size, out);
+}
+
+inline void CRenderer::renderSamples(
+        float level, ColorRGB const* in, size_t size, char* out) const {
+    using P = Render3::Permutation;
+    switch (permutation_) {
+        case P::rgb: return renderOutput<0, 1, 2>(level, in, size, out);
+        case P::rbg: return renderOutput<0, 2, 1>(level, in, size, out);
+        case P::grb: return renderOutput<1, 0, 2>(level, in, size, out);
+        case P::gbr: return renderOutput<1, 2, 0>(level, in, size, out);
+        case P::brg: return renderOutput<2, 0, 1>(level, in, size, out);
+        case P::bgr: return renderOutput<2, 1, 0>(level, in, size, out);
+    }
+}
+
+template <size_t R, size_t G, size_t B>
+void CRenderer::renderOutput(
+        float level, ColorRGB const* in, size_t size, char* out) const {
+    using O = Render3::Output;
+    using namespace detail;
+    switch (output_) {
+        case O::u8:
+            return renderBlocks<R, G, B, WriteU8>(level, in, size, out, lut8_);
+        case O::u16be:
+            return renderBlocks<R, G, B, WriteU16BE>(
+                level, in, size, out, lut16_);
+        case O::u16le:
+            return renderBlocks<R, G, B, WriteU16LE>(
+                level, in, size, out, lut16_);
+    }
+}
+
+template <typename Sample>
+void CRenderer::renderSamples(
+        float level, Sample const* in, size_t size, char* out) const {
+    forChunks(size, [&](size_t begin, size_t end) {
+        ColorRGB rgb[RENDER_BLOCK];
+        for (auto b = begin; b < end; b += RENDER_BLOCK) {
+            auto n = std::min(RENDER_BLOCK, end - b);
+            converter::ListConverter<Sample, ColorRGB>::convert(in + b, rgb, n);
+            renderSamples(level, rgb, n, out + b * stride());
+        }
+    });
+}
+
+template <size_t R, size_t G, size_t B, typename Writer, typename Lut>
+void CRenderer::renderBlocks(float level, ColorRGB const* in, size_t size,
+                             char* out, Lut const& lut) const {
+    auto table = lut.data();
+    forChunks(size, [&](size_t begin, size_t end) {
+        int32_t index[3 * RENDER_BLOCK];
+        auto o = out + begin * stride();
+        for (auto b = begin; b < end; b += RENDER_BLOCK) {
+            auto n = std::min(RENDER_BLOCK, end - b);
+            auto x = reinterpret_cast<float const*>(in + b);
+            detail::gammaIndexes(level, x, 3 * n, lut.size(), index);
+
+            for (size_t i = 0; i < n; ++i) {
+                for (size_t p = 0; p < prefix_; ++p)
+                    *o++ = '\xff';
+                auto j = index + 3 * i;
+                Writer::write(table[j[R]], o);
+                Writer::write(table[j[G]], o);
+                Writer::write(table[j[B]], o);
+            }
+        }
+    });
+}
+
 inline CRenderer::Perm CRenderer::getPerm(Render3::Permutation perm) {
     static std::vector<Perm> const PERMS = {
         {{0, 1, 2}},
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <timedata/color/renderer_inl.h>
+
+namespace timedata {
+namespace color_list {
+
+template <typename ColorList>
+void testRenderer(Render3 const& r, ColorList const& colors) {
+    CRenderer renderer(r);
+    auto size = colors.size() - 2;
+    std::string expected(size * renderer.stride(), '\0');
+    std::string actual(expected.size(), '\0');
+
+    for (auto level: {1.0f, 0.5f, 0.9f}) {
+        renderer.render(level, getIndexer(colors), 2, size, &expected[0]);
+        renderer.render(level, colors, 2, size, &actual[0]);
+        REQUIRE(actual == expected);
+    }
+}
+
+TEST_CASE("renderer", "renderer") {
+    CColorListRGB rgb;
+    for (size_t i = 0; i < 600; ++i)
+        rgb.push_back({(i % 7) / 6.0f, (i % 11) / 8.0f - 0.2f, (i % 5) / 4.0f});
+
+    CColorListHSV hsv;
+    converter::convertList(rgb, hsv);
+
+    CColorListRGB255 rgb255;
+    converter::convertList(rgb, rgb255);
+
+    for (auto gamma: {1.0f, 2.5f}) {
+        for (int perm = 0; perm < 6; ++perm) {
+            for (int output = 0; output < 3; ++output) {
+                Render3 r;
+                r.gamma = gamma;
+                r.permutation = static_cast<Render3::Permutation>(perm);
+                r.output = static_cast<Render3::Output>(output);
+                r.prefix = perm % 2;
+                testRenderer(r, rgb);
+                testRenderer(r, hsv);
+                testRenderer(r, rgb255);
+            }
+        }
+    }
+}
+
+TEST_CASE("renderer 16 bit", "renderer") {
+    CColorListRGB colors{{1.0f, 0.5f, 0.0f}};
+    Render3 r;
+    r.output = Render3::Output::u16be;
+    std::string out(6, '\0');
+    CRenderer(r).render(1.0f, colors, 0, 1, &out[0]);
+    REQUIRE(out == std::string("\xff\xff\x80\x80\x00\x00", 6));
+
+    r.output = Render3::Output::u16le;
+    r.bits = 12;
+    CRenderer(r).render(1.0f, colors, 0, 1, &out[0]);
+    REQUIRE(out == std::string("\xff\x0f\x07\x08\x00\x00", 6));
+}
+
+TEST_CASE("renderer 8 bit is unchanged", "renderer") {
+    // The bytes the renderer gave before it had a GammaLut.
+    static const size_t SIZE = 100001;
+    CColorListRGB colors;
+    for (size_t i = 0; i < SIZE; ++i) {
+        auto x = i / float(SIZE - 1);
+        colors.push_back({x, x * 0.37f, 1 - x});
+    }
+
+    for (auto gamma: {1.0f, 2.5f}) {
+        Render3 r;
+        r.gamma = gamma;
+        r.min = 3;
+        r.max = 250;
+        r.offset = 0.5f;
+        auto table = makeGammaTable(r.gamma, r.offset, r.min, r.max);
+
+        CRenderer renderer(r);
+        std::string out(3 * SIZE, '\0');
+        renderer.render(1.0f, colors, 0, SIZE, &out[0]);
+        for (size_t i = 0; i < SIZE; ++i) {
+            for (size_t j = 0; j < 3; ++j) {
+                auto expected = getGamma(table, *colors[i][j]);
+                REQUIRE(uint8_t(out[3 * i + j]) == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("renderer rejects bad bits", "renderer") {
+    Render3 r;
+    r.indexBits = 31;
+    REQUIRE_THROWS_AS(CRenderer{r}, std::invalid_argument const&);
+
+    r.indexBits = 12;
+    r.output = Render3::Output::u16be;
+    r.bits = 17;
+    REQUIRE_THROWS_AS(CRenderer{r}, std::invalid_argument const&);
+
+    r.bits = 0;
+    REQUIRE_THROWS_AS(CRenderer{r}, std::invalid_argument const&);
+}
+
+TEST_CASE("renderer NaN and infinities", "renderer") {
+    auto inf = std::numeric_limits<float>::infinity();
+    CColorListRGB colors{
+        {NAN, 0.5f, -NAN}, {inf, -inf, 1e30f}, {-1e30f, NAN, inf},
+        {0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}};
+
+    for (int output = 0; output < 3; ++output) {
+        for (auto indexBits: {0, 12}) {
+            Render3 r;
+            r.gamma = 2.5f;
+            r.output = static_cast<Render3::Output>(output);
+            r.indexBits = indexBits;
+            CRenderer renderer(r);
+            auto stride = renderer.stride() / 3;
+            auto size = colors.size();
+
+            for (auto level: {1.0f, 0.5f, 0.0f}) {
+                std::string list(size * renderer.stride(), '\0');
+                std::string indexer(list.size(), '\0');
+                renderer.render(level, colors, 0, size, &list[0]);
+                renderer.render(level, getIndexer(colors), 0, size,
+                                &indexer[0]);
+                REQUIRE(list == indexer);
+
+                // NaN and -inf render like 0, and at full level +inf and
+                // huge values render like 1.
+                auto black = list.substr(3 * 3 * stride, stride);
+                auto white = list.substr(4 * 3 * stride, stride);
+                auto channel = [&](size_t i) {
+                    return list.substr(i * stride, stride);
+                };
+                REQUIRE(channel(0) == black);
+                REQUIRE(channel(2) == black);
+                REQUIRE(channel(4) == black);
+                REQUIRE(channel(6) == black);
+                REQUIRE(channel(7) == black);
+                if (level == 1.0f) {
+                    REQUIRE(channel(3) == white);
+                    REQUIRE(channel(5) == white);
+                    REQUIRE(channel(8) == white);
+                }
+            }
+        }
+    }
+}
+
+} // color_list
+} // timedata
@@ -0,0 +1,335 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <timedata/base/cpu.h>
+#include <timedata/base/parallel.h>
+#include <timedata/base/simdMath.h>
+#include <timedata/signal/range.h>
+
+namespace timedata {
+
+/** Statistics for each channel of a list of three-channel samples, like a
+    ColorList, all gathered in one pass.
+
+    NaNs are skipped by min and max, as they are by histogram, so a channel
+    that is all NaN keeps a min of infinity and a max of -infinity.  They
+    still make the sum, mean and variance NaN. */
+struct Statistics {
+    static const size_t CHANNELS = 3;
+
+    size_t count = 0;
+    float min[CHANNELS], max[CHANNELS];
+    double sum[CHANNELS];
+
+    /** The sum of the squares of the differences from the mean. */
+    double m2[CHANNELS];
+
+    Statistics();
+
+    double mean(size_t channel) const;
+
+    /** The population variance - zero for an empty list. */
+    double variance(size_t channel) const;
+
+    /** The total Rec. 709 luminance of all the samples, treating the
+        channels as linear red, green and blue - the number to watch for
+        power limiting and auto-exposure. */
+    double luminance() const;
+
+    /** Add in the statistics of some more samples. */
+    void merge(Statistics const&);
+};
+
+/** Gather Statistics over `size` interleaved triples of floats.
+
+    The samples are summed in vectors within fixed blocks, and the blocks are
+    merged pairwise, in parallel if parallelism() says so - but the result
+    never depends on how many threads did the work. */
+Statistics statistics(float const* samples, size_t size);
+
+/** The same, at a specific SimdLevel - useful for testing. */
+Statistics statistics(SimdLevel, float const* samples, size_t size);
+
+/** Gather Statistics over a list of three-channel float samples. */
+template <typename List>
+Statistics statistics(List const&);
+
+/** Count the values of each channel into `bins` equal bins from `low` to
+    `high`.  Values out of band go into the first or last bin and NaNs aren't
+    counted.  The counts for channel c are at [c * bins, (c + 1) * bins).
+
+    Throws std::invalid_argument unless `low` < `high`. */
+std::vector<size_t> histogram(float const* samples, size_t size, size_t bins,
+                              float low, float high);
+
+template <typename List>
+std::vector<size_t> histogram(List const&, size_t bins, float low,
+                              float high);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+inline Statistics::Statistics() {
+    for (size_t c = 0; c < CHANNELS; ++c) {
+        min[c] = std::numeric_limits<float>::infinity();
+        max[c] = -std::numeric_limits<float>::infinity();
+        sum[c] = m2[c] = 0;
+    }
+}
+
+inline double Statistics::mean(size_t channel) const {
+    return count ? sum[channel] / count : 0;
+}
+
+inline double Statistics::variance(size_t channel) const {
+    return count ? m2[channel] / count : 0;
+}
+
+inline double Statistics::luminance() const {
+    return 0.2126 * sum[0] + 0.7152 * sum[1] + 0.0722 * sum[2];
+}
+
+// See: https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
+inline void Statistics::merge(Statistics const& x) {
+    if (not x.count)
+        return;
+
+    if (count) {
+        auto n = double(count), m = double(x.count);
+        for (size_t c = 0; c < CHANNELS; ++c) {
+            auto delta = x.sum[c] / m - sum[c] / n;
+            m2[c] += x.m2[c] + delta * delta * n * m / (n + m);
+        }
+    }
+
+    for (size_t c = 0; c < CHANNELS; ++c) {
+        min[c] = std::min(min[c], x.min[c]);
+        max[c] = std::max(max[c], x.max[c]);
+        sum[c] += x.sum[c];
+        if (not count)
+            m2[c] = x.m2[c];
+    }
+    count += x.count;
+}
+
+// Each block fits comfortably in the L1 cache, so the second pass for the
+// variance doesn't go back to memory.
+static const size_t STATISTICS_BLOCK = 1024;
+
+struct ScalarStatistics {
+    /** Accumulate samples into float sums, starting with sample `begin`.
+        std::min and std::max return their first argument unless the second
+        compares less or greater, so a NaN sample never replaces a bound. */
+    static void accumulate(float const* p, size_t begin, size_t end,
+                           float (&min)[3], float (&max)[3],
+                           float (&sum)[3]) {
+        for (auto i = begin; i < end; ++i) {
+            for (size_t c = 0; c < 3; ++c) {
+                auto x = p[3 * i + c];
+                min[c] = std::min(min[c], x);
+                max[c] = std::max(max[c], x);
+                sum[c] += x;
+            }
+        }
+    }
+
+    static void accumulateSquares(float const* p, size_t begin, size_t end,
+                                  float const (&mean)[3], float (&m2)[3]) {
+        for (auto i = begin; i < end; ++i) {
+            for (size_t c = 0; c < 3; ++c) {
+                auto d = p[3 * i + c] - mean[c];
+                m2[c] += d * d;
+            }
+        }
+    }
+
+    static Statistics block(float const* p, size_t n) {
+        Statistics s;
+        float sum[3] = {}, mean[3], m2[3] = {};
+        accumulate(p, 0, n, s.min, s.max, sum);
+        for (size_t c = 0; c < 3; ++c)
+            mean[c] = sum[c] / n;
+        accumulateSquares(p, 0, n, mean, m2);
+
+        s.count = n;
+        for (size_t c = 0; c < 3; ++c) {
+            s.sum[c] = sum[c];
+            s.m2[c] = m2[c];
+        }
+        return s;
+    }
+};
+
+#if TIMEDATA_SIMD_X86
+
+/* Eight samples are exactly three vectors, so lane j of the k-th vector
+   always holds channel (8k + j) % 3, and the lanes are only sorted into
+   channels at the end of each block. */
+struct Avx2Statistics {
+    using V = __m256;
+    using M = simd::Avx2Math;
+    static const size_t WIDTH = 8;
+
+    /** Fold 24 lanes, three vectors' worth, into their channels. */
+    TIMEDATA_TARGET("avx2")
+    static void fold(V const (&v)[3], float (&out)[24]) {
+        for (size_t k = 0; k < 3; ++k)
+            _mm256_storeu_ps(out + 8 * k, v[k]);
+    }
+
+    TIMEDATA_TARGET("avx2")
+    static Statistics block(float const* p, size_t n) {
+        auto vectors = n / WIDTH;
+        V lo[3], hi[3], total[3];
+        for (size_t k = 0; k < 3; ++k) {
+            lo[k] = M::set(std::numeric_limits<float>::infinity());
+            hi[k] = M::set(-std::numeric_limits<float>::infinity());
+            total[k] = _mm256_setzero_ps();
+        }
+
+        for (size_t i = 0; i < vectors; ++i) {
+            for (size_t k = 0; k < 3; ++k) {
+                // min and max return their second operand if either is a
+                // NaN, so a NaN sample leaves the bound alone, just as
+                // std::min and std::max do in ScalarStatistics.
+                auto x = _mm256_loadu_ps(p + 24 * i + 8 * k);
+                lo[k] = _mm256_min_ps(x, lo[k]);
+                hi[k] = _mm256_max_ps(x, hi[k]);
+                total[k] = _mm256_add_ps(total[k], x);
+            }
+        }
+
+        Statistics s;
+        float sum[3] = {}, mean[3], m2[3] = {}, lanes[3][24];
+        fold(lo, lanes[0]);
+        fold(hi, lanes[1]);
+        fold(total, lanes[2]);
+        for (size_t i = 0; i < 24; ++i) {
+            auto c = i % 3;
+            s.min[c] = std::min(s.min[c], lanes[0][i]);
+            s.max[c] = std::max(s.max[c], lanes[1][i]);
+            sum[c] += lanes[2][i];
+        }
+
+        auto done = WIDTH * vectors;
+        ScalarStatistics::accumulate(p, done, n, s.min, s.max, sum);
+        for (size_t c = 0; c < 3; ++c)
+            mean[c] = sum[c] / n;
+
+        V means[3], squares[3];
+        for (size_t k = 0; k < 3; ++k) {
+            auto c = 8 * k;
+            means[k] = _mm256_setr_ps(
+                mean[c % 3], mean[(c + 1) % 3], mean[(c + 2) % 3], mean[c % 3],
+                mean[(c + 1) % 3], mean[(c + 2) % 3], mean[c % 3],
+                mean[(c + 1) % 3]);
+            squares[k] = _mm256_setzero_ps();
+        }
+
+        for (size_t i = 0; i < vectors; ++i) {
+            for (size_t k = 0; k < 3; ++k) {
+                auto d = _mm256_sub_ps(_mm256_loadu_ps(p + 24 * i + 8 * k),
+                                       means[k]);
+                squares[k] = _mm256_add_ps(squares[k], _mm256_mul_ps(d, d));
+            }
+        }
+
+        fold(squares, lanes[0]);
+        for (size_t i = 0; i < 24; ++i)
+            m2[i % 3] += lanes[0][i];
+        ScalarStatistics::accumulateSquares(p, done, n, mean, m2);
+
+        s.count = n;
+        for (size_t c = 0; c < 3; ++c) {
+            s.sum[c] = sum[c];
+            s.m2[c] = m2[c];
+        }
+        return s;
+    }
+};
+
+#endif  // TIMEDATA_SIMD_X86
+
+inline Statistics statistics(SimdLevel level, float const* samples,
+                             size_t size) {
+    auto block = &ScalarStatistics::block;
+    TIMEDATA_DISPATCH(level, ScalarStatistics, Avx2Statistics,
+                      block = &Kernel::block);
+
+    auto f = [=](size_t begin, size_t end) {
+        return block(samples + 3 * begin, end - begin);
+    };
+    auto merge = [](Statistics& x, Statistics const& y) { x.merge(y); };
+    return reducePairwise(size, STATISTICS_BLOCK, Statistics(), f, merge);
+}
+
+inline Statistics statistics(float const* samples, size_t size) {
+    return statistics(simdLevel(), samples, size);
+}
+
+template <typename List>
+Statistics statistics(List const& list) {
+    using Sample = ValueType<List>;
+    static_assert(sizeof(Sample) == 3 * sizeof(float) and
+                  std::is_same<typename Sample::number_type, float>::value,
+                  "Samples must be a flat array of three floats");
+    return statistics(reinterpret_cast<float const*>(list.data()),
+                      list.size());
+}
+
+inline std::vector<size_t> histogram(float const* samples, size_t size,
+                                     size_t bins, float low, float high) {
+    if (not (low < high)) {
+        throw std::invalid_argument(
+            "Histogram low must be less than high, not " +
+            std::to_string(low) + " and " + std::to_string(high));
+    }
+
+    std::vector<size_t> empty(3 * bins);
+    if (not bins)
+        return empty;
+
+    auto scale = bins / (high - low);
+    auto last = float(bins - 1);
+    auto count = [&](size_t begin, size_t end) {
+        auto counts = empty;
+        for (auto i = begin; i < end; ++i) {
+            for (size_t c = 0; c < 3; ++c) {
+                auto x = (samples[3 * i + c] - low) * scale;
+                if (x == x) {
+                    auto bin = size_t(std::max(0.0f, std::min(last, x)));
+                    ++counts[c * bins + bin];
+                }
+            }
+        }
+        return counts;
+    };
+    auto add = [](std::vector<size_t>& x, std::vector<size_t> const& y) {
+        for (size_t i = 0; i < x.size(); ++i)
+            x[i] += y[i];
+    };
+    return reduceChunks(size, empty, count, add);
+}
+
+template <typename List>
+std::vector<size_t> histogram(List const& list, size_t bins, float low,
+                              float high) {
+    using Sample = ValueType<List>;
+    static_assert(sizeof(Sample) == 3 * sizeof(float) and
+                  std::is_same<typename Sample::number_type, float>::value,
+                  "Samples must be a flat array of three floats");
+    return histogram(reinterpret_cast<float const*>(list.data()), list.size(),
+                     bins, low, high);
+}
+
+} // timedata
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <timedata/base/enum.h>
+#include <timedata/color/statistics.h>
+
+namespace timedata {
+namespace color_statistics {
+
+inline std::vector<float> statisticsTestInputs(size_t size) {
+    std::vector<float> x;
+    uint32_t seed = 2017;
+    while (x.size() < 3 * size) {
+        seed = seed * 1664525 + 1013904223;
+        x.push_back(((seed >> 8) % 10001) / 10000.0f + 1000 * (x.size() % 3));
+    }
+    return x;
+}
+
+TEST_CASE("statistics", "statistics") {
+    std::vector<float> x = {0, 1, 2,  2, 1, 0,  4, 1, -2};
+    auto s = statistics(x.data(), 3);
+    REQUIRE(s.count == 3);
+    REQUIRE(s.min[0] == 0);
+    REQUIRE(s.max[0] == 4);
+    REQUIRE(s.min[2] == -2);
+    REQUIRE(s.max[2] == 2);
+    REQUIRE(s.sum[0] == 6);
+    REQUIRE(s.mean(0) == 2);
+    REQUIRE(std::abs(s.variance(0) - 8.0 / 3.0) < 1e-6);
+    REQUIRE(s.variance(1) == 0);
+    REQUIRE(std::abs(s.luminance() - (0.2126 * 6 + 0.7152 * 3)) < 1e-6);
+
+    auto empty = statistics(x.data(), 0);
+    REQUIRE(empty.count == 0);
+    REQUIRE(empty.mean(0) == 0);
+    REQUIRE(empty.variance(0) == 0);
+}
+
+TEST_CASE("statistics kernels", "statistics") {
+    for (size_t size: {1, 7, 8, 1023, 1025, 5000}) {
+        auto x = statisticsTestInputs(size);
+        double sum[3] = {}, m2[3] = {};
+        for (size_t i = 0; i < x.size(); ++i)
+            sum[i % 3] += x[i];
+        for (size_t i = 0; i < x.size(); ++i) {
+            auto d = x[i] - sum[i % 3] / size;
+            m2[i % 3] += d * d;
+        }
+
+        forEach<SimdLevel>([&](SimdLevel level) {
+            if (level > cpuSimdLevel())
+                return;
+            auto s = statistics(level, x.data(), size);
+            REQUIRE(s.count == size);
+            for (size_t c = 0; c < 3; ++c) {
+                REQUIRE(std::abs(s.sum[c] - sum[c]) <= 1e-6 * sum[c]);
+                REQUIRE(std::abs(s.m2[c] - m2[c]) <= 1e-4 * m2[c] + 1e-6);
+            }
+        });
+    }
+}
+
+TEST_CASE("statistics skip NaNs", "statistics") {
+    // The smallest and largest samples come first, and later NaNs land in
+    // the same vector lanes, in both the vectors and the tail.
+    for (size_t size: {3, 8, 19, 40}) {
+        auto x = statisticsTestInputs(size);
+        for (size_t c = 0; c < 3; ++c) {
+            x[c] = -1;
+            x[3 + c] = 5000;
+        }
+        for (size_t i = 24; i < x.size(); i += 7)
+            x[i] = NAN;
+        x[x.size() - 1] = NAN;
+
+        float lo[3], hi[3];
+        for (size_t c = 0; c < 3; ++c) {
+            lo[c] = std::numeric_limits<float>::infinity();
+            hi[c] = -lo[c];
+        }
+        for (size_t i = 0; i < x.size(); ++i) {
+            if (not std::isnan(x[i])) {
+                lo[i % 3] = std::min(lo[i % 3], x[i]);
+                hi[i % 3] = std::max(hi[i % 3], x[i]);
+            }
+        }
+
+        forEach<SimdLevel>([&](SimdLevel level) {
+            if (level > cpuSimdLevel())
+                return;
+            auto s = statistics(level, x.data(), size);
+            for (size_t c = 0; c < 3; ++c) {
+                REQUIRE(s.min[c] == lo[c]);
+                REQUIRE(s.max[c] == hi[c]);
+            }
+            REQUIRE(std::isnan(s.sum[2]));
+        });
+    }
+
+    std::vector<float> nans(24, NAN);
+    forEach<SimdLevel>([&](SimdLevel level) {
+        if (level > cpuSimdLevel())
+            return;
+        auto s = statistics(level, nans.data(), 8);
+        REQUIRE(s.min[1] == std::numeric_limits<float>::infinity());
+        REQUIRE(s.max[1] == -std::numeric_limits<float>::infinity());
+    });
+}
+
+TEST_CASE("statistics don't depend on threads", "statistics") {
+    auto size = size_t(100000);
+    auto x = statisticsTestInputs(size);
+    auto serial = statistics(x.data(), size);
+
+    auto saved = parallelism();
+    parallelism().threshold = 1;
+    for (size_t grain: {1000, 4096, 30000}) {
+        parallelism().grain = grain;
+        auto parallel = statistics(x.data(), size);
+        REQUIRE(parallel.count == size);
+        for (size_t c = 0; c < 3; ++c) {
+            REQUIRE(parallel.min[c] == serial.min[c]);
+            REQUIRE(parallel.max[c] == serial.max[c]);
+            REQUIRE(parallel.sum[c] == serial.sum[c]);
+            REQUIRE(parallel.m2[c] == serial.m2[c]);
+        }
+    }
+    parallelism() = saved;
+}
+
+TEST_CASE("histogram", "statistics") {
+    std::vector<float> x = {
+        0, 0.5f, 1,  0.25f, 0.75f, -1,  0.99f, 2, NAN,  0.5f, 0.5f, 0.5f};
+    auto h = histogram(x.data(), 4, 4, 0, 1);
+    std::vector<size_t> expected = {
+        1, 1, 1, 1,
+        0, 0, 2, 2,
+        1, 0, 1, 1};
+    REQUIRE(h == expected);
+
+    auto saved = parallelism();
+    parallelism().threshold = 1;
+    parallelism().grain = 1;
+    REQUIRE(histogram(x.data(), 4, 4, 0, 1) == expected);
+    parallelism() = saved;
+}
+
+TEST_CASE("histogram bounds", "statistics") {
+    std::vector<float> x = {0, 0.5f, 1};
+    REQUIRE_THROWS_AS(histogram(x.data(), 1, 4, 1, 1),
+                      std::invalid_argument const&);
+    REQUIRE_THROWS_AS(histogram(x.data(), 1, 4, 1, 0),
+                      std::invalid_argument const&);
+    REQUIRE_THROWS_AS(histogram(x.data(), 1, 4, 0, NAN),
+                      std::invalid_argument const&);
+}
+
+} // color_statistics
+} // timedata
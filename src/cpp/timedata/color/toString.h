@@ -13,13 +13,18 @@ bool isNearHex(Ranged<Range> number) {
 }
 
 template <typename Color>
-std::string addNegatives(Color const& c) {
-    std::string s;
+void appendNegatives(Color const& c, std::string& out) {
     auto r = (*c[0] < 0), g = (*c[1] < 0), b = (*c[2] < 0);
     if (r or g or b) {
         for (auto i: {r, g, b})
-            s += "+-"[i];
+            out += "+-"[i];
     }
+}
+
+template <typename Color>
+std::string addNegatives(Color const& c) {
+    std::string s;
+    appendNegatives(c, s);
     return s;
 };
 
@@ -40,38 +45,61 @@ uint32_t colorToHex(Color c) {
     return total;
 }
 
-inline std::string colorToStringNormal(ColorRGB const& c) {
+/** If `c` has a name or is a gray, append that to `out` and return true;
+    otherwise append nothing and return false. */
+inline bool appendColorNormal(ColorRGB const& c, std::string& out) {
     auto bounded = [](Ranged<> x) {
         return Ranged<>(std::abs(x)).inBand();
     };
     if (std::all_of(c.begin(), c.end(), bounded)) {
         if (std::all_of(c.begin(), c.end(), isNearHex<Normal<>>)) {
-            auto hex = colorToHex(c);
-
-            auto i = colorMapInverse().find(hex);
-            if (i != colorMapInverse().end())
-                return i->second + addNegatives(c);
+            if (auto name = colorNameFromHex(colorToHex(c))) {
+                out += name;
+                appendNegatives(c, out);
+                return true;
+            }
         }
 
         if (isGray(c)) {
-            auto gray = 100.0f * std::abs(c[0]);
-            return "gray " + timedata::toString(gray, 4) + addNegatives(c);
+            out += "gray ";
+            appendFloat(100.0f * std::abs(c[0]), 4, out);
+            appendNegatives(c, out);
+            return true;
         }
     }
-    return "";
+    return false;
+}
+
+/** The same, for any color model. */
+template <typename Color>
+bool appendColorName(Color const& c, std::string& out) {
+    ColorRGB normal;
+    converter::convertSample(c, normal);
+    return appendColorNormal(normal, out);
 }
 
-inline std::string colorToString(ColorRGB const& c) {
-    auto s = colorToStringNormal(c);
-    return s.empty() ? commaSeparated(c, 7) : s;
+inline bool appendColorName(ColorRGB const& c, std::string& out) {
+    return appendColorNormal(c, out);
+}
+
+/** Append colorToString(c) to `out`. */
+template <typename Color>
+void appendColor(Color const& c, std::string& out) {
+    if (not appendColorName(c, out))
+        appendCommaSeparated(c, 7, out);
+}
+
+inline std::string colorToStringNormal(ColorRGB const& c) {
+    std::string s;
+    appendColorNormal(c, s);
+    return s;
 }
 
 template <typename Color>
 std::string colorToString(Color const& c) {
-    ColorRGB normal;
-    converter::convertSample(c, normal);
-    auto s = colorToStringNormal(normal);
-    return s.empty() ? commaSeparated(c, 7) : s;
+    std::string s;
+    appendColor(c, s);
+    return s;
 }
 
 }  // timedata
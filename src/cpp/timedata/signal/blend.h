@@ -0,0 +1,46 @@
+#pragma once
+
+namespace timedata {
+
+/** How one layer of a composite is blended onto the layers under it, and
+    how strongly.  `normal` is alpha-over; `screen` assumes samples in [0, 1].
+*/
+struct Blend {
+    enum class Mode {normal, add, multiply, screen, lighten, darken, last = darken};
+
+    Mode mode = Mode::normal;
+    float opacity = 1;
+};
+
+/** How much `under` changes when `over` is blended onto it at full opacity,
+    so that the result is under + opacity * blendChange<MODE>(under, over). */
+template <Blend::Mode MODE>
+float blendChange(float under, float over);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+template <Blend::Mode MODE>
+float blendChange(float under, float over) {
+    using Mode = Blend::Mode;
+    switch (MODE) {
+        default:
+            // The normal mode is alpha-over.
+            return over - under;
+        case Mode::add:
+            return over;
+        case Mode::multiply:
+            return under * over - under;
+        case Mode::screen:
+            return over - under * over;
+        case Mode::lighten:
+            return (under < over ? over : under) - under;
+        case Mode::darken:
+            return (over < under ? over : under) - under;
+    }
+}
+
+} // timedata
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+
+#include <timedata/base/cpu.h>
+#include <timedata/base/simdMath.h>
+#include <timedata/signal/blend.h>
+
+namespace timedata {
+namespace simd {
+
+/** Blend `size` interleaved triples of floats from `layer` onto `out`, in
+    place, so that for each number
+        out += opacity * alpha[i] * blendChange<MODE>(out, layer)
+    where alpha[i] is the alpha of sample i, or 1 if `alpha` is null.
+
+    Every SimdLevel does the same operations in the same order, so they all
+    give exactly the same numbers. */
+void blend(Blend const&, float const* layer, float const* alpha, float* out,
+           size_t size);
+
+/** The same, at a specific SimdLevel - useful for testing. */
+void blend(SimdLevel, Blend const&, float const* layer, float const* alpha,
+           float* out, size_t size);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+struct ScalarBlend {
+    template <Blend::Mode MODE>
+    static void blend(float opacity, float const* layer, float const* alpha,
+                      float* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            auto a = alpha ? opacity * alpha[i] : opacity;
+            for (size_t c = 0; c < 3; ++c, ++layer, ++out)
+                *out += a * blendChange<MODE>(*out, *layer);
+        }
+    }
+};
+
+#if TIMEDATA_SIMD_X86
+
+struct Avx2Blend {
+    using V = __m256;
+    using M = Avx2Math;
+    static const size_t WIDTH = 8;
+
+    template <Blend::Mode MODE>
+    TIMEDATA_TARGET("avx2")
+    static V change(V under, V over) {
+        using Mode = Blend::Mode;
+        switch (MODE) {
+            default:
+                return _mm256_sub_ps(over, under);
+            case Mode::add:
+                return over;
+            case Mode::multiply:
+                return _mm256_sub_ps(_mm256_mul_ps(under, over), under);
+            case Mode::screen:
+                return _mm256_sub_ps(over, _mm256_mul_ps(under, over));
+            case Mode::lighten:
+                return _mm256_sub_ps(_mm256_max_ps(over, under), under);
+            case Mode::darken:
+                return _mm256_sub_ps(_mm256_min_ps(over, under), under);
+        }
+    }
+
+    /** Spread eight alphas, one per sample, over the 24 numbers of those
+        samples. */
+    TIMEDATA_TARGET("avx2")
+    static void spread(V a, V (&out)[3]) {
+        out[0] = _mm256_permutevar8x32_ps(
+            a, _mm256_setr_epi32(0, 0, 0, 1, 1, 1, 2, 2));
+        out[1] = _mm256_permutevar8x32_ps(
+            a, _mm256_setr_epi32(2, 3, 3, 3, 4, 4, 4, 5));
+        out[2] = _mm256_permutevar8x32_ps(
+            a, _mm256_setr_epi32(5, 5, 6, 6, 6, 7, 7, 7));
+    }
+
+    template <Blend::Mode MODE>
+    TIMEDATA_TARGET("avx2")
+    static void blend(float opacity, float const* layer, float const* alpha,
+                      float* out, size_t n) {
+        auto o = M::set(opacity);
+        V a[3] = {o, o, o};
+        size_t i = 0;
+        for (; i + WIDTH <= n; i += WIDTH) {
+            if (alpha)
+                spread(_mm256_mul_ps(o, _mm256_loadu_ps(alpha + i)), a);
+            for (size_t k = 0; k < 3; ++k) {
+                auto p = 3 * i + WIDTH * k;
+                auto under = _mm256_loadu_ps(out + p);
+                auto over = _mm256_loadu_ps(layer + p);
+                _mm256_storeu_ps(out + p, _mm256_add_ps(under, _mm256_mul_ps(
+                    a[k], change<MODE>(under, over))));
+            }
+        }
+        ScalarBlend::blend<MODE>(opacity, layer + 3 * i,
+                                 alpha ? alpha + i : nullptr, out + 3 * i,
+                                 n - i);
+    }
+};
+
+#endif  // TIMEDATA_SIMD_X86
+
+/** Call Kernel::blend with the mode picked at compile time. */
+template <typename Kernel>
+void blendMode(Blend const& b, float const* layer, float const* alpha,
+               float* out, size_t size) {
+    using Mode = Blend::Mode;
+    auto f = &Kernel::template blend<Mode::normal>;
+    switch (b.mode) {
+        case Mode::normal:
+            break;
+        case Mode::add:
+            f = &Kernel::template blend<Mode::add>;
+            break;
+        case Mode::multiply:
+            f = &Kernel::template blend<Mode::multiply>;
+            break;
+        case Mode::screen:
+            f = &Kernel::template blend<Mode::screen>;
+            break;
+        case Mode::lighten:
+            f = &Kernel::template blend<Mode::lighten>;
+            break;
+        case Mode::darken:
+            f = &Kernel::template blend<Mode::darken>;
+            break;
+    }
+    f(b.opacity, layer, alpha, out, size);
+}
+
+inline void blend(SimdLevel level, Blend const& b, float const* layer,
+                  float const* alpha, float* out, size_t size) {
+    TIMEDATA_DISPATCH(level, ScalarBlend, Avx2Blend,
+                      blendMode<Kernel>(b, layer, alpha, out, size));
+}
+
+inline void blend(Blend const& b, float const* layer, float const* alpha,
+                  float* out, size_t size) {
+    blend(simdLevel(), b, layer, alpha, out, size);
+}
+
+} // simd
+} // timedata
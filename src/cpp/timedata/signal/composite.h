@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include <timedata/base/parallel.h>
+#include <timedata/signal/blendSimd.h>
+#include <timedata/signal/range.h>
+
+namespace timedata {
+
+/** One layer of a composite: a list of samples, how to blend it and,
+    optionally, one alpha for each sample. */
+template <typename List>
+struct Layer {
+    List const* samples;
+    Blend blend;
+
+    /** Null for a layer with the same alpha everywhere. */
+    std::vector<float> const* alpha;
+};
+
+/** Blend a stack of layers, bottom first, onto black, giving `out` the
+    length of the shortest layer or alpha list.
+
+    The frame is worked in tiles small enough to stay in the L1 cache, and
+    every layer is blended onto a tile before moving to the next, so `out` is
+    written once rather than once per layer.  With `skipTransparent`, a layer
+    whose alpha is zero across a whole tile isn't read for that tile at all.
+
+    `out` must not be one of the layers.  Large frames are split over the
+    thread pool if parallelism() says so. */
+template <typename List>
+void composite(std::vector<Layer<List>> const& layers, List& out,
+               bool skipTransparent = true);
+
+/** The same, at a specific SimdLevel - useful for testing. */
+template <typename List>
+void composite(SimdLevel, std::vector<Layer<List>> const& layers, List& out,
+               bool skipTransparent = true);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+// A tile of 256 RGB samples is 3K, so the output tile and the layer tile
+// being blended onto it both stay in the L1 cache.
+static const size_t COMPOSITE_TILE = 256;
+
+template <typename List>
+void composite(SimdLevel level, std::vector<Layer<List>> const& layers,
+               List& out, bool skipTransparent) {
+    using Sample = ValueType<List>;
+    static_assert(sizeof(Sample) == 3 * sizeof(float) and
+                  std::is_same<typename Sample::number_type, float>::value,
+                  "Samples must be a flat array of three floats");
+
+    auto size = layers.empty() ? 0 : layers[0].samples->size();
+    for (auto& layer: layers) {
+        size = std::min(size, layer.samples->size());
+        if (layer.alpha)
+            size = std::min(size, layer.alpha->size());
+    }
+    out.resize(size);
+
+    auto o = reinterpret_cast<float*>(out.data());
+    forChunks(size, [&](size_t begin, size_t end) {
+        // Tiles are aligned to the whole list, not to the chunk, so the same
+        // layers are skipped however the work is split.
+        for (auto tile = begin; tile < end; ) {
+            auto next = std::min(end, (tile / COMPOSITE_TILE + 1) *
+                                 COMPOSITE_TILE);
+            auto n = next - tile;
+            auto t = o + 3 * tile;
+            std::fill(t, t + 3 * n, 0.0f);
+
+            for (auto& layer: layers) {
+                if (skipTransparent and not layer.blend.opacity)
+                    continue;
+
+                float const* alpha = nullptr;
+                if (layer.alpha) {
+                    alpha = layer.alpha->data() + tile;
+                    auto transparent = [](float a) { return not a; };
+                    if (skipTransparent and
+                        std::all_of(alpha, alpha + n, transparent)) {
+                        continue;
+                    }
+                }
+
+                auto samples = reinterpret_cast<float const*>(
+                    layer.samples->data()) + 3 * tile;
+                simd::blend(level, layer.blend, samples, alpha, t, n);
+            }
+            tile = next;
+        }
+    });
+}
+
+template <typename List>
+void composite(std::vector<Layer<List>> const& layers, List& out,
+               bool skipTransparent) {
+    composite(simdLevel(), layers, out, skipTransparent);
+}
+
+} // timedata
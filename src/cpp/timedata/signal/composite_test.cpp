@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <timedata/base/enum.h>
+#include <timedata/color/models/rgb.h>
+#include <timedata/signal/composite.h>
+
+namespace timedata {
+namespace compositing {
+
+inline ColorRGB::List compositeTestList(size_t size, size_t seed) {
+    ColorRGB::List list;
+    for (size_t i = 0; i < size; ++i) {
+        auto x = ((i * 7 + seed * 3) % 13) / 12.0f;
+        list.push_back({x, 1 - x, x * x});
+    }
+    return list;
+}
+
+/** The one-layer-at-a-time composite that composite() replaces. */
+inline ColorRGB::List compositeReference(
+        std::vector<Layer<ColorRGB::List>> const& layers, size_t size) {
+    ColorRGB::List out(size);
+    for (auto& layer: layers) {
+        auto& b = layer.blend;
+        for (size_t i = 0; i < size; ++i) {
+            auto a = layer.alpha ? b.opacity * (*layer.alpha)[i] : b.opacity;
+            for (size_t c = 0; c < 3; ++c) {
+                auto u = *out[i][c], o = *(*layer.samples)[i][c];
+                float change;
+                switch (b.mode) {
+                    default:
+                        change = blendChange<Blend::Mode::normal>(u, o);
+                        break;
+                    case Blend::Mode::add:
+                        change = blendChange<Blend::Mode::add>(u, o);
+                        break;
+                    case Blend::Mode::multiply:
+                        change = blendChange<Blend::Mode::multiply>(u, o);
+                        break;
+                    case Blend::Mode::screen:
+                        change = blendChange<Blend::Mode::screen>(u, o);
+                        break;
+                    case Blend::Mode::lighten:
+                        change = blendChange<Blend::Mode::lighten>(u, o);
+                        break;
+                    case Blend::Mode::darken:
+                        change = blendChange<Blend::Mode::darken>(u, o);
+                        break;
+                }
+                out[i][c] = u + a * change;
+            }
+        }
+    }
+    return out;
+}
+
+TEST_CASE("blendChange", "composite") {
+    using Mode = Blend::Mode;
+    REQUIRE(blendChange<Mode::normal>(0.25f, 0.75f) == 0.5f);
+    REQUIRE(blendChange<Mode::add>(0.25f, 0.75f) == 0.75f);
+    REQUIRE(blendChange<Mode::multiply>(0.5f, 0.5f) == -0.25f);
+    REQUIRE(blendChange<Mode::screen>(0.5f, 0.5f) == 0.25f);
+    REQUIRE(blendChange<Mode::lighten>(0.25f, 0.75f) == 0.5f);
+    REQUIRE(blendChange<Mode::lighten>(0.75f, 0.25f) == 0.0f);
+    REQUIRE(blendChange<Mode::darken>(0.25f, 0.75f) == 0.0f);
+    REQUIRE(blendChange<Mode::darken>(0.75f, 0.25f) == -0.5f);
+}
+
+TEST_CASE("composite", "composite") {
+    static const size_t SIZE = 1000;
+    std::vector<ColorRGB::List> lists;
+    for (size_t k = 0; k < enumSize<Blend::Mode>(); ++k)
+        lists.push_back(compositeTestList(SIZE + k, k));
+
+    // Transparent for the second tile, with NaNs under it that must never
+    // be read.
+    std::vector<float> alpha;
+    for (size_t i = 0; i < SIZE; ++i) {
+        auto tile = i / COMPOSITE_TILE;
+        alpha.push_back(tile == 1 ? 0 : (i % 5) / 4.0f);
+        if (tile == 1)
+            lists[1][i][0] = std::numeric_limits<float>::quiet_NaN();
+    }
+
+    std::vector<Layer<ColorRGB::List>> layers;
+    forEach<Blend::Mode>([&](Blend::Mode mode) {
+        auto k = layers.size();
+        Blend b;
+        b.mode = mode;
+        b.opacity = 1 - k / 8.0f;
+        layers.push_back({&lists[k], b, k == 1 ? &alpha : nullptr});
+    });
+
+    auto expected = compositeReference(layers, SIZE);
+    for (size_t i = COMPOSITE_TILE; i < 2 * COMPOSITE_TILE; ++i)
+        REQUIRE(std::isnan(*expected[i][0]));
+
+    ColorRGB::List out;
+    composite(layers, out);
+    REQUIRE(out.size() == SIZE);
+    for (size_t i = 0; i < SIZE; ++i) {
+        if (i / COMPOSITE_TILE != 1)
+            REQUIRE(out[i] == expected[i]);
+        else
+            REQUIRE(not std::isnan(*out[i][0]));
+    }
+
+    forEach<SimdLevel>([&](SimdLevel level) {
+        if (level > cpuSimdLevel())
+            return;
+        ColorRGB::List x;
+        composite(level, layers, x);
+        REQUIRE(x == out);
+
+        composite(level, layers, x, false);
+        for (size_t i = 0; i < SIZE; ++i) {
+            for (size_t c = 0; c < 3; ++c) {
+                auto e = *expected[i][c], y = *x[i][c];
+                REQUIRE((e == y or (std::isnan(e) and std::isnan(y))));
+            }
+        }
+    });
+
+    auto saved = parallelism();
+    parallelism().threshold = 1;
+    parallelism().grain = 77;
+    ColorRGB::List parallel;
+    composite(layers, parallel);
+    parallelism() = saved;
+    REQUIRE(parallel == out);
+
+    // A fully transparent layer changes nothing.
+    layers.push_back({&lists[0], Blend(), nullptr});
+    layers.back().blend.opacity = 0;
+    ColorRGB::List skipped;
+    composite(layers, skipped);
+    REQUIRE(skipped == out);
+
+    ColorRGB::List none;
+    composite<ColorRGB::List>({}, none);
+    REQUIRE(none.empty());
+}
+
+} // compositing
+} // timedata
@@ -1,19 +1,26 @@
 #pragma once
 
+#include <cstdint>
+
 #include <timedata/signal/sample.h>
 
 namespace timedata {
 namespace converter {
 
-/** Loads a converter for a specific C++ type into the list of converters,
-    returning the string name of the sample type.
+/** ModelId is a small integer interned for each sample type the first time
+    its converter is loaded, so that Python can name a model without passing
+    strings around. */
+using ModelId = uint32_t;
+
+/** Loads a converter for a specific C++ type into the table of converters,
+    returning the ModelId of the sample type.
 
     Please note that this isn't thread-safe so you need to make sure that this
     is always called on a single thread, quite likely the thread that loads the
     Python extension.
 */
 template <typename Sample>
-std::string loadConverter();
+ModelId loadConverter();
 
 
 /** PointerAsInt is just a mnemonic typedef to indicate that the integer
@@ -53,6 +60,38 @@ T& integerToReference(PointerAsInt t) {
 template <typename Sample1, typename Sample2>
 void convertSample(Sample1 const& in, Sample2& out);
 
+/* Conversions between ranges go through the normal range.  They're here,
+   rather than with the rest of the implementation, so that every template
+   that calls convertSample sees them. */
+template <typename Model, typename RangeIn, typename RangeOut>
+void convertSample(Sample<Model, RangeIn> const& in,
+                   Sample<Model, RangeOut>& out) {
+    for (size_t i = 0; i < out.size(); ++i)
+        out[i] = in[i];
+}
+
+template <typename ModelIn,
+          typename ModelOut,
+          typename RangeIn,
+          typename = enable_if_t<not std::is_same<ModelIn, ModelOut>::value>,
+          typename = enable_if_t<not std::is_same<RangeIn, Normal<>>::value>>
+void convertSample(Sample<ModelIn, RangeIn> const& in, Sample<ModelOut>& out) {
+    Sample<ModelIn> normalIn;
+    convertSample(in, normalIn);
+    convertSample(normalIn, out);
+}
+
+template <typename ModelIn,
+          typename ModelOut,
+          typename RangeOut,
+          typename = enable_if_t<not std::is_same<ModelIn, ModelOut>::value>,
+          typename = enable_if_t<not std::is_same<RangeOut, Normal<>>::value>>
+void convertSample(Sample<ModelIn> const& in, Sample<ModelOut, RangeOut>& out) {
+    Sample<ModelOut> normalOut;
+    convertSample(in, normalOut);
+    convertSample(normalOut, out);
+}
+
 /** Converts samples from one model to another, returning true on success.
 
     Sample conversion is only guaranteed to have a reasonable result on in-band
@@ -66,7 +105,13 @@ void convertSample(Sample1 const& in, Sample2& out);
 */
 template <typename T>
 bool convertSampleCython(
-    PointerAsInt inPtr, std::string const& inputModel, T& out);
+    PointerAsInt inPtr, ModelId inputModel, T& out);
+
+/** Like convertSampleCython, but converts a whole Sample::List `inPtr` into
+    `out` in one go. */
+template <typename Sample>
+bool convertListCython(PointerAsInt inPtr, ModelId inputModel,
+                       typename Sample::List& out);
 
 } // converter
 } // timedata
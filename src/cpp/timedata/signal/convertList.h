@@ -0,0 +1,288 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#include <timedata/base/enum.h>
+#include <timedata/base/half.h>
+#include <timedata/base/parallel.h>
+#include <timedata/color/hueSimd.h>
+#include <timedata/color/linearSimd.h>
+#include <timedata/color/perceptualSimd.h>
+#include <timedata/color/models/rgb.h>
+#include <timedata/color/models/hsl.h>
+#include <timedata/color/models/hsv.h>
+#include <timedata/color/models/lab.h>
+#include <timedata/color/models/linear.h>
+#include <timedata/color/models/oklab.h>
+#include <timedata/color/models/xyz.h>
+#include <timedata/color/models/yiq.h>
+#include <timedata/color/models/yuv.h>
+#include <timedata/signal/convert.h>
+
+namespace timedata {
+namespace converter {
+
+/** Convert a whole list of samples from one model or range to another,
+    resizing `out` to fit.
+
+    The result is exactly what you'd get by calling convertSample on each
+    sample, except where noted below - but the conversion is picked once at
+    compile time for the whole list, so there's no per-sample dispatch, no
+    std::function and no allocation, and the per-sample code is all inlined
+    into one tight loop:
+
+      * the same Sample type is a plain copy;
+      * the same model in a different range (like ColorRGB to ColorRGB255) is
+        a single affine pass over the numbers;
+      * between two linear models, like XYZ and YIQ, one matrix composed at
+        compile time with both ranges folded in is run over the list by the
+        vectorized kernel in linearSimd.h - so the result can differ in the
+        last bit from chaining convertSample through RGB;
+      * RGB to and from HSV and HSL use the vectorized kernels in
+        hueSimd.h;
+      * RGB to and from Lab, LCh and Oklab use the vectorized kernels in
+        perceptualSimd.h, which are approximate;
+      * models with a direct conversion call it inline;
+      * everything else goes through the normal model one sample at a time,
+        with the intermediate on the stack.
+
+    Large lists are split over the thread pool if parallelism() says so. */
+template <typename ListIn, typename ListOut>
+void convertList(ListIn const& in, ListOut& out);
+
+/** Is there a convertSample from ModelIn straight to ModelOut, without going
+    through the normal model? */
+template <typename ModelIn, typename ModelOut>
+struct HasDirectConversion : std::integral_constant<bool,
+    std::is_same<ModelIn, ModelOut>::value or
+    std::is_same<ModelIn, RGB>::value or
+    std::is_same<ModelOut, RGB>::value> {
+};
+
+template <> struct HasDirectConversion<HSV, HSL> : std::true_type {};
+template <> struct HasDirectConversion<HSL, HSV> : std::true_type {};
+template <> struct HasDirectConversion<Lab, LCh> : std::true_type {};
+template <> struct HasDirectConversion<LCh, Lab> : std::true_type {};
+
+/** Do two different models convert by a single linearMatrix? */
+template <typename SampleIn, typename SampleOut>
+struct IsLinearConversion : std::integral_constant<bool,
+    IsLinearSample<SampleIn>::value and IsLinearSample<SampleOut>::value and
+    not std::is_same<typename SampleIn::model_type,
+                     typename SampleOut::model_type>::value> {
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename SampleIn, typename SampleOut, typename Enable = void>
+struct SampleConverter {
+    static void convert(SampleIn const& in, SampleOut& out) {
+        using Normal = NormalType<SampleIn>;
+        Normal normal;
+        SampleConverter<SampleIn, Normal>::convert(in, normal);
+        SampleConverter<Normal, SampleOut>::convert(normal, out);
+    }
+};
+
+template <typename SampleIn, typename SampleOut>
+struct SampleConverter<SampleIn, SampleOut, enable_if_t<HasDirectConversion<
+        typename SampleIn::model_type,
+        typename SampleOut::model_type>::value and
+        not IsLinearConversion<SampleIn, SampleOut>::value>> {
+    static void convert(SampleIn const& in, SampleOut& out) {
+        convertSample(in, out);
+    }
+};
+
+template <typename SampleIn, typename SampleOut>
+struct SampleConverter<SampleIn, SampleOut, enable_if_t<
+        IsLinearConversion<SampleIn, SampleOut>::value>> {
+    static void convert(SampleIn const& in, SampleOut& out) {
+        static constexpr auto matrix = linearMatrix<SampleIn, SampleOut>();
+        linearTransform(matrix, &*in[0], &*out[0]);
+    }
+};
+
+template <typename SampleIn, typename SampleOut, typename Enable = void>
+struct ListConverter {
+    static void convert(SampleIn const* in, SampleOut* out, size_t size) {
+        for (size_t i = 0; i < size; ++i)
+            SampleConverter<SampleIn, SampleOut>::convert(in[i], out[i]);
+    }
+};
+
+template <typename Sample>
+struct ListConverter<Sample, Sample> {
+    static void convert(Sample const* in, Sample* out, size_t size) {
+        std::copy(in, in + size, out);
+    }
+};
+
+/** Do two ranges differ only in how their numbers are stored - like
+    Normal<Half> and Normal<float>? */
+template <typename RangeIn, typename RangeOut>
+struct IsStorageOnly : std::integral_constant<bool,
+    RangeIn::START == RangeOut::START and
+    RangeIn::RANGE == RangeOut::RANGE and
+    std::is_same<UnscaledType<RangeIn>, UnscaledType<RangeOut>>::value and
+    not std::is_integral<ValueType<RangeIn>>::value and
+    not std::is_integral<ValueType<RangeOut>>::value> {
+};
+
+/** Convert a flat array of numbers from one storage type to another. */
+template <typename NumberIn, typename NumberOut>
+void convertNumbers(NumberIn const* in, NumberOut* out, size_t size) {
+    for (size_t i = 0; i < size; ++i)
+        out[i] = in[i];
+}
+
+inline void convertNumbers(Half const* in, float* out, size_t size) {
+    simd::halfToFloat(in, out, size);
+}
+
+inline void convertNumbers(float const* in, Half* out, size_t size) {
+    simd::floatToHalf(in, out, size);
+}
+
+/** Range conversion: the same arithmetic as Ranged's conversion operator, on
+    the raw numbers. */
+template <typename Model, typename RangeIn, typename RangeOut>
+struct ListConverter<Sample<Model, RangeIn>, Sample<Model, RangeOut>,
+                     enable_if_t<not std::is_same<RangeIn, RangeOut>::value>> {
+    using SampleIn = Sample<Model, RangeIn>;
+    using SampleOut = Sample<Model, RangeOut>;
+
+    static void convert(SampleIn const* in, SampleOut* out, size_t size) {
+        convert(in, out, size, IsStorageOnly<RangeIn, RangeOut>());
+    }
+
+    static void convert(SampleIn const* in, SampleOut* out, size_t size,
+                        std::false_type) {
+        for (size_t i = 0; i < size; ++i) {
+            for (size_t j = 0; j < SampleIn::SIZE; ++j)
+                *out[i][j] = scale<RangeOut>(unscale<RangeIn>(*in[i][j]));
+        }
+    }
+
+    static void convert(SampleIn const* in, SampleOut* out, size_t size,
+                        std::true_type) {
+        using NumberIn = typename SampleIn::number_type;
+        using NumberOut = typename SampleOut::number_type;
+        static_assert(sizeof(SampleIn) == SampleIn::SIZE * sizeof(NumberIn) and
+                      sizeof(SampleOut) == SampleOut::SIZE * sizeof(NumberOut),
+                      "Samples must be a flat array of numbers");
+
+        convertNumbers(reinterpret_cast<NumberIn const*>(in),
+                       reinterpret_cast<NumberOut*>(out),
+                       size * SampleIn::SIZE);
+    }
+};
+
+template <typename SampleIn, typename SampleOut>
+struct ListConverter<SampleIn, SampleOut, enable_if_t<
+        IsLinearConversion<SampleIn, SampleOut>::value>> {
+    static_assert(sizeof(SampleIn) == 3 * sizeof(float) and
+                  sizeof(SampleOut) == 3 * sizeof(float),
+                  "Samples must be a flat array of floats");
+
+    static void convert(SampleIn const* in, SampleOut* out, size_t size) {
+        static constexpr auto matrix = linearMatrix<SampleIn, SampleOut>();
+        simd::transform(matrix,
+                        reinterpret_cast<float const*>(in),
+                        reinterpret_cast<float*>(out), size);
+    }
+};
+
+template <typename Model>
+struct IsHueModel : std::integral_constant<bool,
+    std::is_same<Model, HSV>::value or std::is_same<Model, HSL>::value> {
+};
+
+template <typename Model>
+simd::HueModel hueModel() {
+    return std::is_same<Model, HSV>::value ?
+        simd::HueModel::hsv : simd::HueModel::hsl;
+}
+
+template <typename Model>
+struct ListConverter<ColorRGB, Sample<Model>,
+                     enable_if_t<IsHueModel<Model>::value>> {
+    static_assert(sizeof(ColorRGB) == 3 * sizeof(float) and
+                  sizeof(Sample<Model>) == 3 * sizeof(float),
+                  "Samples must be a flat array of floats");
+
+    static void convert(ColorRGB const* in, Sample<Model>* out, size_t size) {
+        simd::fromRgb(hueModel<Model>(),
+                      reinterpret_cast<float const*>(in),
+                      reinterpret_cast<float*>(out), size);
+    }
+};
+
+template <typename Model>
+struct ListConverter<Sample<Model>, ColorRGB,
+                     enable_if_t<IsHueModel<Model>::value>> {
+    static void convert(Sample<Model> const* in, ColorRGB* out, size_t size) {
+        simd::toRgb(hueModel<Model>(),
+                    reinterpret_cast<float const*>(in),
+                    reinterpret_cast<float*>(out), size);
+    }
+};
+
+template <typename Model>
+struct IsPerceptualModel : std::integral_constant<bool,
+    std::is_same<Model, Lab>::value or std::is_same<Model, LCh>::value or
+    std::is_same<Model, Oklab>::value> {
+};
+
+template <typename Model>
+simd::PerceptualModel perceptualModel() {
+    return std::is_same<Model, Lab>::value ? simd::PerceptualModel::lab :
+        std::is_same<Model, LCh>::value ? simd::PerceptualModel::lch :
+        simd::PerceptualModel::oklab;
+}
+
+template <typename Model>
+struct ListConverter<ColorRGB, Sample<Model>,
+                     enable_if_t<IsPerceptualModel<Model>::value>> {
+    static_assert(sizeof(Sample<Model>) == 3 * sizeof(float),
+                  "Samples must be a flat array of floats");
+
+    static void convert(ColorRGB const* in, Sample<Model>* out, size_t size) {
+        simd::fromRgb(perceptualModel<Model>(),
+                      reinterpret_cast<float const*>(in),
+                      reinterpret_cast<float*>(out), size);
+    }
+};
+
+template <typename Model>
+struct ListConverter<Sample<Model>, ColorRGB,
+                     enable_if_t<IsPerceptualModel<Model>::value>> {
+    static void convert(Sample<Model> const* in, ColorRGB* out, size_t size) {
+        simd::toRgb(perceptualModel<Model>(),
+                    reinterpret_cast<float const*>(in),
+                    reinterpret_cast<float*>(out), size);
+    }
+};
+
+template <typename ListIn, typename ListOut>
+void convertList(ListIn const& in, ListOut& out) {
+    using SampleIn = ValueType<ListIn>;
+    using SampleOut = ValueType<ListOut>;
+
+    out.resize(in.size());
+    auto i = in.data();
+    auto o = out.data();
+    forChunks(in.size(), [&](size_t begin, size_t end) {
+        ListConverter<SampleIn, SampleOut>::convert(
+            i + begin, o + begin, end - begin);
+    });
+}
+
+} // converter
+} // timedata
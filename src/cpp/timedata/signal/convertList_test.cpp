@@ -0,0 +1,160 @@
+#pragma once
+
+#include <vector>
+
+#include <timedata/signal/convert_inl.h>
+#include <timedata/signal/convertList.h>
+
+namespace timedata {
+namespace converter {
+
+template <typename SampleIn, typename SampleOut>
+void testConvertList(size_t size) {
+    typename SampleIn::List in;
+    for (size_t i = 0; i < size; ++i) {
+        SampleIn s;
+        for (size_t j = 0; j < s.size(); ++j)
+            s[j] = ((i * 7 + j * 3) % 11) / 10.0f;
+        in.push_back(s);
+    }
+
+    typename SampleOut::List out;
+    convertList(in, out);
+    REQUIRE(out.size() == size);
+    for (size_t i = 0; i < size; ++i) {
+        SampleOut expected;
+        SampleConverter<SampleIn, SampleOut>::convert(in[i], expected);
+        for (size_t j = 0; j < expected.size(); ++j) {
+            auto x = *expected[j], y = *out[i][j];
+            REQUIRE((x == y or (std::isnan(x) and std::isnan(y))));
+        }
+    }
+}
+
+template <typename SampleIn>
+void testConvertListFrom(size_t size) {
+    testConvertList<SampleIn, ColorRGB>(size);
+    testConvertList<SampleIn, ColorRGB255>(size);
+    testConvertList<SampleIn, ColorRGB256>(size);
+    testConvertList<SampleIn, ColorHSV>(size);
+    testConvertList<SampleIn, ColorHSL>(size);
+    testConvertList<SampleIn, ColorXYZ>(size);
+    testConvertList<SampleIn, ColorYIQ>(size);
+    testConvertList<SampleIn, ColorYUV>(size);
+}
+
+TEST_CASE("convertList", "convert") {
+    for (size_t size: {0, 1, 5, 100}) {
+        testConvertListFrom<ColorRGB>(size);
+        testConvertListFrom<ColorRGB255>(size);
+        testConvertListFrom<ColorRGB256>(size);
+        testConvertListFrom<ColorHSV>(size);
+        testConvertListFrom<ColorHSL>(size);
+        testConvertListFrom<ColorXYZ>(size);
+        testConvertListFrom<ColorYIQ>(size);
+        testConvertListFrom<ColorYUV>(size);
+    }
+}
+
+/** Convert one sample through convertList, and compare it with numbers
+    worked out by hand. */
+template <typename SampleOut, typename SampleIn>
+void testKnownValue(SampleIn const& in, std::vector<float> const& expected,
+                    float epsilon = 1e-5f) {
+    typename SampleIn::List list{in};
+    typename SampleOut::List out;
+    convertList(list, out);
+    REQUIRE(out.size() == 1);
+    for (size_t j = 0; j < expected.size(); ++j) {
+        auto approx = Approx(expected[j]).epsilon(epsilon).scale(1);
+        REQUIRE(float(*out[0][j]) == approx);
+    }
+}
+
+TEST_CASE("convertList known values", "convert") {
+    // Hue models.
+    testKnownValue<ColorHSV>(ColorRGB{1, 0, 0}, {0, 1, 1});
+    testKnownValue<ColorHSV>(ColorRGB{0, 0.5f, 0}, {1 / 3.0f, 1, 0.5f});
+    testKnownValue<ColorHSL>(ColorRGB{1, 0, 0}, {0, 1, 0.5f});
+    testKnownValue<ColorHSL>(ColorRGB{0, 0, 0.5f}, {2 / 3.0f, 1, 0.25f});
+    testKnownValue<ColorRGB>(ColorHSV{2 / 3.0f, 1, 1}, {0, 0, 1});
+    testKnownValue<ColorRGB>(ColorHSL{1 / 3.0f, 1, 0.5f}, {0, 1, 0});
+    testKnownValue<ColorHSL>(ColorHSV{0, 1, 1}, {0, 1, 0.5f});
+
+    // Perceptual models, which are approximate.
+    testKnownValue<ColorLab>(ColorRGB{1, 1, 1}, {100, 0, 0}, 1e-3f);
+    testKnownValue<ColorLab>(ColorRGB{1, 0, 0}, {53.2408f, 80.0925f, 67.2032f},
+                             1e-3f);
+    testKnownValue<ColorLCh>(ColorRGB{0, 0, 0}, {0, 0, 0}, 1e-3f);
+    testKnownValue<ColorOklab>(ColorRGB{1, 1, 1}, {1, 0, 0}, 1e-3f);
+
+    // Linear models, including ranges folded into the matrix.
+    auto cie = 1 / 0.17697f;
+    testKnownValue<ColorXYZ>(ColorRGB{1, 1, 1}, {cie, cie, cie});
+    testKnownValue<ColorYIQ>(ColorRGB255{255, 255, 255}, {1, 0, 0});
+    testKnownValue<ColorYUV>(ColorRGB{1, 1, 1}, {1, 0, 0}, 1e-4f);
+    testKnownValue<ColorYUV>(ColorRGB{0, 0, 1}, {0.114f, 0.436f, -0.10001f});
+    testKnownValue<ColorRGB255>(ColorYIQ{1, 0, 0}, {255, 255, 255});
+    testKnownValue<ColorYIQ>(ColorXYZ{cie, cie, cie}, {1, 0, 0}, 1e-4f);
+
+    // Ranges and storage only.
+    testKnownValue<ColorRGB255>(ColorRGB{0.5f, 1, 0}, {127.5f, 255, 0});
+    testKnownValue<ColorRGBHalf>(ColorRGB{0.5f, 1 / 3.0f, 2},
+                                 {0.5f, 0.333251953f, 2}, 1e-7f);
+    testKnownValue<ColorRGB>(ColorRGBHalf{Half(0.25f), Half(1.0f), Half(0.0f)},
+                             {0.25f, 1, 0}, 1e-7f);
+}
+
+TEST_CASE("convertList matches convertSample", "convert") {
+    ColorRGB rgb{0.25f, 0.5f, 0.75f};
+    ColorRGB255 rgb255;
+    convertSample(rgb, rgb255);
+
+    ColorHSV hsv;
+    convertSample(rgb, hsv);
+
+    ColorRGB::List rgbs{rgb, rgb};
+    ColorRGB255::List rgb255s;
+    ColorHSV::List hsvs;
+    convertList(rgbs, rgb255s);
+    convertList(rgbs, hsvs);
+
+    REQUIRE(rgb255s[1] == rgb255);
+    REQUIRE(hsvs[1] == hsv);
+}
+
+TEST_CASE("convertCython", "convert") {
+    auto rgb = loadConverter<ColorRGB>();
+    auto hsv = loadConverter<ColorHSV>();
+    REQUIRE(rgb != hsv);
+    REQUIRE(loadConverter<ColorRGB>() == rgb);
+
+    ColorRGB in{0.25f, 0.5f, 0.75f};
+    ColorHSV expected, out;
+    convertSample(in, expected);
+    REQUIRE(convertSampleCython(referenceToInteger(in), rgb, out));
+    REQUIRE(out == expected);
+
+    ColorRGB255 out255, expected255;
+    convertSample(expected, expected255);
+    REQUIRE(convertSampleCython(referenceToInteger(out), hsv, out255));
+    REQUIRE(out255 == expected255);
+    REQUIRE(not convertSampleCython(referenceToInteger(out), 1000, out255));
+
+    ColorHSV::List hsvs{expected, expected, expected};
+    ColorYIQ::List yiqs, expectedYiqs;
+    convertList(hsvs, expectedYiqs);
+    auto hsvPtr = referenceToInteger(hsvs);
+    for (auto i = 0; i < 2; ++i) {
+        REQUIRE(convertListCython<ColorYIQ>(hsvPtr, hsv, yiqs));
+        REQUIRE(yiqs == expectedYiqs);
+    }
+
+    ColorRGB::List rgbs;
+    REQUIRE(convertListCython<ColorRGB>(hsvPtr, hsv, rgbs));
+    REQUIRE(rgbs.size() == 3);
+    REQUIRE(not convertListCython<ColorRGB>(hsvPtr, 1000, rgbs));
+}
+
+} // converter
+} // timedata
@@ -1,49 +1,20 @@
 #pragma once
 
 #include <cstddef>
-#include <functional>
-#include <map>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include <timedata/base/className.h>
-#include <timedata/base/deletable.h>
 #include <timedata/base/join_inl.h>
 #include <timedata/color/models/rgb.h>
 #include <timedata/color/models/hsv.h>
 #include <timedata/signal/convert.h>
+#include <timedata/signal/convertList.h>
 
 namespace timedata {
 namespace converter {
 
-template <typename Model, typename RangeIn, typename RangeOut>
-void convertSample(Sample<Model, RangeIn> const& in,
-                   Sample<Model, RangeOut>& out) {
-    for (size_t i = 0; i < out.size(); ++i)
-        out[i] = in[i];
-}
-
-template <typename ModelIn,
-          typename ModelOut,
-          typename RangeIn,
-          typename = enable_if_t<not std::is_same<ModelIn, ModelOut>::value>,
-          typename = enable_if_t<not std::is_same<RangeIn, Normal<>>::value>>
-void convertSample(Sample<ModelIn, RangeIn> const& in, Sample<ModelOut>& out) {
-    Sample<ModelIn> normalIn;
-    convertSample(in, normalIn);
-    convertSample(normalIn, out);
-}
-
-template <typename ModelIn,
-          typename ModelOut,
-          typename RangeOut,
-          typename = enable_if_t<not std::is_same<ModelIn, ModelOut>::value>,
-          typename = enable_if_t<not std::is_same<RangeOut, Normal<>>::value>>
-void convertSample(Sample<ModelIn> const& in, Sample<ModelOut, RangeOut>& out) {
-    Sample<ModelOut> normalOut;
-    convertSample(in, normalOut);
-    convertSample(normalOut, out);
-}
-
 /** The problem: there are many different sample models, and some of them are
     interconvertible but some will not be.  How do we represent this in C++ in
     such a way as to be usable from Python?
@@ -70,107 +41,164 @@ void convertSample(Sample<ModelIn> const& in, Sample<ModelOut, RangeOut>& out) {
 
 */
 
-/* Even though we're converting between a lot of different types, all this
-   interface has to be uniform so we can put it into a single table.
+/* Even though we're converting between a lot of different types, each family
+   of interconvertible models shares one normal type, so each family gets a
+   flat table of typed functions into that normal type, indexed by ModelId.
+   A model from another family simply has no entry in the table.
 
-   So we hide the intermediate.
+   Looking up a conversion is then one index, with no string compares and no
+   RTTI, and the intermediate is a plain normal sample on the stack - or for
+   lists, a normal list that belongs to the calling thread and keeps its
+   capacity from one call to the next.
 */
+template <typename Normal>
 struct Converter {
-    using From = Ptr<Deletable> (*)(PointerAsInt);
-    using To = void (*)(Deletable const&, PointerAsInt outPtr);
+    using From = void (*)(PointerAsInt, Normal& out);
+    using FromList = void (*)(PointerAsInt, typename Normal::List& out);
 
-    std::string name;
-    From from;
-    To to;
-    Converter const* normal; // nullptr means "this is the normal form".
+    From from;  // nullptr means "not in this family".
+    FromList fromList;
 };
 
-using Converters = std::map<std::string, Converter const*>;
+template <typename Normal>
+using Converters = std::vector<Converter<Normal>>;
 
-/** Get the singleton list of converters. */
-Converters& converters();
+/** The table of converters into one normal type, indexed by ModelId. */
+template <typename Normal>
+Converters<Normal>& converters();
 
-bool canConvert(Converter const&, Converter const&);
+/** The class names of all the loaded models, indexed by ModelId - only used
+    for error messages. */
+std::vector<std::string>& modelNames();
 
+/** The ModelId of a Sample type, registering its converter the first time. */
 template <typename Sample>
-Converter const& getConverterByType();
+ModelId modelId();
 
 template <typename Sample>
-std::string loadConverter() {
-    auto name = className<Sample>();
-    if (converters().find(name) == converters().end())
-        converters()[name] = &getConverterByType<Sample>();
-    return name;
+ModelId loadConverter() {
+    return modelId<Sample>();
+}
+
+/** Find the converter from model `id` into the family of Sample, or log an
+    error and return nullptr. */
+template <typename Sample>
+Converter<NormalType<Sample>> const* findConverter(ModelId id) {
+    auto& table = converters<NormalType<Sample>>();
+    if (id < table.size() and table[id].from)
+        return &table[id];
+
+    if (id < modelNames().size()) {
+        log("Did not share common normal", modelNames()[id],
+            className<Sample>());
+    } else {
+        log("Couldn't find converter", id);
+    }
+    return nullptr;
 }
 
 template <typename T>
-bool convertSampleCython(PointerAsInt inPtr,
-                         std::string const& modelName, T& out) {
-    auto i = converters().find(modelName);
-    if (i == converters().end()) {
-        log("Couldn't find converter", modelName);
-        return false;
+bool convertSampleCython(PointerAsInt inPtr, ModelId id, T& out) {
+    if (id == modelId<T>()) {
+        out = integerToReference<T const>(inPtr);
+        return true;
     }
 
-    auto& to = getConverterByType<T>();
-    auto& from = *(i->second);
-    if (not canConvert(to, from)) {
-        log("Did not share common normal", modelName, className<T>());
+    auto converter = findConverter<T>(id);
+    if (not converter)
         return false;
-    }
 
-    auto outPtr = referenceToInteger(out);
-    to.to(*from.from(inPtr), outPtr);
+    NormalType<T> normal;
+    converter->from(inPtr, normal);
+    convertSample(normal, out);
     return true;
 }
 
-inline Converters& converters() {
-    static Converters CONVERTERS;
-    return CONVERTERS;
+/** This thread's intermediate list for conversions into the family of
+    Normal. */
+template <typename Normal>
+typename Normal::List& normalList() {
+    static thread_local typename Normal::List list;
+    return list;
 }
 
-inline bool canConvert(Converter const& x, Converter const& y) {
-    return (&x == &y) or
-           (&x == y.normal) or
-           (&y == x.normal) or
-           (x.normal and (x.normal == y.normal));
+template <typename Normal>
+void convertListVia(Converter<Normal> const& converter, PointerAsInt inPtr,
+                    typename Normal::List& out, std::true_type) {
+    converter.fromList(inPtr, out);
 }
 
-template <typename Sample>
-Ptr<Deletable> convertFrom(PointerAsInt p) {
-    auto& in = integerToReference<Sample const>(p);
-    auto out = makeWrapper<NormalType<Sample>>();
-    convertSample(in, out->value);
-    return std::move(out);
+template <typename Normal, typename List>
+void convertListVia(Converter<Normal> const& converter, PointerAsInt inPtr,
+                    List& out, std::false_type) {
+    auto& normal = normalList<Normal>();
+    converter.fromList(inPtr, normal);
+    convertList(normal, out);
+    normal.clear();
 }
 
 template <typename Sample>
-void convertTo(Deletable const& input, PointerAsInt outPtr) {
-    auto& out = integerToReference<Sample>(outPtr);
-    if (auto in = unwrap<NormalType<Sample>>(input))
-        convertSample(*in, out);
-    else
-        log("Horrible programmer error", className<Sample>());
+bool convertListCython(PointerAsInt inPtr, ModelId id,
+                       typename Sample::List& out) {
+    using Normal = NormalType<Sample>;
+    using List = typename Sample::List;
+
+    if (id == modelId<Sample>()) {
+        out = integerToReference<List const>(inPtr);
+        return true;
+    }
+
+    if (id == modelId<Normal>()) {
+        convertList(integerToReference<typename Normal::List const>(inPtr),
+                    out);
+        return true;
+    }
+
+    auto converter = findConverter<Sample>(id);
+    if (not converter)
+        return false;
+
+    convertListVia(*converter, inPtr, out, std::is_same<Normal, Sample>());
+    return true;
 }
 
-template <typename Sample>
-Converter const& getConverterByType();
+template <typename Normal>
+Converters<Normal>& converters() {
+    static Converters<Normal> CONVERTERS;
+    return CONVERTERS;
+}
+
+inline std::vector<std::string>& modelNames() {
+    static std::vector<std::string> NAMES;
+    return NAMES;
+}
 
 template <typename Sample>
-Converter makeConverterByType() {
-    using Normal = NormalType<Sample>;
+void convertFrom(PointerAsInt p, NormalType<Sample>& out) {
+    convertSample(integerToReference<Sample const>(p), out);
+}
 
-    auto name = className<Sample>();
-    auto isNormal = std::is_same<Normal, Sample>::value;
-    auto normal = isNormal ? nullptr : &getConverterByType<Normal>();
+template <typename Sample>
+void convertListFrom(PointerAsInt p, typename NormalType<Sample>::List& out) {
+    convertList(integerToReference<typename Sample::List const>(p), out);
+}
 
-    return {name, &convertFrom<Sample>, &convertTo<Sample>, normal};
+template <typename Sample>
+ModelId registerModel() {
+    auto id = static_cast<ModelId>(modelNames().size());
+    modelNames().push_back(className<Sample>());
+
+    auto& table = converters<NormalType<Sample>>();
+    if (table.size() <= id)
+        table.resize(id + 1);
+    table[id] = {&convertFrom<Sample>, &convertListFrom<Sample>};
+    return id;
 }
 
 template <typename Sample>
-Converter const& getConverterByType() {
-    static const auto c = makeConverterByType<Sample>();
-    return c;
+ModelId modelId() {
+    static const auto id = registerModel<Sample>();
+    return id;
 }
 
 } // converter
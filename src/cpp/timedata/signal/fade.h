@@ -1,8 +1,15 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
-#include <timedata/color/models/rgb.h>
+#include <type_traits>
+#include <vector>
+
 #include <timedata/base/math.h>
+#include <timedata/base/parallel.h>
+#include <timedata/color/models/rgb.h>
+#include <timedata/signal/mixSimd.h>
 
 namespace timedata {
 
@@ -12,44 +19,165 @@ struct Fade {
     float begin = 0, end = 1;
     Type type = Type::linear;
 
-    float operator()(float fader, float x, float y) const {
-        auto xratio = begin + invert(fader) * (end - begin);
-        auto yratio = begin + fader * (end - begin);
-
-        switch (type) {
-            default:
-                break;
-            case Fade::Type::sqr:
-                xratio = xratio * xratio * signum(xratio);
-                yratio = yratio * yratio * signum(yratio);
-                break;
-            case Fade::Type::sqrt:
-                xratio = sqrt(std::abs(xratio)) * signum(xratio);
-                yratio = sqrt(std::abs(yratio)) * signum(yratio);
-                break;
-        }
-
-        // TODO: perhaps we should be applying end and begin after this step?
-        return xratio * x + yratio * y;
-    }
+    float operator()(float fader, float x, float y) const;
+
+    /** The levels of the two inputs at `fader`. */
+    void levels(float fader, float& x, float& y) const;
+
+    /** The same, with the curve picked at compile time. */
+    template <Type TYPE>
+    void levels(float fader, float& x, float& y) const;
 };
 
-inline
-ColorRGB fadeTo(float fader, Fade const& fade, ColorRGB const& in1, ColorRGB const& in2) {
+/** Shape the level of one input of a crossfade. */
+template <Fade::Type TYPE>
+float fadeCurve(float ratio);
+
+ColorRGB fadeTo(float fader, Fade const&, ColorRGB const&, ColorRGB const&);
+
+/** Crossfade two lists of float samples into `out`, which gets the length of
+    the shorter one.
+
+    The curve only changes the two levels, so it is applied once for the
+    whole list, and the lists are then mixed by the vectorized kernel in
+    mixSimd.h. */
+template <Fade::Type TYPE, typename List>
+void fadeOver(float fader, Fade const&, List const& in1, List const& in2,
+              List& out);
+
+/** The same, with the curve picked from `fade.type` once per list. */
+template <typename List>
+void fadeOver(float fader, Fade const&, List const& in1, List const& in2,
+              List& out);
+
+/** Mix many lists of float samples in one pass, so that
+    out[i] = levels[0] * inputs[0][i] + levels[1] * inputs[1][i] + ...
+
+    `out` gets the length of the shortest input, and may be one of the
+    inputs.  Large lists are split over the thread pool if parallelism()
+    says so. */
+template <typename List>
+void mix(std::vector<List const*> const& inputs,
+         std::vector<float> const& levels, List& out);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+template <>
+inline float fadeCurve<Fade::Type::linear>(float ratio) {
+    return ratio;
+}
+
+template <>
+inline float fadeCurve<Fade::Type::sqr>(float ratio) {
+    return ratio * ratio * signum(ratio);
+}
+
+template <>
+inline float fadeCurve<Fade::Type::sqrt>(float ratio) {
+    return std::sqrt(std::abs(ratio)) * signum(ratio);
+}
+
+template <Fade::Type TYPE>
+void Fade::levels(float fader, float& x, float& y) const {
+    // TODO: perhaps we should be applying end and begin after this step?
+    x = fadeCurve<TYPE>(begin + invert(fader) * (end - begin));
+    y = fadeCurve<TYPE>(begin + fader * (end - begin));
+}
+
+inline void Fade::levels(float fader, float& x, float& y) const {
+    switch (type) {
+        default:
+            return levels<Type::linear>(fader, x, y);
+        case Type::sqr:
+            return levels<Type::sqr>(fader, x, y);
+        case Type::sqrt:
+            return levels<Type::sqrt>(fader, x, y);
+    }
+}
+
+inline float Fade::operator()(float fader, float x, float y) const {
+    float xratio, yratio;
+    levels(fader, xratio, yratio);
+    return xratio * x + yratio * y;
+}
+
+inline ColorRGB fadeTo(float fader, Fade const& fade,
+                       ColorRGB const& in1, ColorRGB const& in2) {
+    float x, y;
+    fade.levels(fader, x, y);
+
     ColorRGB out;
     for (size_t i = 0; i < out.size(); ++i)
-        out[i] = fade(fader, in1[i], in2[i]);
+        out[i] = x * *in1[i] + y * *in2[i];
     return out;
 }
 
-#if 0
-void fadeOver(float fader, Fade const& fade,
-              ColorVector const& in1, ColorVector const& in2, ColorVector& out) {
-    auto size = std::min(in1.size(), in2.size());
+namespace detail {
+
+/** Index a list of lists as if it were an array of pointers to their
+    numbers, so the mix kernel reads them in place. */
+template <typename List>
+struct ListNumbers {
+    List const* const* lists;
+
+    float const* operator[](size_t k) const {
+        return reinterpret_cast<float const*>(lists[k]->data());
+    }
+};
+
+template <typename List>
+void mix(List const* const* inputs, float const* levels, size_t count,
+         List& out) {
+    using Sample = ValueType<List>;
+    static_assert(std::is_same<typename Sample::number_type, float>::value and
+                  sizeof(Sample) == Sample::SIZE * sizeof(float),
+                  "Samples must be a flat array of floats");
+
+    auto size = count ? inputs[0]->size() : 0;
+    for (size_t k = 1; k < count; ++k)
+        size = std::min(size, inputs[k]->size());
     out.resize(size);
-    for (size_t i = 0; i < size; ++i)
-        out[i] = fadeTo(fader, fade, in1[i], in2[i]);
+
+    // `out` only ever shrinks here, so an input that is also `out` keeps
+    // its data() while the kernel reads it.
+    ListNumbers<List> numbers{inputs};
+    auto o = reinterpret_cast<float*>(out.data());
+    auto level = simdLevel();
+    forChunks(size, [&](size_t begin, size_t end) {
+        simd::mix(level, numbers, levels, count, o, Sample::SIZE * begin,
+                  Sample::SIZE * end);
+    });
+}
+
+} // detail
+
+template <typename List>
+void mix(std::vector<List const*> const& inputs,
+         std::vector<float> const& levels, List& out) {
+    detail::mix(inputs.data(), levels.data(),
+                std::min(inputs.size(), levels.size()), out);
+}
+
+template <Fade::Type TYPE, typename List>
+void fadeOver(float fader, Fade const& fade, List const& in1,
+              List const& in2, List& out) {
+    List const* inputs[] = {&in1, &in2};
+    float levels[2];
+    fade.levels<TYPE>(fader, levels[0], levels[1]);
+    detail::mix(inputs, levels, 2, out);
+}
+
+template <typename List>
+void fadeOver(float fader, Fade const& fade, List const& in1,
+              List const& in2, List& out) {
+    List const* inputs[] = {&in1, &in2};
+    float levels[2];
+    fade.levels(fader, levels[0], levels[1]);
+    detail::mix(inputs, levels, 2, out);
 }
-#endif
 
 } // timedata
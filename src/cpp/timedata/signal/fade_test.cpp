@@ -0,0 +1,95 @@
+#pragma once
+
+#include <vector>
+
+#include <timedata/base/enum.h>
+#include <timedata/signal/fade.h>
+
+namespace timedata {
+namespace fade {
+
+inline ColorRGB::List fadeTestList(size_t size, float offset) {
+    ColorRGB::List list;
+    for (size_t i = 0; i < size; ++i) {
+        auto x = ((i * 7) % 11) / 10.0f + offset;
+        list.push_back({x, 1 - x, x * x});
+    }
+    return list;
+}
+
+TEST_CASE("fadeOver", "fade") {
+    auto in1 = fadeTestList(101, 0), in2 = fadeTestList(99, 0.5f);
+    forEach<Fade::Type>([&](Fade::Type type) {
+        Fade fade;
+        fade.type = type;
+        fade.begin = 0.1f;
+        for (auto fader: {0.0f, 0.3f, 1.0f}) {
+            ColorRGB::List out;
+            fadeOver(fader, fade, in1, in2, out);
+            REQUIRE(out.size() == in2.size());
+            for (size_t i = 0; i < out.size(); ++i) {
+                auto expected = fadeTo(fader, fade, in1[i], in2[i]);
+                REQUIRE(out[i] == expected);
+                REQUIRE(*out[i][0] == fade(fader, *in1[i][0], *in2[i][0]));
+            }
+        }
+    });
+}
+
+TEST_CASE("mix", "fade") {
+    std::vector<ColorRGB::List> lists;
+    std::vector<ColorRGB::List const*> inputs;
+    std::vector<float> levels;
+    for (size_t k = 0; k < 6; ++k) {
+        lists.push_back(fadeTestList(1000 + k, k / 6.0f));
+        levels.push_back(0.5f - k / 10.0f);
+    }
+    for (auto& l: lists)
+        inputs.push_back(&l);
+
+    ColorRGB::List expected;
+    mix(inputs, levels, expected);
+    REQUIRE(expected.size() == 1000);
+    for (size_t j = 0; j < 3; ++j) {
+        auto x = levels[0] * *lists[0][17][j];
+        for (size_t k = 1; k < lists.size(); ++k)
+            x += levels[k] * *lists[k][17][j];
+        REQUIRE(*expected[17][j] == x);
+    }
+
+    auto flat = [](ColorRGB::List const& l) {
+        return reinterpret_cast<float const*>(l.data());
+    };
+    std::vector<float const*> numbers;
+    for (auto& l: lists)
+        numbers.push_back(flat(l));
+
+    forEach<SimdLevel>([&](SimdLevel level) {
+        if (level > cpuSimdLevel())
+            return;
+        std::vector<float> out(3 * 1000);
+        simd::mix(level, numbers.data(), levels.data(), numbers.size(),
+                  out.data(), out.size());
+        for (size_t i = 0; i < out.size(); ++i)
+            REQUIRE(out[i] == flat(expected)[i]);
+    });
+
+    auto saved = parallelism();
+    parallelism().threshold = 1;
+    parallelism().grain = 77;
+    ColorRGB::List parallel;
+    mix(inputs, levels, parallel);
+    parallelism() = saved;
+    REQUIRE(parallel == expected);
+
+    // The output can be one of the inputs.
+    mix(inputs, levels, lists[0]);
+    REQUIRE(lists[0] == expected);
+
+    ColorRGB::List none;
+    mix({}, {}, none);
+    REQUIRE(none.empty());
+}
+
+} // fade
+} // timedata
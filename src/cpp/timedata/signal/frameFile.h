@@ -0,0 +1,371 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <timedata/base/className.h>
+#include <timedata/base/mappedFile.h>
+#include <timedata/signal/listView.h>
+
+namespace timedata {
+
+/** A frame file holds a fixed-rate sequence of frames, each of the same
+    number of Samples, so that long pre-rendered shows can be played back
+    straight from disk.  All numbers are in the byte order of the machine
+    that wrote the file.
+
+    The file starts with a 128-byte FrameHeader.  Then either:
+
+    * Raw frames follow, back to back, each `pixels * sampleSize` bytes long.
+      Frame `i` is at `sizeof(FrameHeader) + i * pixels * sampleSize`, and
+      playing it is just a pointer into the mapped file.
+
+    * Or, if the DELTA flag is set, each frame is a record of the runs of
+      Samples that changed from the frame before - except that every
+      `keyframeInterval` frames is a keyframe holding the whole frame.
+      Records are aligned to eight bytes, and each is a uint32_t run count
+      and four bytes of padding, then for each run, a uint32_t begin and a
+      uint32_t count and then `count` Samples, padded to eight bytes.  At
+      `index` there's a table of the uint64_t offsets of each record. */
+struct FrameHeader {
+    static const uint32_t VERSION = 1;
+    static const uint32_t DELTA = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    char sampleName[32];
+    uint32_t sampleSize;
+    uint32_t keyframeInterval;
+    uint64_t pixels;
+    uint64_t frames;
+    uint64_t index;
+    double frameRate;
+    char reserved[40];
+};
+
+static_assert(sizeof(FrameHeader) == 128, "FrameHeader must be 128 bytes");
+
+/** Writes a frame file, one frame at a time.  Any errors throw
+    std::runtime_error. */
+template <typename Sample>
+class FrameWriter {
+  public:
+    /** If keyframeInterval is 0, frames are written raw; otherwise they are
+        delta-compressed with a keyframe every keyframeInterval frames. */
+    FrameWriter(std::string const& filename, size_t pixels, double frameRate,
+                size_t keyframeInterval = 0);
+    ~FrameWriter();
+
+    /** Write one frame, which must have exactly `pixels` Samples. */
+    template <typename List>
+    void write(List const&);
+
+    /** Finish the file.  Called by the destructor if needed - but only an
+        explicit call reports errors. */
+    void close();
+
+  private:
+    void writeRaw(Sample const*);
+    void writeDelta(Sample const*);
+    void writeRun(size_t begin, size_t end, Sample const*);
+    void pad();
+    void check();
+
+    std::string filename_;
+    std::ofstream out_;
+    FrameHeader header_;
+    std::vector<uint64_t> index_;
+    std::vector<Sample> previous_;
+    std::vector<std::pair<size_t, size_t>> runs_;
+};
+
+/** Reads a frame file through a MappedFile.
+
+    Throws std::runtime_error if the file can't be read, or was written for
+    a different Sample type. */
+template <typename Sample>
+class FrameFile {
+  public:
+    explicit FrameFile(std::string const& filename);
+
+    FrameHeader const& header() const { return header_; }
+
+    size_t size() const { return header_.frames; }
+    size_t pixels() const { return header_.pixels; }
+    double frameRate() const { return header_.frameRate; }
+    bool isDelta() const { return header_.flags & FrameHeader::DELTA; }
+
+    /** A read-only view of frame `i`.
+
+        For a raw file, the view points straight into the mapped file and
+        stays good as long as the FrameFile does.  For a delta file, the
+        changes since the last frame asked for - or since the keyframe
+        before `i` - are applied to a buffer that the view points into, and
+        the view is only good until the next call to frame(). */
+    ListView<Sample> frame(size_t i);
+
+  private:
+    static const size_t NONE = std::numeric_limits<size_t>::max();
+
+    template <typename T>
+    T read(size_t offset) const;
+
+    void applyDelta(size_t frame);
+    void corrupt() const;
+
+    MappedFile file_;
+    FrameHeader header_;
+    std::vector<Sample> buffer_;
+    size_t current_ = NONE;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+static const char FRAME_MAGIC[8] = {'T', 'D', 'F', 'R', 'A', 'M', 'E', 'S'};
+
+/** The bytes used by a run's begin and count. */
+static const size_t FRAME_RUN_HEADER = 2 * sizeof(uint32_t);
+
+inline size_t frameAlign(size_t x) {
+    return (x + 7) & ~size_t(7);
+}
+
+} // detail
+
+template <typename Sample>
+FrameWriter<Sample>::FrameWriter(
+        std::string const& filename, size_t pixels, double frameRate,
+        size_t keyframeInterval)
+        : filename_(filename),
+          out_(filename, std::ios::binary | std::ios::trunc) {
+    std::memset(&header_, 0, sizeof(header_));
+    std::memcpy(header_.magic, detail::FRAME_MAGIC, sizeof(header_.magic));
+    header_.version = FrameHeader::VERSION;
+    header_.flags = keyframeInterval ? FrameHeader::DELTA : 0;
+
+    auto name = className<Sample>();
+    if (name.size() >= sizeof(header_.sampleName))
+        throw std::runtime_error("Sample name too long: " + name);
+    std::memcpy(header_.sampleName, name.data(), name.size());
+
+    header_.sampleSize = sizeof(Sample);
+    header_.keyframeInterval = static_cast<uint32_t>(keyframeInterval);
+    header_.pixels = pixels;
+    header_.frameRate = frameRate;
+
+    // Placeholder, rewritten by close().
+    out_.write(reinterpret_cast<char const*>(&header_), sizeof(header_));
+    check();
+}
+
+template <typename Sample>
+FrameWriter<Sample>::~FrameWriter() {
+    try {
+        close();
+    } catch (...) {
+    }
+}
+
+template <typename Sample>
+template <typename List>
+void FrameWriter<Sample>::write(List const& frame) {
+    if (frame.size() != header_.pixels)
+        throw std::runtime_error("Wrong frame size for " + filename_);
+
+    if (header_.flags & FrameHeader::DELTA)
+        writeDelta(frame.data());
+    else
+        writeRaw(frame.data());
+    ++header_.frames;
+    check();
+}
+
+template <typename Sample>
+void FrameWriter<Sample>::writeRaw(Sample const* frame) {
+    out_.write(reinterpret_cast<char const*>(frame),
+               header_.pixels * sizeof(Sample));
+}
+
+template <typename Sample>
+void FrameWriter<Sample>::writeDelta(Sample const* frame) {
+    auto pixels = static_cast<size_t>(header_.pixels);
+    runs_.clear();
+    if (header_.frames % header_.keyframeInterval == 0) {
+        runs_.emplace_back(0, pixels);
+    } else {
+        // Bridge gaps that cost less to copy than to start a new run.
+        auto bridge = detail::FRAME_RUN_HEADER / sizeof(Sample);
+        for (size_t i = 0; i < pixels; ++i) {
+            if (not std::memcmp(&frame[i], &previous_[i], sizeof(Sample)))
+                continue;
+            if (not runs_.empty() and i - runs_.back().second <= bridge)
+                runs_.back().second = i + 1;
+            else
+                runs_.emplace_back(i, i + 1);
+        }
+    }
+
+    index_.push_back(static_cast<uint64_t>(out_.tellp()));
+    uint32_t head[2] = {static_cast<uint32_t>(runs_.size()), 0};
+    out_.write(reinterpret_cast<char const*>(head), sizeof(head));
+    for (auto& r: runs_)
+        writeRun(r.first, r.second, frame);
+
+    previous_.assign(frame, frame + pixels);
+}
+
+template <typename Sample>
+void FrameWriter<Sample>::writeRun(
+        size_t begin, size_t end, Sample const* frame) {
+    uint32_t head[2] = {static_cast<uint32_t>(begin),
+                        static_cast<uint32_t>(end - begin)};
+    out_.write(reinterpret_cast<char const*>(head), sizeof(head));
+    out_.write(reinterpret_cast<char const*>(frame + begin),
+               (end - begin) * sizeof(Sample));
+    pad();
+}
+
+template <typename Sample>
+void FrameWriter<Sample>::pad() {
+    static const char ZEROS[8] = {};
+    auto position = static_cast<size_t>(out_.tellp());
+    out_.write(ZEROS, detail::frameAlign(position) - position);
+}
+
+template <typename Sample>
+void FrameWriter<Sample>::close() {
+    if (not out_.is_open())
+        return;
+
+    if (header_.flags & FrameHeader::DELTA) {
+        header_.index = static_cast<uint64_t>(out_.tellp());
+        out_.write(reinterpret_cast<char const*>(index_.data()),
+                   index_.size() * sizeof(uint64_t));
+    }
+    out_.seekp(0);
+    out_.write(reinterpret_cast<char const*>(&header_), sizeof(header_));
+    check();
+    out_.close();
+    check();
+}
+
+template <typename Sample>
+void FrameWriter<Sample>::check() {
+    if (not out_)
+        throw std::runtime_error("Can't write " + filename_);
+}
+
+template <typename Sample>
+FrameFile<Sample>::FrameFile(std::string const& filename) : file_(filename) {
+    if (file_.size() < sizeof(header_))
+        corrupt();
+    std::memcpy(&header_, file_.data(), sizeof(header_));
+
+    if (std::memcmp(header_.magic, detail::FRAME_MAGIC, sizeof(header_.magic)))
+        throw std::runtime_error("Not a frame file: " + filename);
+    if (header_.version != FrameHeader::VERSION)
+        throw std::runtime_error("Unknown frame file version: " + filename);
+
+    header_.sampleName[sizeof(header_.sampleName) - 1] = 0;
+    if (header_.sampleName != className<Sample>() or
+        header_.sampleSize != sizeof(Sample)) {
+        throw std::runtime_error(
+            filename + " holds " + header_.sampleName + ", not " +
+            className<Sample>());
+    }
+
+    // Every size is checked by dividing the space left in the file, never
+    // by multiplying numbers from the header, which could overflow.
+    auto rest = file_.size() - sizeof(header_);
+    if (header_.pixels > rest / sizeof(Sample))
+        corrupt();
+    auto pixels = static_cast<size_t>(header_.pixels);
+    auto frameBytes = pixels * sizeof(Sample);
+
+    if (isDelta()) {
+        if (not header_.keyframeInterval or header_.index > file_.size())
+            corrupt();
+        auto indexBytes = file_.size() - header_.index;
+        if (header_.frames > indexBytes / sizeof(uint64_t))
+            corrupt();
+        buffer_.resize(pixels);
+    } else if (frameBytes and header_.frames > rest / frameBytes) {
+        corrupt();
+    }
+}
+
+template <typename Sample>
+ListView<Sample> FrameFile<Sample>::frame(size_t i) {
+    if (i >= size())
+        throw std::out_of_range("No frame " + std::to_string(i));
+
+    if (not isDelta()) {
+        auto offset = sizeof(header_) + i * pixels() * sizeof(Sample);
+        auto data = reinterpret_cast<Sample const*>(file_.data() + offset);
+        return {data, pixels()};
+    }
+
+    auto keyframe = i - i % header_.keyframeInterval;
+    auto f = keyframe;
+    if (current_ != NONE and current_ >= keyframe and current_ <= i)
+        f = current_ + 1;
+
+    for (; f <= i; ++f)
+        applyDelta(f);
+    current_ = i;
+    return {buffer_.data(), buffer_.size()};
+}
+
+template <typename Sample>
+template <typename T>
+T FrameFile<Sample>::read(size_t offset) const {
+    if (offset > file_.size() or sizeof(T) > file_.size() - offset)
+        corrupt();
+    T t;
+    std::memcpy(&t, file_.data() + offset, sizeof(T));
+    return t;
+}
+
+template <typename Sample>
+void FrameFile<Sample>::applyDelta(size_t frame) {
+    auto offset = read<uint64_t>(header_.index + frame * sizeof(uint64_t));
+    auto runs = read<uint32_t>(offset);
+    offset += 2 * sizeof(uint32_t);
+
+    for (uint32_t r = 0; r < runs; ++r) {
+        auto begin = size_t(read<uint32_t>(offset));
+        auto count = size_t(read<uint32_t>(offset + sizeof(uint32_t)));
+        offset += detail::FRAME_RUN_HEADER;
+
+        // read() has checked that offset is inside the file.
+        auto bytes = count * sizeof(Sample);
+        if (begin > buffer_.size() or count > buffer_.size() - begin or
+            bytes > file_.size() - offset) {
+            corrupt();
+        }
+        std::memcpy(reinterpret_cast<char*>(buffer_.data() + begin),
+                    file_.data() + offset, bytes);
+        offset = detail::frameAlign(offset + bytes);
+    }
+}
+
+template <typename Sample>
+void FrameFile<Sample>::corrupt() const {
+    throw std::runtime_error("Corrupt frame file");
+}
+
+} // timedata
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+
+#include <timedata/color/renderer_inl.h>
+#include <timedata/signal/frameFile.h>
+
+namespace timedata {
+namespace frame_file {
+
+/** A unique name for a file in the temporary directory, which is removed
+    when the TempFile is destroyed. */
+struct TempFile {
+    std::string name;
+
+    explicit TempFile(std::string const& base) {
+        char const* directory = nullptr;
+        for (auto v: {"TMPDIR", "TEMP", "TMP"}) {
+            if ((directory = std::getenv(v)))
+                break;
+        }
+        name = std::string(directory ? directory : "/tmp") + "/" + base +
+            "-" + std::to_string(std::random_device()()) + ".tdframes";
+    }
+
+    ~TempFile() { std::remove(name.c_str()); }
+};
+
+inline ColorRGB::List testFrame(size_t frame, size_t pixels) {
+    ColorRGB::List colors;
+    for (size_t i = 0; i < pixels; ++i) {
+        // Only a few pixels change each frame.
+        auto j = (i % 10 == frame % 10) ? i + frame : i;
+        colors.emplace_back((j % 7) / 6.0f, (j % 11) / 10.0f, (j % 5) / 4.0f);
+    }
+    return colors;
+}
+
+TEST_CASE("frameFile", "frameFile") {
+    static const size_t FRAMES = 25, PIXELS = 300;
+    TempFile temp("frameFile_test");
+    auto& filename = temp.name;
+
+    for (size_t keyframes: {0, 1, 10}) {
+        {
+            FrameWriter<ColorRGB> writer(filename, PIXELS, 40.0, keyframes);
+            for (size_t f = 0; f < FRAMES; ++f)
+                writer.write(testFrame(f, PIXELS));
+            writer.close();
+        }
+
+        FrameFile<ColorRGB> file(filename);
+        REQUIRE(file.size() == FRAMES);
+        REQUIRE(file.pixels() == PIXELS);
+        REQUIRE(file.frameRate() == 40.0);
+        REQUIRE(file.isDelta() == bool(keyframes));
+
+        // In order, then seeking backwards and forwards.
+        for (size_t f: {0, 1, 2, 3, 9, 10, 11, 24, 5, 17, 16, 0, 23}) {
+            auto view = file.frame(f);
+            auto expected = testFrame(f, PIXELS);
+            REQUIRE(view.size() == PIXELS);
+            REQUIRE(std::equal(view.begin(), view.end(), expected.begin()));
+        }
+        REQUIRE_THROWS_AS(file.frame(FRAMES), std::out_of_range const&);
+        REQUIRE_THROWS_AS(FrameFile<ColorRGB255>{filename},
+                          std::runtime_error const&);
+    }
+
+    // Header sizes whose products overflow are rejected, not wrapped.
+    auto patch = [&](size_t offset, uint64_t value) {
+        std::fstream f(filename, std::ios::binary | std::ios::in |
+                       std::ios::out);
+        f.seekp(offset);
+        f.write(reinterpret_cast<char const*>(&value), sizeof(value));
+    };
+    auto frames = offsetof(FrameHeader, frames);
+    auto index = offsetof(FrameHeader, index);
+
+    patch(frames, uint64_t(1) << 61);
+    REQUIRE_THROWS_AS(FrameFile<ColorRGB>{filename},
+                      std::runtime_error const&);
+    patch(index, ~uint64_t(0) - 100);
+    REQUIRE_THROWS_AS(FrameFile<ColorRGB>{filename},
+                      std::runtime_error const&);
+    patch(offsetof(FrameHeader, pixels), uint64_t(1) << 62);
+    REQUIRE_THROWS_AS(FrameFile<ColorRGB>{filename},
+                      std::runtime_error const&);
+
+    {
+        FrameWriter<ColorRGB> writer(filename, PIXELS, 40.0);
+        writer.write(testFrame(0, PIXELS));
+    }
+    patch(frames, (uint64_t(1) << 63) / (PIXELS * sizeof(ColorRGB)) * 2 + 1);
+    REQUIRE_THROWS_AS(FrameFile<ColorRGB>{filename},
+                      std::runtime_error const&);
+}
+
+TEST_CASE("frameFile render", "frameFile") {
+    TempFile temp("frameFile_render");
+    auto& filename = temp.name;
+    auto frame = testFrame(3, 100);
+    {
+        FrameWriter<ColorRGB> writer(filename, frame.size(), 30.0);
+        writer.write(frame);
+    }
+
+    FrameFile<ColorRGB> file(filename);
+    color_list::CRenderer renderer{Render3()};
+    std::string expected(frame.size() * renderer.stride(), '\0');
+    auto actual = expected;
+    renderer.render(0.5f, frame, 0, frame.size(), &expected[0]);
+    renderer.render(0.5f, file.frame(0), 0, frame.size(), &actual[0]);
+    REQUIRE(actual == expected);
+}
+
+} // frame_file
+} // timedata
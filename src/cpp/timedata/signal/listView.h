@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace timedata {
+
+/** A read-only view of `size` contiguous Samples owned by someone else - for
+    example, one frame of a memory-mapped file.
+
+    A ListView has the same types and read-only interface as a `Sample::List`
+    - including data() - so code templated on the list type, like
+    CRenderer::render, takes one directly.  Nothing is copied, and the view
+    is only good as long as the memory it points to. */
+template <typename Sample>
+class ListView {
+  public:
+    using model_type = typename Sample::model_type;
+    using number_type = typename Sample::number_type;
+    using range_type = typename Sample::range_type;
+    using ranged_type = typename Sample::value_type;
+    using sample_type = Sample;
+    using value_type = Sample;
+    using const_iterator = Sample const*;
+
+    using is_container = std::true_type;
+
+    ListView() = default;
+    ListView(Sample const* data, size_t size) : data_(data), size_(size) {}
+
+    Sample const* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return not size_; }
+
+    Sample const& operator[](size_t i) const { return data_[i]; }
+
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+
+  private:
+    Sample const* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // timedata
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+
+#include <timedata/base/cpu.h>
+#include <timedata/base/simdMath.h>
+
+namespace timedata {
+namespace simd {
+
+/** out[i] = levels[0] * inputs[0][i] + levels[1] * inputs[1][i] + ...
+    for `count` inputs, each of `size` floats, all in one pass.
+
+    Every SimdLevel adds the terms in the same order, so they all give
+    exactly the same numbers.  `out` may be one of the inputs. */
+void mix(float const* const* inputs, float const* levels, size_t count,
+         float* out, size_t size);
+
+/** The same, at a specific SimdLevel - useful for testing. */
+void mix(SimdLevel, float const* const* inputs, float const* levels,
+         size_t count, float* out, size_t size);
+
+/** The same for only the numbers in [begin, end).  `inputs[k]` need only
+    give a float const*, so callers can read the pointers straight out of
+    their own containers rather than copying them into an array. */
+template <typename Inputs>
+void mix(SimdLevel, Inputs const& inputs, float const* levels, size_t count,
+         float* out, size_t begin, size_t end);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+struct ScalarMix {
+    template <typename Inputs>
+    static void mix(Inputs const& inputs, float const* levels,
+                    size_t count, float* out, size_t begin, size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            auto x = count ? levels[0] * inputs[0][i] : 0.0f;
+            for (size_t k = 1; k < count; ++k)
+                x += levels[k] * inputs[k][i];
+            out[i] = x;
+        }
+    }
+};
+
+#if TIMEDATA_SIMD_X86
+
+struct Avx2Mix {
+    using V = __m256;
+    static const size_t WIDTH = 8;
+
+    template <typename Inputs>
+    TIMEDATA_TARGET("avx2")
+    static void mix(Inputs const& inputs, float const* levels,
+                    size_t count, float* out, size_t begin, size_t end) {
+        if (not count)
+            return ScalarMix::mix(inputs, levels, count, out, begin, end);
+
+        auto i = begin;
+        for (; i + WIDTH <= end; i += WIDTH) {
+            auto x = _mm256_mul_ps(_mm256_set1_ps(levels[0]),
+                                   _mm256_loadu_ps(inputs[0] + i));
+            for (size_t k = 1; k < count; ++k) {
+                x = _mm256_add_ps(x, _mm256_mul_ps(
+                    _mm256_set1_ps(levels[k]), _mm256_loadu_ps(inputs[k] + i)));
+            }
+            _mm256_storeu_ps(out + i, x);
+        }
+        ScalarMix::mix(inputs, levels, count, out, i, end);
+    }
+};
+
+#endif  // TIMEDATA_SIMD_X86
+
+template <typename Inputs>
+void mix(SimdLevel level, Inputs const& inputs, float const* levels,
+         size_t count, float* out, size_t begin, size_t end) {
+    TIMEDATA_DISPATCH(level, ScalarMix, Avx2Mix,
+                      Kernel::mix(inputs, levels, count, out, begin, end));
+}
+
+inline void mix(SimdLevel level, float const* const* inputs,
+                float const* levels, size_t count, float* out, size_t size) {
+    mix(level, inputs, levels, count, out, 0, size);
+}
+
+inline void mix(float const* const* inputs, float const* levels,
+                size_t count, float* out, size_t size) {
+    mix(simdLevel(), inputs, levels, count, out, size);
+}
+
+} // simd
+} // timedata
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+#include <timedata/base/alignedAllocator.h>
+#include <timedata/signal/sample.h>
+
+namespace timedata {
+
+/** A PlanarList holds the same data as a `Sample::List`, but "planar" or
+    "structure-of-arrays" instead of interleaved: each component of the Sample
+    lives in its own contiguous, cache-line aligned array.
+
+    So a `PlanarList<ColorRGB>` is three arrays - all the reds, then all the
+    greens, then all the blues - which means that every element-wise operation
+    becomes a simple loop over a flat array of numbers which the compiler (or
+    our hand-written kernels) can vectorize.
+
+    Convert to and from the interleaved form with `deinterleave` and
+    `interleave` - the idea is to keep large lists planar through a whole chain
+    of effects and only interleave at render time.
+*/
+template <typename Sample>
+class PlanarList {
+  public:
+    using model_type = typename Sample::model_type;
+    using range_type = typename Sample::range_type;
+    using sample_type = Sample;
+    using value_type = Sample;
+    using ranged_type = typename Sample::value_type;
+    using number_type = typename Sample::number_type;
+    using List = typename Sample::List;
+
+    using is_container = std::true_type;
+
+    static const auto SIZE = Sample::SIZE;
+
+    using Channel = AlignedVector<number_type>;
+
+    PlanarList() = default;
+    explicit PlanarList(size_t size) { resize(size); }
+    explicit PlanarList(List const& list) { deinterleave(list, *this); }
+
+    size_t size() const { return channels_[0].size(); }
+    bool empty() const { return not size(); }
+
+    void resize(size_t size) {
+        for (auto& c: channels_)
+            c.resize(size);
+    }
+
+    void reserve(size_t size) {
+        for (auto& c: channels_)
+            c.reserve(size);
+    }
+
+    void clear() {
+        for (auto& c: channels_)
+            c.clear();
+    }
+
+    number_type* channel(size_t i) { return channels_[i].data(); }
+    number_type const* channel(size_t i) const { return channels_[i].data(); }
+
+    /** Gather one Sample from all the channels. */
+    Sample operator[](size_t i) const {
+        Sample s;
+        for (size_t j = 0; j < SIZE; ++j)
+            s[j] = channels_[j][i];
+        return s;
+    }
+
+    /** Scatter one Sample to all the channels. */
+    void set(size_t i, Sample const& s) {
+        for (size_t j = 0; j < SIZE; ++j)
+            channels_[j][i] = s[j];
+    }
+
+    void push_back(Sample const& s) {
+        for (size_t j = 0; j < SIZE; ++j)
+            channels_[j].push_back(s[j]);
+    }
+
+    List toList() const {
+        List list;
+        interleave(*this, list);
+        return list;
+    }
+
+    bool operator==(PlanarList const& x) const {
+        return channels_ == x.channels_;
+    }
+
+    bool operator!=(PlanarList const& x) const {
+        return channels_ != x.channels_;
+    }
+
+  private:
+    std::array<Channel, SIZE> channels_;
+};
+
+/** Copy an interleaved Sample::List into a PlanarList, resizing it. */
+template <typename Sample>
+void deinterleave(typename Sample::List const& in, PlanarList<Sample>& out) {
+    auto size = in.size();
+    out.resize(size);
+    for (size_t j = 0; j < Sample::SIZE; ++j) {
+        auto o = out.channel(j);
+        for (size_t i = 0; i < size; ++i)
+            o[i] = in[i][j];
+    }
+}
+
+/** Copy a PlanarList into an interleaved Sample::List, resizing it. */
+template <typename Sample>
+void interleave(PlanarList<Sample> const& in, typename Sample::List& out) {
+    auto size = in.size();
+    out.resize(size);
+    for (size_t j = 0; j < Sample::SIZE; ++j) {
+        auto i = in.channel(j);
+        for (size_t k = 0; k < size; ++k)
+            out[k][j] = i[k];
+    }
+}
+
+template <typename Sample>
+size_t getSizeof(PlanarList<Sample> const& x) {
+    return sizeof(x) + sizeof(Sample) * x.size();
+}
+
+}  // timedata
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <timedata/color/cython_list_inl.h>
+#include <timedata/signal/planar.h>
+
+namespace timedata {
+namespace planar {
+
+using color_list::CColorListRGB;
+using color_list::CPlanarListRGB;
+
+inline CColorListRGB testList(size_t size) {
+    CColorListRGB list;
+    for (size_t i = 0; i < size; ++i)
+        list.push_back({(i + 1) / 7.0f, 1.5f - i / 11.0f, (i % 5) - 2.5f});
+    return list;
+}
+
+TEST_CASE("planar round trip", "planar") {
+    auto list = testList(37);
+    CPlanarListRGB planar(list);
+    REQUIRE(planar.size() == 37);
+    REQUIRE(planar[3] == list[3]);
+    REQUIRE(planar.toList() == list);
+
+    for (size_t j = 0; j < 3; ++j) {
+        auto address = reinterpret_cast<uintptr_t>(planar.channel(j));
+        REQUIRE(address % CACHE_LINE == 0);
+    }
+}
+
+TEST_CASE("planar math", "planar") {
+    auto x = testList(29), y = testList(29), out = testList(0);
+    std::reverse(y.begin(), y.end());
+    CPlanarListRGB px(x), py(y), pout;
+
+    color_list::math_add(x, y, out);
+    color_list::math_add(px, py, pout);
+    REQUIRE(pout.toList() == out);
+
+    color_list::math_mul(x, 2.5f, out);
+    color_list::math_mul(px, 2.5f, pout);
+    REQUIRE(pout.toList() == out);
+
+    color::CColorRGB sample{0.5f, 2.0f, -1.0f};
+    color_list::math_rdiv(x, sample, out);
+    color_list::math_rdiv(px, sample, pout);
+    REQUIRE(pout.toList() == out);
+
+    color_list::math_abs(x, out);
+    color_list::math_abs(px, pout);
+    REQUIRE(pout.toList() == out);
+
+    color_list::math_zero(pout);
+    REQUIRE(pout.toList() == CColorListRGB(29));
+}
+
+} // planar
+} // timedata
@@ -1,48 +1,110 @@
 #pragma once
 
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
 #include <timedata/base/math.h>
 
 namespace timedata {
 
+/** The type of a range's START and RANGE constants: the value_type itself
+    for built-in numbers, and float for storage-only types like Half. */
+template <typename T>
+using ConstantType = typename std::conditional<
+    std::is_arithmetic<T>::value, T, float>::type;
+
 template <typename T = float>
 struct Normal {
     using value_type = T;
 
-    static constexpr auto START = value_type(0);
-    static constexpr auto RANGE = value_type(1);
+    static constexpr auto START = ConstantType<T>(0);
+    static constexpr auto RANGE = ConstantType<T>(1);
 };
 
 template <typename T = float>
 struct Range256 {
     using value_type = T;
 
-    static constexpr auto START = value_type(0);
-    static constexpr auto RANGE = value_type(256);
+    static constexpr auto START = ConstantType<T>(0);
+    static constexpr auto RANGE = ConstantType<T>(256);
 };
 
 template <typename T = float>
 struct Range255 {
     using value_type = T;
 
-    static constexpr auto START = value_type(0);
-    static constexpr auto RANGE = value_type(255);
+    static constexpr auto START = ConstantType<T>(0);
+    static constexpr auto RANGE = ConstantType<T>(255);
+};
+
+/** The full range of a 16-bit unsigned integer.  Use with uint16_t storage
+    for high-resolution output. */
+template <typename T = float>
+struct Range65535 {
+    using value_type = T;
+
+    static constexpr auto START = ConstantType<T>(0);
+    static constexpr auto RANGE = ConstantType<T>(65535);
 };
 
 template <typename T>
 using ValueType = typename T::value_type;
 
+/** The type a ranged number unscales to: the range's own value_type for
+    float and double, and otherwise float - for a range stored in integers
+    like `Range255<uint8_t>`, or in Halves. */
+template <typename Range>
+using UnscaledType = typename std::conditional<
+    std::is_floating_point<ValueType<Range>>::value,
+    ValueType<Range>, float>::type;
+
 /** Unscale a ranged number to a range of [0, 1].  Numbers out of band get
     scaled proportionately. */
 template <typename Range>
-ValueType<Range> unscale(ValueType<Range> x) {
-    return (x - Range::START) / Range::RANGE;
-}
+UnscaledType<Range> unscale(ValueType<Range> x);
 
 /** Scale a number with a range of [0, 1] to a ranged number.
-    Numbers out of band get scaled proportionately. */
+    Numbers out of band get scaled proportionately - except for integer
+    storage, where they are clamped to the integer type and rounded to the
+    nearest integer, so that integer -> float -> integer is lossless. */
+template <typename Range>
+ValueType<Range> scale(UnscaledType<Range> y);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation details follow.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+template <typename T>
+T fromUnscaled(float x, std::true_type) {
+    using Limits = std::numeric_limits<T>;
+    auto lowest = float(Limits::lowest()), max = float(Limits::max());
+    return T(std::lround(std::max(lowest, std::min(max, x))));
+}
+
+template <typename T, typename U>
+T fromUnscaled(U x, std::false_type) {
+    return x;
+}
+
+} // detail
+
+template <typename Range>
+UnscaledType<Range> unscale(ValueType<Range> x) {
+    using U = UnscaledType<Range>;
+    return (U(x) - U(Range::START)) / U(Range::RANGE);
+}
+
 template <typename Range>
-ValueType<Range> scale(ValueType<Range> y) {
-    return Range::START + y * Range::RANGE;
+ValueType<Range> scale(UnscaledType<Range> y) {
+    using T = ValueType<Range>;
+    using U = UnscaledType<Range>;
+    return detail::fromUnscaled<T>(U(Range::START) + y * U(Range::RANGE),
+                                   std::is_integral<T>());
 }
 
 }  // timedata
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <limits>
+#include <type_traits>
+#include <timedata/base/saturate.h>
 #include <timedata/signal/range.h>
 
 namespace timedata {
@@ -10,12 +13,21 @@ namespace timedata {
     "Generic" means that there is no cost at run-time to carrying this
     information around - the downside is that we have to instantiate a new
     template for each range we want, but since the total number is very small,
-    this is almost free. */
+    this is almost free.
+
+    If the Range's value_type is an unsigned integer, like `Range255<uint8_t>`,
+    then addition, subtraction and multiplication saturate at the ends of the
+    integer type rather than wrapping around.
+
+    If it's a storage-only type, like Half, then a Ranged is made from and
+    widens to float, and all its arithmetic and comparisons are done in
+    float. */
 template <typename Range = Normal<>>
 class Ranged {
   public:
     using value_type = ValueType<Range>;
     using range_type = Range;
+    using unscaled_type = UnscaledType<Range>;
 
     static constexpr auto START = Range::START;
     static constexpr auto RANGE = Range::RANGE;
@@ -27,11 +39,15 @@ class Ranged {
 
     // TODO: should be explicit
     Ranged(value_type n) : value_(n) {}
+
+    template <typename T = value_type, typename = typename std::enable_if<
+                  not std::is_arithmetic<T>::value>::type>
+    Ranged(ConstantType<T> n) : value_(n) {}
     Ranged& operator=(Ranged const&) = default;
 
     static
-    Ranged scale(value_type v) { return timedata::scale<Range>(v); }
-    value_type unscale() const { return timedata::unscale<Range>(value_); }
+    Ranged scale(unscaled_type v) { return timedata::scale<Range>(v); }
+    unscaled_type unscale() const { return timedata::unscale<Range>(value_); }
 
     Ranged invert() const {
         // TODO: this is basically bogus for the general case.  :-)
@@ -61,30 +77,40 @@ class Ranged {
     operator value_type&() { return value_; }
     operator value_type const&() const { return value_; }
 
+    template <typename T = value_type, typename = typename std::enable_if<
+                  not std::is_arithmetic<T>::value>::type>
+    operator ConstantType<T>() const { return value_; }
+
     value_type& operator*() { return value_; }
     value_type const &operator*() const { return value_; }
 
     Ranged operator-() const { return {-value_}; }
 
-    Ranged operator+(Ranged const& x) const { return value_ + x.value_; }
-    Ranged operator-(Ranged const& x) const { return value_ - x.value_; }
-    Ranged operator*(Ranged const& x) const { return value_ * x.value_; }
+    Ranged operator+(Ranged const& x) const {
+        return addSaturate(value_, x.value_);
+    }
+    Ranged operator-(Ranged const& x) const {
+        return subSaturate(value_, x.value_);
+    }
+    Ranged operator*(Ranged const& x) const {
+        return mulSaturate(value_, x.value_);
+    }
     Ranged operator/(Ranged const& x) const {
         return divPython(value_, x.value_);
     }
 
     Ranged& operator+=(Ranged const& x) {
-        value_ += x.value_;
+        value_ = addSaturate(value_, x.value_);
         return *this;
     }
 
     Ranged& operator-=(Ranged const& x) {
-        value_ -= x.value_;
+        value_ = subSaturate(value_, x.value_);
         return *this;
     }
 
     Ranged& operator*=(Ranged const& x) {
-        value_ *= x.value_;
+        value_ = mulSaturate(value_, x.value_);
         return *this;
     }
 
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cstddef>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -81,8 +82,13 @@ struct Sample : SampleBase<Model, Range> {
 
     static const auto SIZE = enumSize<Model>();
 
-    using ListBase = std::vector<Sample>;
-    struct List : ListBase {
+    /** A list of Samples with a choice of allocator - for example, the
+        ArenaAllocator from base/arena.h or the PoolAllocator from
+        base/pool.h, so that temporaries needn't touch the heap.  Most code
+        uses the default, `List`. */
+    template <typename Allocator = std::allocator<Sample>>
+    struct BasicList : std::vector<Sample, Allocator> {
+        using ListBase = std::vector<Sample, Allocator>;
         using ListBase::ListBase;
 
         using model_type = Model;
@@ -104,7 +110,7 @@ struct Sample : SampleBase<Model, Range> {
 
             using is_container = std::false_type;
 
-            List& list;
+            BasicList& list;
             size_t index;
 
             size_t size() const { return SIZE; }
@@ -115,6 +121,8 @@ struct Sample : SampleBase<Model, Range> {
         };
     };
 
+    using List = BasicList<>;
+
     // TODO: need to use std::initializer_list!
     Sample(value_type r, value_type g, value_type b)
             : base_type{{r, g, b}} {
@@ -31,6 +31,11 @@ methods = add_methods(
             'max_limit',
             'min_limit',
             ),
+        return_number=(
+            ('delta_e',
+             'Return the mean perceptual distance (CIE76 deltaE) between '
+             'corresponding colors of this $classname and x.'),
+            ),
         ),
 )
 
@@ -32,6 +32,9 @@ methods = add_methods(
             ('distance2',
              """Return the square of the distance between this $classname and x.
             This is significantly faster than the distance method."""),
+            ('delta_e',
+             'Return the perceptual distance (CIE76 deltaE) between this '
+             '$classname and x.'),
             ),
 	),
 
@@ -7,8 +7,13 @@ def make_enums(enum_classes, header_file, namespace, classname):
             parts.pop()
         enums.append((enum_name, parts))
         main = ENUM_CLASS_TEMPLATE.format(**locals())
-        defs = '    cdef %s %s' % (enum_name, ', '.join(parts))
-        declarations.append(main + defs)
+        # Enumerators are module-level names in Cython, so they get the
+        # struct and enum as a prefix to keep Blend::Mode::add and
+        # Fade::Type::sqrt from colliding with each other or anything else.
+        defs = []
+        for value in parts:
+            defs.append(ENUM_VALUE_TEMPLATE.format(**locals()))
+        declarations.append(main + '\n'.join(defs))
 
     decl = '\n\n'.join(declarations)
     if decl:
@@ -50,6 +55,10 @@ cdef extern from "<{header_file}>" namespace "{namespace}::{classname}":
 cdef extern from "<{header_file}>" namespace "{namespace}::{classname}::{enum_name}":
 """
 
+ENUM_VALUE_TEMPLATE = (
+    '    cdef {enum_name} {classname}_{enum_name}_{value} '
+    '"{namespace}::{classname}::{enum_name}::{value}"')
+
 ENUM_CLASS_TEMPLATE = (
     ENUM_CLASS_HEADER_TEMPLATE +
     ENUM_CLASS_ENUM_TEMPLATE +
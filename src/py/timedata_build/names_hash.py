@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+
+"""Generate the perfect hash tables for the color names table.
+
+Reads the names from src/cpp/timedata/color/names_table_inl.h and writes
+src/cpp/timedata/color/names_hash_inl.h.  Run from the repository root after
+changing the names table.
+
+The tables use "hash and displace": a key's first hash picks a bucket, and
+its second hash, seeded by that bucket's displacement, picks its slot.  The
+hashes must match names_hash::hash in names_table_inl.h."""
+
+import os, re, sys
+
+ROOT = os.path.join('src', 'cpp', 'timedata', 'color')
+TABLE = os.path.join(ROOT, 'names_table_inl.h')
+OUTPUT = os.path.join(ROOT, 'names_hash_inl.h')
+
+ENTRY = re.compile(r'\{"([^"]+)", (0x[0-9a-f]+), (true|false)\}')
+MASK = 0xFFFFFFFF
+
+# Each bucket holds about this many keys.
+BUCKET_LOAD = 4
+
+# There are this many slots for each key.
+SLOT_RATIO = 1.25
+
+
+def mix(h):
+    h = ((h ^ (h >> 16)) * 0x45D9F3B) & MASK
+    return h ^ (h >> 16)
+
+
+def hash_bytes(data, seed):
+    h = (2166136261 ^ (seed * 0x9E3779B9)) & MASK
+    for b in data:
+        h = ((h ^ b) * 16777619) & MASK
+    return mix(h)
+
+
+def name_key(name):
+    return name.encode()
+
+
+def hex_key(hex):
+    return bytes((hex >> (8 * i)) & 0xFF for i in range(4))
+
+
+def perfect_hash(keys):
+    """Return (displacements, slots)."""
+    buckets = [[] for i in range(max(1, len(keys) // BUCKET_LOAD))]
+    for i, k in enumerate(keys):
+        buckets[hash_bytes(k, 0) % len(buckets)].append(i)
+
+    slots = [-1] * int(len(keys) * SLOT_RATIO)
+    displacements = [0] * len(buckets)
+    order = sorted(range(len(buckets)), key=lambda b: -len(buckets[b]))
+
+    for b in order:
+        if not buckets[b]:
+            continue
+        for d in range(1, 0x10000):
+            s = [hash_bytes(keys[i], d) % len(slots) for i in buckets[b]]
+            if len(set(s)) == len(s) and all(slots[j] < 0 for j in s):
+                break
+        else:
+            raise ValueError('No displacement for bucket %d' % b)
+
+        displacements[b] = d
+        for i, j in zip(buckets[b], s):
+            slots[j] = i
+
+    return displacements, slots
+
+
+def format_array(ctype, name, values):
+    lines, line = [], '       '
+    for v in values:
+        item = ' %d,' % v
+        if len(line) + len(item) > 79:
+            lines.append(line)
+            line = '       '
+        line += item
+    lines.append(line.rstrip(','))
+    return '''inline %s const* %s() {
+    static const %s table[] = {
+%s
+    };
+    return table;
+}
+''' % (ctype, name, ctype, '\n'.join(lines))
+
+
+def generate():
+    entries = ENTRY.findall(open(TABLE).read())
+    names = [e[0] for e in entries]
+    if names != sorted(names, key=str.encode):
+        raise ValueError('Names are not sorted')
+
+    primary, seen = [], {}
+    for i, (name, hex, secondary) in enumerate(entries):
+        if secondary == 'false':
+            hex = int(hex, 16)
+            if hex in seen:
+                raise ValueError('Duplicate hex for %s and %s' %
+                                 (name, seen[hex]))
+            seen[hex] = name
+            primary.append((hex, i))
+
+    name_disp, name_slots = perfect_hash([name_key(n) for n in names])
+    hex_disp, hex_slots = perfect_hash([hex_key(h) for h, i in primary])
+    hex_slots = [primary[s][1] if s >= 0 else -1 for s in hex_slots]
+
+    return '''#pragma once
+
+// Generated by src/py/timedata_build/names_hash.py from names_table_inl.h.
+// DO NOT EDIT.
+
+#include <cstdint>
+
+namespace timedata {
+namespace names_hash {
+
+static const uint32_t NAME_BUCKETS = %d;
+static const uint32_t NAME_SLOTS = %d;
+static const uint32_t HEX_BUCKETS = %d;
+static const uint32_t HEX_SLOTS = %d;
+
+%s
+%s
+%s
+%s
+} // names_hash
+} // timedata
+''' % (len(name_disp), len(name_slots), len(hex_disp), len(hex_slots),
+       format_array('uint16_t', 'nameDisplacements', name_disp),
+       format_array('int16_t', 'nameSlots', name_slots),
+       format_array('uint16_t', 'hexDisplacements', hex_disp),
+       format_array('int16_t', 'hexSlots', hex_slots))
+
+
+if __name__ == '__main__':
+    with open(OUTPUT, 'w') as f:
+        f.write(generate())
@@ -10,13 +10,20 @@ MODELS = dict(
     XYZ=('x', 'y', 'z'),
     YIQ=('luma', 'inphase', 'quadrature'),
     YUV=('luma', 'uchrominance', 'vchrominance'),
+    Lab=('lightness', 'a', 'b'),
+    LCh=('lightness', 'chroma', 'hue'),
+    Oklab=('lightness', 'a', 'b'),
     )
 
 SUFFIXES = '', '255', '256'
 
+# Perceptual models aren't scaled to 255 or 256.
+UNSCALED = 'Lab', 'LCh', 'Oklab'
+
 MATCH = re.compile(r'(\D+)(\d*)').match
 
-ALL_MODELS = [''.join(m) for m in itertools.product(MODELS.keys(), SUFFIXES)]
+ALL_MODELS = [m + s for m, s in itertools.product(MODELS.keys(), SUFFIXES)
+              if not (s and m in UNSCALED)]
 
 MODEL_SETTINGS = dict(
     all=ALL_MODELS,
@@ -0,0 +1,27 @@
+import unittest
+
+from timedata import *
+
+
+class TestComposite(unittest.TestCase):
+    def setUp(self):
+        self.bottom = ColorListRGB(['red', 'green', 'blue'])
+        self.top = ColorListRGB(['white', 'black', 'yellow'])
+        self.blend = Blend()
+        self.blend.opacity = 0.5
+
+    def layers(self, bottom):
+        return [bottom, (self.top, self.blend, [1, 0.5, 0])]
+
+    def test_composite(self):
+        out = composite_layers(self.layers(self.bottom))
+        self.assertEqual(len(out), 3)
+        self.assertEqual(list(out[0]), [1, 0.5, 0.5])
+        self.assertEqual(out[2], self.bottom[2])
+
+    def test_out_is_a_layer(self):
+        expected = composite_layers(self.layers(self.bottom))
+        out = self.bottom.copy()
+        result = composite_layers(self.layers(out), out=out)
+        self.assertIs(result, out)
+        self.assertEqual(out, expected)
@@ -6,7 +6,7 @@ class TestGenerated(unittest.TestCase):
     def test_render3(self):
         r = Render3()
         s = ("(gamma=1.0, min=0, max=255, offset=0.0, permutation='rgb', "
-             "prefix=0)")
+             "prefix=0, output='u8', bits=16, indexBits=0)")
 
         self.assertEqual(str(r), s)
         self.assertEqual(repr(r), 'timedata.Render3' + s)
@@ -14,7 +14,7 @@ class TestGenerated(unittest.TestCase):
         r.gamma = 2.5
         r.permutation = 'grb'
         s = ("(gamma=2.5, min=0, max=255, offset=0.0, permutation='grb', "
-                 "prefix=0)")
+                 "prefix=0, output='u8', bits=16, indexBits=0)")
         self.assertEqual(str(r), s)
         self.assertEqual(repr(r), 'timedata.Render3' + s)
 
@@ -36,6 +36,9 @@ def _make_module():
     add(color, 'xyz', 'XYZ')
     add(color, 'yiq', 'YIQ')
     add(color, 'yuv', 'YUV')
+    add(color, 'lab', 'Lab')
+    add(color, 'lch', 'LCh')
+    add(color, 'oklab', 'Oklab')
 
     d = make('', 'timedata', color=color, **normal).__dict__
 
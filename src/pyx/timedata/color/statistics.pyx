@@ -0,0 +1,20 @@
+cdef extern from "<timedata/color/statistics.h>" namespace "timedata":
+    cdef cppclass Statistics:
+        size_t count
+        float min[3]
+        float max[3]
+        double sum[3]
+
+        double mean(size_t)
+        double variance(size_t)
+        double luminance()
+
+cdef dict _statistics(Statistics& s, object sample_class):
+    return dict(
+        count=s.count,
+        min=sample_class(s.min[0], s.min[1], s.min[2]),
+        max=sample_class(s.max[0], s.max[1], s.max[2]),
+        sum=sample_class(s.sum[0], s.sum[1], s.sum[2]),
+        mean=sample_class(s.mean(0), s.mean(1), s.mean(2)),
+        variance=sample_class(s.variance(0), s.variance(1), s.variance(2)),
+        luminance=s.luminance())
@@ -0,0 +1,53 @@
+cdef extern from "<timedata/signal/composite.h>" namespace "timedata":
+    cdef cppclass Layer[T]:
+        const T* samples
+        Blend blend
+        const vector[float]* alpha
+
+    void composite[T](vector[Layer[T]]& layers, T& out, bool skipTransparent)
+
+
+def composite_layers(layers, ColorListRGB out=None, skip_transparent=True):
+    """Blend a stack of layers, bottom first, onto black in one tiled pass.
+
+    Each layer is a ColorList or a tuple (ColorList, blend, alpha), where
+    `blend` is a _Blend or None for normal at full opacity, and `alpha` is
+    None or a sequence of one alpha per sample.
+
+    `out` may be one of the layers, as it may for mix_lists: the layers are
+    then blended into a new list which is swapped into `out`."""
+    cdef vector[Layer[CColorListRGB]] clayers
+    cdef vector[vector[float]] alphas
+    cdef ColorListRGB samples, target
+    cdef _Blend blend
+
+    clayers.resize(len(layers))
+    alphas.resize(len(layers))
+    for i, layer in enumerate(layers):
+        if not isinstance(layer, tuple):
+            layer = (layer,)
+        samples, blend, alpha = layer + (None,) * (3 - len(layer))
+        if blend is None:
+            blend = _Blend()
+
+        clayers[i].samples = &samples.cdata
+        clayers[i].blend = blend.cdata
+        if alpha is None:
+            clayers[i].alpha = NULL
+        else:
+            alphas[i] = alpha
+            clayers[i].alpha = &alphas[i]
+
+    # composite() clears each tile of its output before it reads the layers,
+    # so it can't write over one of them.
+    out = ColorListRGB() if out is None else out
+    target = out
+    for i in range(clayers.size()):
+        if clayers[i].samples == &out.cdata:
+            target = ColorListRGB()
+            break
+
+    composite(clayers, target.cdata, skip_transparent)
+    if target is not out:
+        out.cdata.swap(target.cdata)
+    return out
@@ -1,10 +1,12 @@
 cdef extern from "<timedata/signal/convert_inl.h>" namespace "timedata::converter":
     ctypedef uint64_t PointerAsInt
+    ctypedef uint32_t ModelId
 
     cdef PointerAsInt referenceToInteger[T](T&)
 
-    string loadConverter[T]()
-    bool convertSampleCython[T](PointerAsInt input, string model, T& out)
+    ModelId loadConverter[T]()
+    bool convertSampleCython[T](PointerAsInt input, ModelId model, T& out)
+    bool convertListCython[T](PointerAsInt input, ModelId model, vector[T]& out)
 
 cdef extern from "<timedata/color/rgbAdaptor.h>" namespace "timedata::color_list":
     cdef cppclass RGBIndexer:
@@ -1,11 +1,26 @@
-include "build/genfiles/timedata/signal/fade.pyx"
-
 cdef extern from "<timedata/signal/fade.h>" namespace "timedata":
-    void fadeOver(float fader, Fade& fade, ColorVector& in1, ColorVector& in2,
-                  ColorVector& out)
+    void fadeOver[T](float fader, Fade& fade, T& in1, T& in2, T& out)
+    void mix[T](vector[const T*]& inputs, vector[float]& levels, T& out)
 
 
 cdef class _FadeImpl(_Fade):
-    def __call__(self, float fader, ColorList in1, ColorList in2,
-                 ColorList out):
-        fadeOver(fader, self._instance, in1.colors, in2.colors, out.colors)
+    def __call__(self, float fader, ColorListRGB in1, ColorListRGB in2,
+                 ColorListRGB out=None):
+        """Crossfade two ColorLists into `out`, or a new ColorList."""
+        out = ColorListRGB() if out is None else out
+        fadeOver(fader, self.cdata, in1.cdata, in2.cdata, out.cdata)
+        return out
+
+
+def mix_lists(inputs, levels, ColorListRGB out=None):
+    """Mix many ColorLists in one pass, each scaled by its level, into `out`
+    or a new ColorList with the length of the shortest input."""
+    cdef vector[const CColorListRGB*] cinputs
+    cdef vector[float] clevels = levels
+    cdef ColorListRGB i
+    for i in inputs:
+        cinputs.push_back(&i.cdata)
+
+    out = ColorListRGB() if out is None else out
+    mix(cinputs, clevels, out.cdata)
+    return out
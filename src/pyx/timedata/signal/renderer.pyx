@@ -1,9 +1,12 @@
 cdef extern from "<timedata/color/renderer_inl.h>" namespace "timedata::color_list":
     cdef cppclass CRenderer:
-        CRenderer(Render3&)
+        CRenderer(Render3&) except +
         CRenderer()
         void render(float level, RGBIndexer& input,
                     size_t offset, size_t size, char* out)
+        void render[T](float level, T& input,
+                       size_t offset, size_t size, char* out)
+        size_t stride()
 
 
 cdef class Renderer(_Render3):
@@ -23,9 +26,61 @@ cdef class Renderer(_Render3):
 
     def render(self, object colors, size_t offset=0, int length=-1,
                bytearray output=None):
-        cdef Indexer indexer = <Indexer> colors.indexer()
+        cdef Indexer indexer
         cdef size_t size = len(colors) if length < 0 else length
 
-        output = output or bytearray(3 * size)
-        self.renderer.render(self.level, indexer.cdata, offset, size, output)
+        output = output or bytearray(self.renderer.stride() * size)
+        if isinstance(colors, ColorListRGB):
+            self.renderer.render(self.level, (<ColorListRGB> colors).cdata,
+                                 offset, size, output)
+        else:
+            indexer = <Indexer> colors.indexer()
+            self.renderer.render(self.level, indexer.cdata, offset, size,
+                                 output)
+        return output
+
+
+cdef extern from "<timedata/color/renderSegments.h>" namespace "timedata::color_list":
+    cdef struct RenderSegment:
+        const CRenderer* renderer
+        float level
+        size_t source
+        size_t size
+        size_t destination
+
+    bool renderSegments[T](T& colors, vector[RenderSegment]& segments,
+                           char* out, size_t outSize)
+
+
+cdef class SegmentRenderer:
+    """Render many strips, each with its own Renderer, into one buffer."""
+    cdef vector[RenderSegment] segments
+    cdef list renderers  # Keep each Renderer alive while we point to it.
+    cdef size_t size
+
+    def __init__(self):
+        self.renderers = []
+        self.size = 0
+
+    def add(self, Renderer renderer, size_t source, size_t size,
+            size_t destination, level=None):
+        """Render `size` colors from `source` starting at byte `destination`
+           of the output."""
+        cdef RenderSegment s
+        s.renderer = &renderer.renderer
+        s.level = renderer.level if level is None else level
+        s.source = source
+        s.size = size
+        s.destination = destination
+        self.segments.push_back(s)
+        self.renderers.append(renderer)
+        self.size = max(self.size, destination + size * renderer.renderer.stride())
+        return self
+
+    def render(self, object colors, bytearray output=None):
+        cdef ColorListRGB rgb = (colors if isinstance(colors, ColorListRGB)
+                                 else ColorListRGB(colors))
+        output = output or bytearray(self.size)
+        if not renderSegments(rgb.cdata, self.segments, output, len(output)):
+            raise ValueError('Segment out of range')
         return output
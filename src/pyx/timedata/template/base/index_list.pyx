@@ -1,4 +1,10 @@
 ### define
+    cpdef bool _convert_from($classname self, object other):
+        return False
+
+    cpdef bool _extend_strings($classname self, object items):
+        return False
+
     cpdef _compare($classname self, object other):
         if isinstance(other, Number):
             return compare((<$number_type> other), self.cdata)
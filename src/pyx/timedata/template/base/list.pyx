@@ -11,6 +11,7 @@ cdef extern from "<$include_file>" namespace "$namespace":
 
     string toString(C$classname&)
     C$classname sliceOut(C$classname&, int begin, int end, int step)
+    void sliceOut(C$classname&, int begin, int end, int step, C$classname&)
     $itemclass max_cpp(C$classname&)
     $itemclass min_cpp(C$classname&)
 
@@ -52,6 +53,13 @@ cdef extern from "<$include_file>" namespace "$namespace":
             self.cdata = (<$classname> items).cdata
             return
 
+        if (getattr(items, 'LIST_MODEL', None) is not None and
+                self._convert_from(items)):
+            return
+
+        if self._extend_strings(items):
+            return
+
         try:
             self.cdata.reserve(len(items))
         except:
@@ -82,7 +90,7 @@ cdef extern from "<$include_file>" namespace "$namespace":
         if isinstance(key, slice):
             begin, end, step = key.indices(self.cdata.size())
             cl = $classname()
-            cl.cdata = sliceOut(self.cdata, begin, end, step)
+            sliceOut(self.cdata, begin, end, step, cl.cdata)
             return cl
         k = key
         if not resolvePythonIndex(k, self.cdata.size()):
@@ -122,7 +130,7 @@ cdef extern from "<$include_file>" namespace "$namespace":
         """Extend the samples from an iterator."""
         if isinstance(values, $classname):
             extend(self.cdata, (<$classname> values).cdata)
-        else:
+        elif not self._extend_strings(values):
             for v in values:
                 self.append(v)
         return self
@@ -43,7 +43,7 @@ cdef extern from "<$include_file>" namespace "$namespace":
 
         * Anything else throws an exception.
         """
-        cdef string model
+        cdef ModelId model
         cdef uint64_t pointer
         while len(args) == 1:
             a = args[0]
@@ -58,13 +58,13 @@ cdef extern from "<$include_file>" namespace "$namespace":
                 self.cdata = (<$classname> a).cdata
                 return
             m = getattr(a, 'MODEL', None)
-            if m:
+            if m is not None:
                 model = m
                 pointer = a._get_pointer()
                 if convertSampleCython[C$classname](pointer, model, self.cdata):
                     return
                 raise ValueError("Can't convert from model %s, value %s" %
-                                 (model, a))
+                                 (type(a).__name__, a))
 
             try:
                 args = tuple(a)
@@ -7,9 +7,39 @@ cdef extern from "<$include_file>" namespace "$namespace":
     void round_cpp(C$classname&, size_t digits)
     void round_cpp(C$classname&, C$classname&, size_t digits)
     void spreadAppend($itemclass& end, size_t size, C$classname& out)
+    int extendStrings(vector[string]& specs, C$classname& out)
+    Statistics statistics_cpp(C$classname&)
+    vector[size_t] histogram_cpp(C$classname&, size_t bins, float low,
+                                 float high) except +
+    void delta_e_to_cpp(C$classname&, C$classname&, float* out)
 
 ### define
     RANGE = $range
+    LIST_MODEL = loadConverter[$itemclass]()
+
+    cpdef uint64_t _get_pointer($classname self):
+        return referenceToInteger(self.cdata)
+
+    cpdef bool _convert_from($classname self, object other):
+        """Convert a whole list from another model in one pass."""
+        return convertListCython[$itemclass](
+            other._get_pointer(), other.LIST_MODEL, self.cdata)
+
+    cpdef bool _extend_strings($classname self, object items):
+        """If items is a list or tuple of strings, parse them all as colors
+           in one pass and append them."""
+        cdef vector[string] specs
+        cdef int bad
+        if not isinstance(items, (list, tuple)):
+            return False
+        for i in items:
+            if not isinstance(i, str):
+                return False
+            specs.push_back(<string> i)
+        bad = extendStrings(specs, self.cdata)
+        if bad >= 0:
+            raise ValueError("Can't understand sample string %s" % items[bad])
+        return True
 
     cpdef $classname append($classname self, object c):
         """Append to the list of samples."""
@@ -66,6 +96,32 @@ cdef extern from "<$include_file>" namespace "$namespace":
         result$itemgetter = min_cpp(self.cdata)
         return result
 
+    cpdef dict statistics(self):
+        """Return the count and the min, max, sum, mean and variance of each
+        component, and the total luminance, all computed in one pass."""
+        return _statistics(statistics_cpp(self.cdata), $sampleclass)
+
+    cpdef list histogram(self, size_t bins=256, float low=0,
+                         float high=$range):
+        """Count each component into `bins` equal bins from low to high,
+        returning one list of counts for each component.  Raises ValueError
+        unless low < high."""
+        counts = histogram_cpp(self.cdata, bins, low, high)
+        return [counts[i * bins:(i + 1) * bins] for i in range($size)]
+
+    cpdef size_t delta_e_to($classname self, $classname x, float[::1] out):
+        """Write the perceptual distance (CIE76 deltaE) between each pair of
+        corresponding colors of this $classname and x into out, a writable
+        buffer of floats like an array.array('f'), and return how many
+        were written."""
+        cdef size_t size = min(self.cdata.size(), x.cdata.size())
+        if <size_t> out.shape[0] < size:
+            raise ValueError('out has room for %d of %d distances' %
+                             (out.shape[0], size))
+        if size:
+            delta_e_to_cpp(self.cdata, x.cdata, &out[0])
+        return size
+
     @staticmethod
     def spread(*args):
         """Spreads!"""
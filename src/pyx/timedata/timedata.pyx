@@ -4,10 +4,13 @@ include "src/pyx/timedata/base/modules.pyx"
 include "src/pyx/timedata/base/wrapper.pyx"
 include "src/pyx/timedata/base/timestamp.pyx"
 include "src/pyx/timedata/color/colors.pyx"
+include "src/pyx/timedata/color/statistics.pyx"
 include "src/pyx/timedata/signal/convert.pyx"
 
 include "build/genfiles/timedata/genfiles.pyx"
 include "src/pyx/timedata/signal/renderer.pyx"
+include "src/pyx/timedata/signal/fade.pyx"
+include "src/pyx/timedata/signal/composite.pyx"
 
 locals().update(**_make_module())
 